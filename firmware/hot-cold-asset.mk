@@ -11,9 +11,10 @@ ASSET_OBJ=$(addprefix $(BINDIR)/, $(addsuffix .o, $(ASSET_FILES)) )
 
 GETALLOBJ=$(sort $(call ASMOBJ,$1) $(call COBJ,$1) $(call CXXOBJ,$1)) $(ASSET_OBJ)
 
+# lemlib::Chassis::follow reads binary paths in place, so assets have to be aligned
 .SECONDEXPANSION:
 $(ASSET_OBJ): $$(patsubst bin/%,%,$$(basename $$@))
 	$(VV)mkdir -p $(BINDIR)/static
 	$(VV)mkdir -p $(BINDIR)/static.lib
 	@echo "ASSET $@"
-	$(VV)$(OBJCOPY) -I binary -O elf32-littlearm -B arm $^ $@
\ No newline at end of file
+	$(VV)$(OBJCOPY) -I binary -O elf32-littlearm -B arm --set-section-alignment .data=8 $^ $@
\ No newline at end of file
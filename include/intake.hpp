@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "pros/motors.hpp"
+#include "subsystem.hpp"
+
+/**
+ * @brief Owns the intake motor. Everything that wants the intake to move asks this instead of moving the motor
+ *
+ * Requests come in at levels, and the highest level with a request is what the motor gets. When a StallMonitor says
+ * the intake has jammed, clearJam runs it backwards for a moment.
+ */
+class IntakeController : public Subsystem {
+    public:
+        /**
+         * @brief Levels requests can be made at, lowest first
+         */
+        enum Level {
+            /** what the routine or driver wants */
+            DRIVE = 0,
+            /** throwing out a ring of the wrong color */
+            SORT = 1,
+            /** clearing a jam */
+            UNJAM = 2,
+        };
+        /**
+         * @brief IntakeController constructor
+         *
+         * @param motor the intake motor
+         * @param period time between updates of the motor, in milliseconds
+         */
+        IntakeController(pros::Motor* motor, std::uint32_t period = 10);
+        /**
+         * @brief Set the speed the routine or driver wants, from -127 to 127
+         */
+        void set(int speed);
+        /**
+         * @brief Request a speed at a level, from -127 to 127
+         */
+        void request(Level level, int speed);
+        /**
+         * @brief Withdraw the request at a level
+         */
+        void release(Level level);
+        /**
+         * @brief Turn clearing jams on or off
+         */
+        void setUnjam(bool enabled);
+        /**
+         * @brief Run the intake the other way for a moment, if clearing jams is on and it isn't already
+         *
+         * Meant to be the callback of a StallMonitor watching the motor, so it only requests the reversal, and returns
+         * straight away
+         */
+        void clearJam();
+        /**
+         * @brief Move the motor to the winning request
+         */
+        void periodic() override;
+    private:
+        pros::Motor* motor;
+        CommandArbiter arbiter;
+        std::atomic<bool> unjam = false;
+        std::atomic<std::uint32_t> unjamEnd = 0;
+};
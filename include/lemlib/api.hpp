@@ -4,8 +4,11 @@
 #include "lemlib/pose.hpp" // IWYU pragma: keep
 #include "lemlib/util.hpp" // IWYU pragma: keep
 #include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/estimator.hpp" // IWYU pragma: keep
 #include "lemlib/chassis/trackingWheel.hpp" // IWYU pragma: keep
+#include "lemlib/devices.hpp" // IWYU pragma: keep
 #include "lemlib/logger/logger.hpp" // IWYU pragma: keep
+#include "lemlib/profiler.hpp" // IWYU pragma: keep
 
 // using to shorten lemlib::AngularDirection to just AngularDirection
 using lemlib::AngularDirection;
@@ -16,12 +16,14 @@ typedef struct __attribute__((__packed__)) _asset {
 #define ASSET(x)                                                                                                       \
     extern "C" {                                                                                                       \
     extern uint8_t _binary_static_##x##_start[], _binary_static_##x##_size[];                                          \
+    __attribute__((unused))                                                                                            \
     static asset x = {_binary_static_##x##_start, (size_t)_binary_static_##x##_size};                                  \
     }
 
 #define ASSET_LIB(x)                                                                                                   \
     extern "C" {                                                                                                       \
     extern uint8_t _binary_static_lib_##x##_start[], _binary_static_lib_##x##_size[];                                  \
+    __attribute__((unused))                                                                                            \
     static asset x = {_binary_static_lib_##x##_start, (size_t)_binary_static_lib_##x##_size};                          \
     }
 
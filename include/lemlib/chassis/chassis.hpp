@@ -1,13 +1,19 @@
 #pragma once
 
+#include <functional>
+#include <variant>
+#include <vector>
 #include "pros/rtos.hpp"
 #include "pros/imu.hpp"
 #include "lemlib/asset.hpp"
+#include "lemlib/chassis/compensation.hpp"
 #include "lemlib/chassis/trackingWheel.hpp"
 #include "lemlib/pose.hpp"
 #include "lemlib/pid.hpp"
 #include "lemlib/exitcondition.hpp"
+#include "lemlib/timer.hpp"
 #include "lemlib/driveCurve.hpp"
+#include "lemlib/profile.hpp"
 
 namespace lemlib {
 
@@ -162,6 +168,50 @@ class Drivetrain {
         float horizontalDrift;
 };
 
+/**
+ * @brief class containing constants for motion profiling and feedforward
+ */
+class ProfileSettings {
+    public:
+        /**
+         * @brief ProfileSettings constructor
+         *
+         * With profile settings, moveToPoint and moveToPose follow a motion profile planned from the drivetrain's top
+         * speed and these limits. Feedforward drives the robot along the profile, and the lateral PID only corrects how
+         * far ahead or behind the profile the robot is. The lateral slew is ignored while following a profile.
+         * Set maxAcceleration to 0 to disable profiling
+         *
+         * @param maxAcceleration maximum acceleration, in inches per second squared
+         * @param maxJerk maximum rate of change of acceleration, in inches per second cubed. 0 for trapezoidal
+         * profiles
+         * @param kV power per inch per second of velocity. 0 to work it out from the drivetrain's top speed
+         * @param kA power per inch per second squared of acceleration
+         * @param kS power needed to overcome friction
+         *
+         * @b Example
+         * @code {.cpp}
+         * lemlib::ProfileSettings profileSettings(150, // maximum acceleration, in inches per second squared
+         *                                         1500, // maximum jerk, in inches per second cubed
+         *                                         0, // velocity gain (kV), from the drivetrain's top speed
+         *                                         0.2, // acceleration gain (kA)
+         *                                         5); // static gain (kS)
+         * chassis.setProfileSettings(profileSettings);
+         * @endcode
+         */
+        ProfileSettings(float maxAcceleration, float maxJerk, float kV, float kA, float kS)
+            : maxAcceleration(maxAcceleration),
+              maxJerk(maxJerk),
+              kV(kV),
+              kA(kA),
+              kS(kS) {}
+
+        float maxAcceleration;
+        float maxJerk;
+        float kV;
+        float kA;
+        float kS;
+};
+
 /**
  * @brief AngularDirection
  *
@@ -323,6 +373,47 @@ struct MoveToPointParams {
         float earlyExitRange = 0;
 };
 
+/**
+ * @brief A moveToPoint or moveToPose waiting in the motion queue, see Chassis::queuePoint and Chassis::queuePose
+ */
+struct QueuedMotion {
+        /** x location of the target */
+        float x;
+        /** y location of the target */
+        float y;
+        /** target heading in degrees. Unused for moveToPoint */
+        float theta;
+        /** longest time the robot can spend on this motion */
+        int timeout;
+        /** the parameters of the motion, which also says which motion it is */
+        std::variant<MoveToPointParams, MoveToPoseParams> params;
+};
+
+/**
+ * @brief Timing of a finished motion, see Chassis::setMotionRecorder
+ *
+ * The exit ranges are the lateral ones for moveToPoint and moveToPose, and the angular ones for turns and swings.
+ */
+struct MotionRecord {
+        /** name of the motion, such as "moveToPose" */
+        const char* motion;
+        /** when the motion started, in milliseconds */
+        int startTime;
+        /** how long the motion ran for, in milliseconds */
+        int elapsed;
+        /** time from first entering the large exit range to the end of the motion, in milliseconds. -1 if the robot
+         * never got that close */
+        int settleTime;
+        /** time spent inside the small exit range, in milliseconds */
+        int smallExitTime;
+        /** time spent inside the large exit range, in milliseconds */
+        int largeExitTime;
+        /** whether the motion ran out of time */
+        bool timedOut;
+        /** whether the robot had settled by the end of the motion, see Chassis::setSettleSettings */
+        bool settled;
+};
+
 // default drive curve
 extern ExpoDriveCurve defaultDriveCurve;
 
@@ -427,6 +518,24 @@ class Chassis {
          * @endcode
          */
         Pose getPose(bool radians = false, bool standardPos = false);
+        /**
+         * @brief Get the pose the robot will be at when a motor command sent now takes effect
+         *
+         * The pose is projected forward at the robot's current speed, by how old the pose is plus the latency set with
+         * setLatency. moveToPoint, moveToPose and follow steer with this pose.
+         *
+         * @param radians whether theta should be in radians (true) or degrees (false). false by default
+         * @param standardPos whether theta should be in standard position (true) or in heading (false). false by
+         * default
+         * @return Pose
+         *
+         * @b Example
+         * @code {.cpp}
+         * // where the robot will be when the next motor command takes effect
+         * lemlib::Pose predicted = chassis.getPredictedPose();
+         * @endcode
+         */
+        Pose getPredictedPose(bool radians = false, bool standardPos = false);
         /**
          * @brief Wait until the robot has traveled a certain distance along the path
          *
@@ -680,6 +789,56 @@ class Chassis {
          * @endcode
          */
         void moveToPoint(float x, float y, int timeout, MoveToPointParams params = {}, bool async = true);
+        /**
+         * @brief Add a moveToPose to the motion queue, to be run by runQueue
+         *
+         * Takes the same parameters as moveToPose
+         *
+         * @b Example
+         * @code {.cpp}
+         * // queue two poses, then drive through both without stopping in between
+         * chassis.queuePose(24, 24, 90, 2000);
+         * chassis.queuePose(48, 0, 180, 2000, {.minSpeed = 40});
+         * chassis.runQueue();
+         * @endcode
+         */
+        void queuePose(float x, float y, float theta, int timeout, MoveToPoseParams params = {});
+        /**
+         * @brief Add a moveToPoint to the motion queue, to be run by runQueue
+         *
+         * Takes the same parameters as moveToPoint
+         *
+         * @b Example
+         * @code {.cpp}
+         * // queue a pose and a point, then drive through both without stopping in between
+         * chassis.queuePose(24, 24, 90, 2000);
+         * chassis.queuePoint(48, 24, 2000);
+         * chassis.runQueue();
+         * @endcode
+         */
+        void queuePoint(float x, float y, int timeout, MoveToPointParams params = {});
+        /**
+         * @brief Run every motion in the motion queue as one chain, and empty the queue
+         *
+         * The speed the robot passes through each target at is planned for the whole chain before it starts, from how
+         * sharply the path turns there and the max speeds on either side. Each motion but the last ends at that speed
+         * instead of stopping, and the next one carries on from the power the last one ended with rather than
+         * accelerating from zero. Where the chain reverses direction or turns by 90 degrees or more, the robot stops
+         * like it would between separate motions. waitUntil measures distance along the whole chain.
+         *
+         * @param async whether the function should be run asynchronously. true by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * chassis.queuePose(24, 24, 90, 2000);
+         * chassis.queuePose(48, 0, 180, 2000);
+         * chassis.queuePoint(48, -24, 2000);
+         * chassis.runQueue();
+         * // wait until the robot is 30 inches into the chain
+         * chassis.waitUntil(30);
+         * @endcode
+         */
+        void runQueue(bool async = true);
         /**
          * @brief Move the chassis along a path
          *
@@ -881,6 +1040,98 @@ class Chassis {
          * @endcode
          */
         bool isInMotion() const;
+        /**
+         * @brief Set a function to be called with the timing of every motion once it finishes
+         *
+         * Runs in the task that ran the motion. Useful to find which motions waste time waiting on an exit condition.
+         * Turns, swings, moveToPoint and moveToPose are recorded.
+         *
+         * @param recorder the function to call, or nullptr to stop recording
+         *
+         * @b Example
+         * @code {.cpp}
+         * // print how long each motion took
+         * chassis.setMotionRecorder([](const lemlib::MotionRecord& record) {
+         *     printf("%s took %d ms\n", record.motion, record.elapsed);
+         * });
+         * @endcode
+         */
+        void setMotionRecorder(std::function<void(const MotionRecord&)> recorder);
+        /**
+         * @brief Set the limits moveToPoint and moveToPose plan motion profiles with, see ProfileSettings
+         *
+         * Only affects motions started afterwards.
+         *
+         * @param settings the profile settings. A maxAcceleration of 0 disables profiling
+         *
+         * @b Example
+         * @code {.cpp}
+         * // accelerate at up to 150 inches per second squared, with feedforward worked out from the drivetrain
+         * chassis.setProfileSettings(lemlib::ProfileSettings(150, 1500, 0, 0.2, 5));
+         * @endcode
+         */
+        void setProfileSettings(ProfileSettings settings);
+        /**
+         * @brief Set when motions count as settled, and exit without waiting out their exit ranges, see SettleExit
+         *
+         * Turns and swings settle on the angular settings, with the turn rate. moveToPoint settles on the lateral
+         * settings, with the speed the robot is driving at. moveToPose needs both to settle. Only affects motions
+         * started afterwards. Settling is off by default
+         *
+         * @param lateral settings for the lateral error, in inches
+         * @param angular settings for the angular error, in degrees
+         *
+         * @b Example
+         * @code {.cpp}
+         * // settled once driving slower than 2 inches per second and stopping within 3 inches of the target, or
+         * // turning slower than 10 degrees per second and stopping within 3 degrees of the target
+         * chassis.setSettleSettings(lemlib::SettleSettings(3, 2, 50), lemlib::SettleSettings(3, 10, 50));
+         * @endcode
+         */
+        void setSettleSettings(SettleSettings lateral, SettleSettings angular);
+        /**
+         * @brief Set the model drivetrain commands are compensated with, see MotorModel and DriveCompensator
+         *
+         * Affects every command sent afterwards, including driver control. Compensation is off by default
+         *
+         * @param model the motor model. A freeSpeed of 0 disables compensation
+         *
+         * @b Example
+         * @code {.cpp}
+         * // compensate for the battery and motor temperature, with blue cartridges that spin at 600 rpm
+         * chassis.setMotorModel(lemlib::MotorModel(600));
+         * @endcode
+         */
+        void setMotorModel(MotorModel model);
+        /**
+         * @brief Set when the drive wheels count as slipping, and how hard commands are limited while they are, see
+         * TractionSettings
+         *
+         * Affects every command sent afterwards, including driver control. Traction control is off by default
+         *
+         * @param settings the traction settings. A slip of 0 disables traction control
+         *
+         * @b Example
+         * @code {.cpp}
+         * // slipping when the wheels are 12 inches per second off the ground speed, then let them run 30 ahead of it
+         * chassis.setTractionSettings(lemlib::TractionSettings(12, 30));
+         * @endcode
+         */
+        void setTractionSettings(TractionSettings settings);
+        /**
+         * @brief Set the time from sending a motor command to it taking effect, see getPredictedPose
+         *
+         * How old the pose is when it's used is measured, so this is only the latency of the motors. 0 by default
+         *
+         * @param latency the latency, in milliseconds
+         *
+         * @b Example
+         * @code {.cpp}
+         * // motor commands take about 10ms to reach the motors and change their output
+         * chassis.setLatency(10);
+         * @endcode
+         */
+        void setLatency(int latency);
         /**
          * @brief Resets the x and y position of the robot
          * without interfering with the heading.
@@ -918,15 +1169,69 @@ class Chassis {
          * @brief Dequeues this motion and permits queued task to run
          */
         void endMotion();
+        /**
+         * @brief Pass the timing of a finished motion to the motion recorder, if there is one
+         */
+        void recordMotion(const char* motion, Timer& timer, const ExitCondition& smallExit,
+                          const ExitCondition& largeExit, const SettleExit& settleExit);
+        /**
+         * @brief Run a moveToPose in the current task, which must already be running the motion
+         *
+         * @param startOutput the lateral power the robot is already driving at, out of 127
+         * @param stop whether to stop the drivetrain at the end
+         * @return float the lateral power the motion ended with
+         */
+        float runMoveToPose(float x, float y, float theta, int timeout, MoveToPoseParams params, float startOutput = 0,
+                            bool stop = true);
+        /**
+         * @brief Run a moveToPoint in the current task, which must already be running the motion
+         *
+         * @param startOutput the lateral power the robot is already driving at, out of 127
+         * @param stop whether to stop the drivetrain at the end
+         * @return float the lateral power the motion ended with
+         */
+        float runMoveToPoint(float x, float y, int timeout, MoveToPointParams params, float startOutput = 0,
+                             bool stop = true);
+
+        /**
+         * @brief Plan a motion profile for a lateral motion, starting from the current speed of the robot
+         *
+         * @param distance how far the motion goes along its path, in inches
+         * @param forwards whether the robot drives forwards
+         * @param maxSpeed the maximum speed of the motion, out of 127
+         * @param minSpeed the speed to end the motion at, out of 127
+         * @param curvature how sharply the path curves, in 1/inches. The profile is slowed so the outer wheels stay
+         * within the drivetrain's top speed
+         */
+        MotionProfile planProfile(float distance, bool forwards, float maxSpeed, float minSpeed, float curvature = 0);
+        /**
+         * @brief Get the power that drives the robot along a profile without correction
+         *
+         * @param state where the profile is
+         * @return float power, out of 127
+         */
+        float profileFeedforward(const ProfileState& state);
+        /**
+         * @brief Get the top speed of the drivetrain
+         *
+         * @return float speed, in inches per second
+         */
+        float getMaxVelocity() const;
+
+        std::function<void(const MotionRecord&)> motionRecorder;
+        ProfileSettings profileSettings {0, 0, 0, 0, 0};
+        float latency = 0; // seconds
 
         bool motionRunning = false;
         bool motionQueued = false;
+        std::vector<QueuedMotion> motionQueue;
 
         float distTraveled = 0;
 
         ControllerSettings lateralSettings;
         ControllerSettings angularSettings;
         Drivetrain drivetrain;
+        DriveCompensator compensator;
         OdomSensors sensors;
         DriveCurve* throttleCurve;
         DriveCurve* steerCurve;
@@ -935,6 +1240,8 @@ class Chassis {
         ExitCondition lateralSmallExit;
         ExitCondition angularLargeExit;
         ExitCondition angularSmallExit;
+        SettleExit lateralSettle {SettleSettings(0, 0, 0)};
+        SettleExit angularSettle {SettleSettings(0, 0, 0)};
     private:
         pros::Mutex mutex;
 };
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cstdint>
+#include "pros/motor_group.hpp"
+
+namespace lemlib {
+/**
+ * @brief class containing constants for the drive motors, used to compensate drivetrain commands
+ */
+class MotorModel {
+    public:
+        /**
+         * @brief MotorModel constructor
+         *
+         * A DC motor's torque goes with the voltage left over after its back EMF, divided by the resistance of its
+         * windings. The back EMF goes with speed, and the resistance rises as the motor heats up. The model uses these
+         * to send the voltage that gets the torque a command would get from a cool motor, on a full battery. Set
+         * freeSpeed to 0 to disable compensation
+         *
+         * @param freeSpeed speed of the motors with nominalVoltage applied and nothing loading them, in rpm. Calibrate
+         * it by driving at full power off the ground, and reading the motors' velocity
+         * @param temperatureCoefficient how much the resistance of the windings rises per degree, as a fraction of it
+         * at 25 degrees. 0.00393 for copper
+         * @param nominalVoltage the voltage a full power command stands for, in millivolts
+         *
+         * @b Example
+         * @code {.cpp}
+         * lemlib::MotorModel motorModel(600, // free speed of blue cartridges, in rpm
+         *                               0.00393, // temperature coefficient of copper
+         *                               12000); // full power is 12 volts
+         * chassis.setMotorModel(motorModel);
+         * @endcode
+         */
+        MotorModel(float freeSpeed, float temperatureCoefficient = 0.00393, float nominalVoltage = 12000)
+            : freeSpeed(freeSpeed),
+              temperatureCoefficient(temperatureCoefficient),
+              nominalVoltage(nominalVoltage) {}
+
+        float freeSpeed;
+        float temperatureCoefficient;
+        float nominalVoltage;
+};
+
+/**
+ * @brief class containing constants for traction control
+ */
+class TractionSettings {
+    public:
+        /**
+         * @brief TractionSettings constructor
+         *
+         * A side's wheels are slipping when the speed the motors say they're turning at is more than slip away from
+         * the speed the tracking wheel and inertial sensor say that side is moving over the ground. Commands are then
+         * limited so the wheels are asked for no more than the speed of the ground until they grip again, and after
+         * that no more than lead ahead of it, which keeps the acceleration below what breaks traction. The limit stays
+         * until the command asks for less. Set slip to 0 to disable traction control
+         *
+         * @param slip difference between wheel and ground speed that counts as slipping, in inches per second
+         * @param lead how far ahead of the ground the wheels are asked to run while slipping, in inches per second
+         *
+         * @b Example
+         * @code {.cpp}
+         * lemlib::TractionSettings tractionSettings(12, // slipping when the wheels are 12 inches per second off
+         *                                           30); // then let them run 30 inches per second ahead
+         * chassis.setTractionSettings(tractionSettings);
+         * @endcode
+         */
+        TractionSettings(float slip, float lead)
+            : slip(slip),
+              lead(lead) {}
+
+        float slip;
+        float lead;
+};
+
+/**
+ * @brief Sends power commands to the drivetrain, compensated for the battery and the temperature of the motors
+ *
+ * Commands are sent as voltages. A hot motor is sent more voltage than its command, beyond what holds its current
+ * speed, so it pushes as hard as it would cool. When the battery can't supply what a command needs, both sides are
+ * scaled down together, so the robot keeps turning at the rate it was told to rather than one side being clipped.
+ * Velocities come from the device snapshot, temperatures are read every TEMPERATURE_PERIOD, and the battery on every
+ * command.
+ *
+ * Traction control, when it's enabled, limits commands first. The speed of each side's wheels comes from its motors,
+ * and the speed of the ground under it from odometry, so it only works while odometry is running.
+ *
+ * Until a model is set, commands are sent with move(), after traction control.
+ */
+class DriveCompensator {
+    public:
+        /**
+         * @brief Create a new drive compensator, with compensation and traction control disabled
+         *
+         * @param trackWidth distance between the left and right wheels, in inches
+         * @param wheelDiameter diameter of the drive wheels, in inches
+         * @param rpm rpm of the drive wheels
+         */
+        DriveCompensator(pros::MotorGroup* leftMotors, pros::MotorGroup* rightMotors, float trackWidth,
+                         float wheelDiameter, float rpm);
+        /**
+         * @brief Set the model commands are compensated with
+         *
+         * @param model the motor model. A freeSpeed of 0 disables compensation
+         */
+        void setModel(MotorModel model);
+        /**
+         * @brief Set when the wheels count as slipping, and how commands are limited while they are
+         *
+         * @param settings the traction settings. A slip of 0 disables traction control
+         */
+        void setTractionSettings(TractionSettings settings);
+        /**
+         * @brief Drive both sides
+         *
+         * @param left power for the left side, out of 127
+         * @param right power for the right side, out of 127
+         */
+        void move(float left, float right);
+        /**
+         * @brief Drive the left side, leaving the right side as it is
+         *
+         * @param power power out of 127
+         */
+        void moveLeft(float power);
+        /**
+         * @brief Drive the right side, leaving the left side as it is
+         *
+         * @param power power out of 127
+         */
+        void moveRight(float power);
+    private:
+        /**
+         * @brief A side of the drivetrain, and what was last measured of it
+         */
+        struct Side {
+                pros::MotorGroup* motors;
+                int deviceIndex = -1;
+                int count = 0;
+                float resistance = 1; // mean resistance of the windings, as a multiple of it at 25 degrees
+                float wheelRatio = 1; // wheel rpm per motor rpm
+                bool slipping = false;
+                float slipDirection = 0; // 1 if the wheels were running ahead of the ground when they started slipping
+        };
+
+        /**
+         * @brief Register the motors with the device service, so their velocities are in the snapshot
+         */
+        void watch();
+        /**
+         * @brief Get the mean velocity of each side's motors, in rpm, from one copy of the device snapshot
+         */
+        void motorVelocities(float& leftVelocity, float& rightVelocity) const;
+        /**
+         * @brief Update whether a side is slipping, and get how much to scale the power by so it grips again
+         *
+         * @param power power for the side, set to 0 if the ground is moving against it
+         * @param ground speed of the ground under the side, in inches per second
+         * @param velocity mean velocity of the side's motors, in rpm
+         * @return how much to scale both sides' power by
+         */
+        float tractionRatio(Side& side, float& power, float ground, float velocity);
+        /**
+         * @brief Get the speed of the ground under each side, from odometry
+         *
+         * @return false if odometry isn't running, so there's nothing to compare the wheels with
+         */
+        bool groundSpeeds(float& left, float& right) const;
+        /**
+         * @brief Read the temperatures if they're due, and the battery
+         */
+        void updateConditions();
+        /**
+         * @brief Get the voltage that gives a side the torque its command would get from a cool motor
+         *
+         * @param velocity mean velocity of the side's motors, in rpm
+         */
+        float compensate(Side& side, float power, float velocity);
+        /**
+         * @brief Drive one side, leaving the other as it is
+         *
+         * @param isLeft true if side is the left side
+         */
+        void moveSide(Side& side, float power, bool isLeft);
+        /**
+         * @brief Send a voltage to a side, or stop it if the power is 0
+         */
+        static void send(const Side& side, float power, float voltage);
+
+        static constexpr std::uint32_t TEMPERATURE_PERIOD = 500; // ms
+
+        MotorModel model {0};
+        TractionSettings traction {0, 0};
+        float trackWidth;
+        float wheelDiameter;
+        float rpm;
+        Side left;
+        Side right;
+        float battery = 0; // mV
+        std::uint32_t lastTemperatureRead = 0;
+        bool temperaturesRead = false;
+};
+} // namespace lemlib
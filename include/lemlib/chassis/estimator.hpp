@@ -0,0 +1,193 @@
+#pragma once
+
+#include <array>
+#include "pros/distance.hpp"
+#include "pros/gps.hpp"
+#include "lemlib/pose.hpp"
+
+namespace lemlib {
+/**
+ * @brief A reading from an absolute sensor, compared to what the sensor should read from the current pose
+ *
+ * Angles are in radians, measured clockwise from the +y axis like the pose odometry keeps internally.
+ */
+struct Measurement {
+        /** how many values were measured, from 1 to 3 */
+        int size = 0;
+        /** the measured values minus the predicted ones. Angle differences must be wrapped */
+        std::array<float, 3> residual {};
+        /** how each predicted value changes with the x, y and theta of the pose, one row per value */
+        std::array<std::array<float, 3>, 3> jacobian {};
+        /** variance of each measured value. The values are assumed to be independent */
+        std::array<float, 3> variance {};
+};
+
+/**
+ * @brief A sensor that measures where the robot is on the field, used to correct odometry
+ *
+ * Pass sources to lemlib::addPoseSource. They're read every odometry update, and readings too far from the pose for
+ * the uncertainty of both are rejected as outliers.
+ */
+class PoseSource {
+    public:
+        virtual ~PoseSource() = default;
+        /**
+         * @brief Read the sensor
+         *
+         * @param pose the current pose, theta in radians
+         * @param measurement the reading to fill in
+         * @return true if there is a new reading, false if the sensor has nothing new or couldn't be read
+         */
+        virtual bool measure(Pose pose, Measurement& measurement) = 0;
+        /**
+         * @brief Get how many readings were used to correct the pose
+         */
+        int getAccepted() const;
+        /**
+         * @brief Get how many readings were rejected as outliers
+         */
+        int getRejected() const;
+    private:
+        friend class PoseFilter;
+        int accepted = 0;
+        int rejected = 0;
+};
+
+/**
+ * @brief Corrects the pose from a V5 GPS sensor
+ *
+ * The GPS measures x, y and heading on the field, with its own origin in the center of the field and its positions in
+ * meters. The offset of the GPS from the tracking center should be set on the pros::Gps.
+ */
+class GpsSource : public PoseSource {
+    public:
+        /**
+         * @brief GpsSource constructor
+         *
+         * @param gps the GPS sensor
+         * @param origin where the GPS's origin is in the odometry's coordinates, in inches, and how far the GPS's
+         * heading is rotated from the odometry's, in degrees
+         * @param minError smallest standard deviation of a position reading, in inches. The GPS's own error estimate
+         * is used when it's larger
+         * @param headingError standard deviation of a heading reading, in degrees
+         *
+         * @b Example
+         * @code {.cpp}
+         * pros::Gps gps(5, 0, -0.1); // GPS on port 5, 0.1 m behind the tracking center
+         * // odometry has its origin in the middle of a field wall, so the field center is 72 inches up
+         * lemlib::GpsSource gpsSource(&gps, lemlib::Pose(0, 72, 0));
+         * lemlib::addPoseSource(&gpsSource);
+         * @endcode
+         */
+        GpsSource(pros::Gps* gps, Pose origin, float minError = 0.5, float headingError = 2);
+        bool measure(Pose pose, Measurement& measurement) override;
+    private:
+        pros::Gps* gps;
+        Pose origin;
+        float minError;
+        float headingError;
+        double lastX = 0;
+        double lastY = 0;
+};
+
+/**
+ * @brief Edges of the field, in the odometry's coordinates, in inches
+ */
+struct FieldBounds {
+        float minX;
+        float minY;
+        float maxX;
+        float maxY;
+};
+
+/**
+ * @brief Corrects the pose from a distance sensor pointed at the field walls
+ *
+ * Game elements and robots in front of the sensor read short of the wall. Those readings are rejected as outliers
+ * when the pose is known well enough, so aim the sensor where the way to the wall is usually clear.
+ */
+class DistanceSource : public PoseSource {
+    public:
+        /**
+         * @brief DistanceSource constructor
+         *
+         * @param sensor the distance sensor
+         * @param offset where the sensor is on the robot, in inches from the tracking center with x to the right and y
+         * forwards, and which way it faces, in degrees clockwise from forwards
+         * @param field the edges of the field
+         *
+         * @b Example
+         * @code {.cpp}
+         * pros::Distance rightDistance(6);
+         * // 5 inches right of and 2 inches behind the tracking center, facing right
+         * lemlib::DistanceSource rightSource(&rightDistance, lemlib::Pose(5, -2, 90), {-72, 0, 72, 144});
+         * lemlib::addPoseSource(&rightSource);
+         * @endcode
+         */
+        DistanceSource(pros::Distance* sensor, Pose offset, FieldBounds field);
+        bool measure(Pose pose, Measurement& measurement) override;
+        /**
+         * @brief Get what the sensor should read from a pose
+         *
+         * @param pose the pose, theta in radians
+         * @return float distance to the nearest wall, in inches, or -1 if the sensor is outside the field
+         */
+        float predict(Pose pose) const;
+    private:
+        pros::Distance* sensor;
+        Pose offset;
+        FieldBounds field;
+        int lastReading = 0;
+};
+
+/**
+ * @brief Extended Kalman filter over the x, y and heading of the robot
+ *
+ * Odometry is the prediction step, and grows the uncertainty of the pose with how far the robot moves. Readings from
+ * pose sources are the correction steps. Everything is fixed size, so nothing is allocated while it runs.
+ */
+class PoseFilter {
+    public:
+        /**
+         * @brief PoseFilter constructor
+         *
+         * @param distanceNoise standard deviation of the odometry's position error per inch traveled
+         * @param headingNoise standard deviation of the odometry's heading error per radian turned
+         */
+        PoseFilter(float distanceNoise = 0.05, float headingNoise = 0.01);
+        /**
+         * @brief Set how uncertain the pose is, after it's been set
+         *
+         * @param positionDeviation standard deviation of x and y, in inches
+         * @param headingDeviation standard deviation of the heading, in radians
+         */
+        void reset(float positionDeviation, float headingDeviation);
+        /**
+         * @brief Grow the uncertainty for an odometry update
+         *
+         * @param localX sideways movement in the update, in inches
+         * @param localY forwards movement in the update, in inches
+         * @param avgHeading the heading halfway through the update, in radians
+         * @param deltaHeading change in heading in the update, in radians
+         */
+        void predict(float localX, float localY, float avgHeading, float deltaHeading);
+        /**
+         * @brief Correct the pose with a reading from a source, unless the reading is an outlier
+         *
+         * @param pose the pose to correct, theta in radians
+         * @param source the source to read
+         * @return true if the pose was corrected
+         */
+        bool correct(Pose& pose, PoseSource& source);
+        /**
+         * @brief Get the standard deviation of the pose
+         *
+         * @return Pose standard deviation of x and y in inches, and theta in radians
+         */
+        Pose getDeviation() const;
+    private:
+        float distanceNoise;
+        float headingNoise;
+        std::array<std::array<float, 3>, 3> covariance {};
+};
+} // namespace lemlib
@@ -1,9 +1,32 @@
 #pragma once
 
+#include <cstdint>
 #include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/estimator.hpp"
 #include "lemlib/pose.hpp"
 
 namespace lemlib {
+/**
+ * @brief Time between odometry updates, in milliseconds
+ *
+ * The fastest rate rotation sensors and inertial sensors can send data at, so every reading is used
+ */
+constexpr int ODOM_PERIOD = 5;
+/**
+ * @brief Most pose sources that can be added with addPoseSource
+ */
+constexpr int MAX_POSE_SOURCES = 8;
+/**
+ * @brief A pose, and when the sensors it was calculated from were read
+ */
+struct TimedPose {
+        /** the pose of the robot */
+        Pose pose;
+        /** when the sensors were read, in microseconds since the program started */
+        std::uint64_t time;
+        /** how many times the pose has been published. It only goes up, so a new number means a new pose */
+        std::uint32_t sequence;
+};
 /**
  * @brief Set the sensors to be used for odometry
  *
@@ -14,17 +37,50 @@ void setSensors(lemlib::OdomSensors sensors, lemlib::Drivetrain drivetrain);
 /**
  * @brief Get the pose of the robot
  *
+ * Odometry publishes its state without locks at the end of every update, so this never blocks the update and never
+ * returns half of one update and half of the next. The same goes for the speeds, the deviation and the predictions.
+ *
  * @param radians true for theta in radians, false for degrees. False by default
  * @return Pose
  */
 Pose getPose(bool radians = false);
+/**
+ * @brief Get the pose of the robot, and when it was measured
+ *
+ * Comparing the time to pros::micros() gives how old the pose is
+ *
+ * @param radians true for theta in radians, false for degrees. False by default
+ * @return TimedPose
+ */
+TimedPose getTimedPose(bool radians = false);
 /**
  * @brief Set the Pose of the robot
  *
+ * Once odometry is running, the pose is handed to the next update, and this waits for it so the pose read after it is
+ * the one that was set. If odometry doesn't run within a few periods, this stops waiting, and the pose is applied when
+ * it does. Any task can set the pose; the last call wins
+ *
  * @param pose the new pose
  * @param radians true if theta is in radians, false if in degrees. False by default
  */
 void setPose(Pose pose, bool radians = false);
+/**
+ * @brief Add a sensor that corrects the pose, such as a GPS
+ *
+ * Every odometry update reads each source and corrects the pose with an extended Kalman filter, see PoseFilter. The
+ * source must outlive the program. Sources past MAX_POSE_SOURCES are ignored
+ *
+ * @param source the pose source
+ * @return true if the source was added
+ */
+bool addPoseSource(PoseSource* source);
+/**
+ * @brief Get how uncertain the pose is, if there are pose sources
+ *
+ * @param radians true for theta in radians, false for degrees. False by default
+ * @return Pose standard deviation of x, y and theta
+ */
+Pose getPoseDeviation(bool radians = false);
 /**
  * @brief Get the speed of the robot
  *
@@ -47,6 +103,17 @@ Pose getLocalSpeed(bool radians = false);
  * @return lemlib::Pose
  */
 Pose estimatePose(float time, bool radians = false);
+/**
+ * @brief Predict the pose of the robot when a motor command sent now takes effect
+ *
+ * The pose is projected forward from when its sensors were read, by its age plus the latency, at the current speed.
+ * Control loops that act on this instead of the last measured pose don't lag behind the robot.
+ *
+ * @param latency time from sending a motor command to it taking effect, in seconds
+ * @param radians False for degrees, true for radians. False by default
+ * @return lemlib::Pose
+ */
+Pose predictPose(float latency, bool radians = false);
 /**
  * @brief Update the pose of the robot
  *
@@ -55,6 +122,9 @@ void update();
 /**
  * @brief Initialize the odometry system
  *
+ * Sets the tracking wheels and inertial sensor to send data as fast as they can, and starts a task that updates the
+ * pose every ODOM_PERIOD milliseconds. The task has a higher priority than anything else the robot runs, so the time
+ * between updates doesn't drift when other tasks are busy.
  */
 void init();
 } // namespace lemlib
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <span>
+#include "lemlib/path.hpp"
+#include "lemlib/pose.hpp"
+
+namespace lemlib {
+/**
+ * @brief Find the first point at least a given distance along a path
+ *
+ * Binary search over the cumulative distances, so it takes O(log n) however long the path is.
+ *
+ * @param path the path to search
+ * @param distance the distance along the path, in inches
+ * @return int index of the point, or of the last point if the path is shorter than the distance
+ */
+int pathIndexAt(std::span<const PathPoint> path, float distance);
+/**
+ * @brief Find the closest point on the path to the robot
+ *
+ * @param pose the current pose of the robot
+ * @param path the path to follow
+ * @param first index of the first point to consider
+ * @param last index one past the last point to consider
+ * @return int index to the closest point
+ */
+int findClosest(Pose pose, std::span<const PathPoint> path, int first, int last);
+/**
+ * @brief Find the intersection point between a circle and a line
+ *
+ * @param p1 start point of the line
+ * @param p2 end point of the line
+ * @param pose position of the robot, the center of the circle
+ * @param lookaheadDist radius of the circle
+ * @return float how far along the line the intersection is, from 0 to 1, or -1 if there isn't one
+ */
+float circleIntersect(Pose p1, Pose p2, Pose pose, float lookaheadDist);
+/**
+ * @brief Find the lookahead point
+ *
+ * @param lastLookahead the last lookahead point, with the index of its segment as theta
+ * @param pose the current position of the robot
+ * @param path the path to follow
+ * @param closest the index of the point closest to the robot
+ * @param lookaheadDist the lookahead distance of the algorithm
+ * @param last index one past the start of the last segment to consider
+ * @return Pose the lookahead point, with the index of its segment as theta
+ */
+Pose lookaheadPoint(Pose lastLookahead, Pose pose, std::span<const PathPoint> path, int closest, float lookaheadDist,
+                    int last);
+} // namespace lemlib
@@ -4,6 +4,7 @@
 #include "pros/motor_group.hpp"
 #include "pros/adi.hpp"
 #include "pros/rotation.hpp"
+#include "lemlib/devices.hpp"
 
 namespace lemlib {
 
@@ -138,6 +139,9 @@ class TrackingWheel {
         /**
          * @brief Get the distance traveled by the tracking wheel
          *
+         * Rotation sensors and motors are read from the latest device snapshot, so the distance can be up to a tick
+         * old. Until odometry is running, they're read directly
+         *
          * @return float distance traveled in inches
          *
          * @b Example
@@ -151,6 +155,16 @@ class TrackingWheel {
          * }
          */
         float getDistanceTraveled();
+        /**
+         * @brief Get the distance traveled by the tracking wheel, as read in a device snapshot
+         *
+         * Distances from one snapshot were all measured at the same time. ADI encoders aren't in snapshots, so they're
+         * read directly
+         *
+         * @param snapshot the snapshot
+         * @return float distance traveled in inches
+         */
+        float getDistanceTraveled(const DeviceSnapshot& snapshot);
         /**
          * @brief Get the offset of the tracking wheel from the center of rotation
          *
@@ -184,7 +198,30 @@ class TrackingWheel {
          * @endcode
          */
         int getType();
+        /**
+         * @brief Set how often the tracking wheel's sensor sends new data
+         *
+         * Only rotation sensors can be set. ADI encoders and motors update at a fixed rate, so this does nothing for
+         * them. If you are using odometry provided by LemLib, this will automatically be called when the chassis is
+         * calibrated
+         *
+         * @param rate time between readings, in milliseconds. Rounded down to a multiple of 5, the fastest rate
+         *
+         * @b Example
+         * @code {.cpp}
+         * void initialize() {
+         *     // read the rotation sensor as fast as it can
+         *     exampleTrackingWheel.setDataRate(5);
+         * }
+         * @endcode
+         */
+        void setDataRate(int rate);
     private:
+        /**
+         * @brief Get the distance traveled from a snapshot, or from the sensor itself if the snapshot is null
+         */
+        float distanceTraveled(const DeviceSnapshot* snapshot);
+
         float diameter;
         float distance;
         float rpm;
@@ -192,5 +229,7 @@ class TrackingWheel {
         pros::Rotation* rotation = nullptr;
         pros::MotorGroup* motors = nullptr;
         float gearRatio = 1;
+        int deviceIndex = -1; // where the sensor is in device snapshots, -1 if it isn't
+        std::vector<float> motorRatios; // wheel revolutions per motor revolution, for each motor
 };
 } // namespace lemlib
\ No newline at end of file
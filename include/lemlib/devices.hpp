@@ -0,0 +1,161 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "pros/abstract_motor.hpp"
+#include "pros/imu.hpp"
+#include "pros/optical.hpp"
+#include "pros/rotation.hpp"
+#include "lemlib/seqlock.hpp"
+
+namespace lemlib {
+/**
+ * @brief Every registered device, as read on one tick
+ *
+ * Values are as the devices return them, including PROS_ERR and PROS_ERR_F for a device that's unplugged. Look
+ * values up with the index DeviceService::add returned for the device.
+ */
+struct DeviceSnapshot {
+        /** most motors, counting every motor in a group */
+        static constexpr int MAX_MOTORS = 16;
+        static constexpr int MAX_ROTATIONS = 4;
+        static constexpr int MAX_IMUS = 2;
+        static constexpr int MAX_OPTICALS = 4;
+
+        /** when the devices were read, in microseconds. 0 if they haven't been yet */
+        std::uint64_t time;
+        /** position of each motor, in the encoder units set on it */
+        std::array<float, MAX_MOTORS> motorPositions;
+        /** velocity of each motor, in rpm */
+        std::array<float, MAX_MOTORS> motorVelocities;
+        /** current each motor draws, in mA */
+        std::array<std::int32_t, MAX_MOTORS> motorCurrents;
+        /** torque of each motor, in Nm */
+        std::array<float, MAX_MOTORS> motorTorques;
+        /** position of each rotation sensor, in centidegrees */
+        std::array<std::int32_t, MAX_ROTATIONS> rotations;
+        /** rotation of each inertial sensor, in degrees */
+        std::array<float, MAX_IMUS> imuRotations;
+        /** hue of each optical sensor, in degrees */
+        std::array<float, MAX_OPTICALS> hues;
+        /** proximity of each optical sensor, from 0 to 255 */
+        std::array<std::int32_t, MAX_OPTICALS> proximities;
+};
+
+/**
+ * @brief Reads every registered device once a tick, and publishes what it read as one snapshot
+ *
+ * Consumers read the snapshot instead of the devices, so a device several of them watch is only queried once a tick,
+ * and everything read from one snapshot was measured at the same time. The snapshot is published without locks, so
+ * reading it never blocks the tick.
+ *
+ * LemLib's odometry task runs the tick at the start of every update, every ODOM_PERIOD, once the chassis is calibrated.
+ * Devices are only read while it's running.
+ */
+class DeviceService {
+    public:
+        /**
+         * @brief What to read from motors
+         */
+        enum MotorData {
+            POSITION = 1,
+            VELOCITY = 2,
+            CURRENT = 4,
+            TORQUE = 8,
+        };
+        /**
+         * @brief Register motors, with the batch getters of a group
+         *
+         * Registering motors again returns the same index, reading anything either registration asked for, as often
+         * as the more frequent of the two. Only register from one task at a time
+         *
+         * @param motors a motor or motor group, which must outlive the program
+         * @param data what to read, POSITION, VELOCITY, CURRENT and TORQUE or'd together
+         * @param interval least time between reads, in milliseconds. 0 reads every tick
+         * @return int index of the first motor in the snapshot, or -1 if there's no room
+         */
+        int add(pros::AbstractMotor* motors, int data = POSITION | VELOCITY, std::uint32_t interval = 0);
+        /**
+         * @brief Register a rotation sensor
+         *
+         * @return int index of its position in the snapshot, or -1 if there's no room
+         */
+        int add(pros::Rotation* sensor, std::uint32_t interval = 0);
+        /**
+         * @brief Register an inertial sensor
+         *
+         * @return int index of its rotation in the snapshot, or -1 if there's no room
+         */
+        int add(pros::Imu* sensor, std::uint32_t interval = 0);
+        /**
+         * @brief Register an optical sensor
+         *
+         * @return int index of its hue and proximity in the snapshot, or -1 if there's no room
+         */
+        int add(pros::Optical* sensor, std::uint32_t interval = 0);
+        /**
+         * @brief Read every device that's due, and publish the snapshot
+         *
+         * Only call from one task, at a priority no lower than the tasks that read the snapshot
+         *
+         * @return const DeviceSnapshot& the snapshot just published, which stays valid until the next tick
+         */
+        const DeviceSnapshot& update();
+        /**
+         * @brief Get the latest snapshot
+         */
+        DeviceSnapshot get() const;
+        /**
+         * @brief Get how many snapshots have been published
+         */
+        std::uint32_t getVersion() const;
+    private:
+        /**
+         * @brief A registered device, and when it's due to be read
+         */
+        template <typename T> struct Entry {
+                T* device = nullptr;
+                std::atomic<std::uint32_t> interval = 0;
+                std::uint32_t lastRead = 0;
+                bool read = false;
+        };
+
+        /**
+         * @brief Whether a device is due to be read, and if it is, note that it's being read now
+         */
+        template <typename T> static bool due(Entry<T>& entry, std::uint32_t now);
+
+        /**
+         * @brief Register a sensor that has one entry per device
+         */
+        template <typename T, std::size_t N>
+        static int addSensor(std::array<Entry<T>, N>& entries, std::atomic<int>& count, T* sensor,
+                             std::uint32_t interval);
+
+        struct MotorEntry : Entry<pros::AbstractMotor> {
+                int first = 0; // index of the first motor in the snapshot
+                int count = 0;
+                std::atomic<int> data = 0;
+        };
+
+        std::array<MotorEntry, DeviceSnapshot::MAX_MOTORS> motors {};
+        std::array<Entry<pros::Rotation>, DeviceSnapshot::MAX_ROTATIONS> rotations {};
+        std::array<Entry<pros::Imu>, DeviceSnapshot::MAX_IMUS> imus {};
+        std::array<Entry<pros::Optical>, DeviceSnapshot::MAX_OPTICALS> opticals {};
+        // entries are filled in before the count goes up, so the tick only sees whole entries
+        std::atomic<int> motorEntries = 0;
+        std::atomic<int> rotationCount = 0;
+        std::atomic<int> imuCount = 0;
+        std::atomic<int> opticalCount = 0;
+        int motorCount = 0; // motors in every entry
+
+        DeviceSnapshot snapshot {};
+        Seqlock<DeviceSnapshot> published {DeviceSnapshot {}};
+};
+
+/**
+ * @brief Get the device service LemLib's odometry ticks
+ */
+DeviceService& devices();
+} // namespace lemlib
@@ -59,10 +59,122 @@ class ExitCondition {
          * @endcode
          */
         void reset();
+        /**
+         * @brief how long the input has been in range since the last reset
+         *
+         * @return time in range, in milliseconds
+         *
+         * @b Example
+         * @code {.cpp}
+         * // print how long the input was in range for
+         * printf("time in range: %d\n", ec.getTimeInRange());
+         * @endcode
+         */
+        int getTimeInRange() const;
+        /**
+         * @brief when the input first came into range since the last reset
+         *
+         * @return time in milliseconds, or -1 if the input hasn't been in range
+         *
+         * @b Example
+         * @code {.cpp}
+         * // check if the input has ever been in range
+         * if (ec.getFirstEntryTime() != -1) {
+         *     // do something
+         * }
+         * @endcode
+         */
+        int getFirstEntryTime() const;
     protected:
         const float range;
         const int time;
         int startTime = -1;
         bool done = false;
+        int lastUpdateTime = -1;
+        int timeInRange = 0;
+        int firstEntryTime = -1;
+};
+
+/**
+ * @brief How to tell a motion has settled, see SettleExit
+ */
+class SettleSettings {
+    public:
+        /**
+         * @brief SettleSettings constructor
+         *
+         * @param range how far from the target the error can be predicted to end up, such as the large error range
+         * @param speed how slowly the robot and the error can be changing for the robot to count as stopped, in units
+         * of error per second. 0 disables settling
+         * @param time how long the robot has to stay settled for, in milliseconds
+         *
+         * @b Example
+         * @code {.cpp}
+         * // settled once the robot is going slower than 2 inches per second and will stop within 3 inches of the
+         * // target, for 50ms
+         * lemlib::SettleSettings lateralSettle(3, 2, 50);
+         * @endcode
+         */
+        SettleSettings(float range, float speed, int time)
+            : range(range),
+              speed(speed),
+              time(time) {}
+
+        float range;
+        float speed;
+        int time;
+};
+
+/**
+ * @brief Exits as soon as the robot has stopped where it's going to stop
+ *
+ * An ExitCondition waits out its timeout even after the robot has clearly stopped. This exits once the measured speed
+ * of the robot and the rate the error is changing at are both slow enough to count as stopped, and the error the robot
+ * is heading for is within range. The error it's heading for is the error now, plus where its rate takes it over the
+ * settle time.
+ */
+class SettleExit {
+    public:
+        /**
+         * @brief Create a new Settle Exit
+         *
+         * @param settings when to count as settled
+         *
+         * @b Example
+         * @code {.cpp}
+         * // exit once the robot is going slower than 2 inches per second and will stop within 3 inches of the target
+         * SettleExit se(lemlib::SettleSettings(3, 2, 50));
+         * @endcode
+         */
+        SettleExit(SettleSettings settings);
+        /**
+         * @brief whether the robot has settled
+         */
+        bool getExit() const;
+        /**
+         * @brief update the settle exit
+         *
+         * @param error the error of the motion
+         * @param speed how fast the robot is measured to be going, such as from lemlib::getSpeed, in units of error
+         * per second
+         * @return true the robot has settled
+         * @return false the robot hasn't settled
+         */
+        bool update(float error, float speed);
+        /**
+         * @brief reset the settle exit, for a new motion
+         */
+        void reset();
+        /**
+         * @brief change when to count as settled. Takes effect from the next reset
+         */
+        void setSettings(SettleSettings settings);
+    protected:
+        SettleSettings settings;
+        SettleSettings pending;
+        float prevError = 0;
+        int lastUpdateTime = -1;
+        int startTime = -1;
+        bool done = false;
 };
-} // namespace lemlib
\ No newline at end of file
+} // namespace lemlib
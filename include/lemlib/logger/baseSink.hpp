@@ -1,11 +1,15 @@
 #pragma once
 
 #include <initializer_list>
+#include <iterator>
+#include <string>
+#include <vector>
 #include "pros/rtos.hpp"
 
 #define FMT_HEADER_ONLY
 #include "fmt/core.h"
 #include "fmt/args.h"
+#include "fmt/format.h"
 
 #include "lemlib/logger/message.hpp"
 
@@ -68,26 +72,29 @@ class BaseSink {
          */
         template <typename... T> void log(Level level, fmt::format_string<T...> format, T&&... args) {
             if (!sinks.empty()) {
-                for (std::shared_ptr<BaseSink> sink : sinks) { sink->log(level, format, std::forward<T>(args)...); }
+                for (const std::shared_ptr<BaseSink>& sink : sinks) { sink->log(level, format, std::forward<T>(args)...); }
                 return;
             }
 
             if (level < lowestLevel) { return; }
 
-            // substitute the user's arguments into the format.
-            std::string messageString = fmt::format(format, std::forward<T>(args)...);
-
             Message message = Message {.level = level, .time = pros::millis()};
 
-            // get the arguments
-            fmt::dynamic_format_arg_store<fmt::format_context> formattingArgs = getExtraFormattingArgs(message);
-
-            formattingArgs.push_back(fmt::arg("time", message.time));
-            formattingArgs.push_back(fmt::arg("level", message.level));
-            formattingArgs.push_back(fmt::arg("message", messageString));
-
-            std::string formattedString = fmt::vformat(logFormat, std::move(formattingArgs));
-            message.message = std::move(formattedString);
+            if (!formatCompiled) {
+                // substitute the user's arguments into the format, then that into the sink's format
+                message.message = formatDynamic(message, fmt::format(format, std::forward<T>(args)...));
+            } else {
+                // fill in the sink's format one piece at a time, putting the user's message straight into it. fmt
+                // only takes the arguments by reference, so forwarding them more than once doesn't move them
+                fmt::memory_buffer buffer; // on the stack, so the message is allocated once at the end
+                auto out = std::back_inserter(buffer);
+                for (const FormatOp& op : compiledFormat) {
+                    if (op.field != FormatOp::Field::MESSAGE) appendField(buffer, op, message);
+                    else if (op.text.empty()) fmt::format_to(out, format, std::forward<T>(args)...);
+                    else fmt::format_to(out, fmt::runtime(op.text), fmt::format(format, std::forward<T>(args)...));
+                }
+                message.message.assign(buffer.data(), buffer.size());
+            }
             sendMessage(std::move(message));
         }
 
@@ -169,6 +176,9 @@ class BaseSink {
          * - {level} The level of the logged message.
          * - {message} The message itself.
          *
+         * The format is split into text and fields here, once, so logging a message doesn't parse it again. A format
+         * using the sink's extra formatting arguments is parsed for every message instead.
+         *
          * <h3> Example Usage </h3>
          * @code
          * infoSink()->setFormat("[LemLib] -- {time} -- {level}: {Message}");
@@ -201,8 +211,30 @@ class BaseSink {
          */
         virtual fmt::dynamic_format_arg_store<fmt::format_context> getExtraFormattingArgs(const Message& messageInfo);
     private:
+        /**
+         * @brief A piece of a compiled format: text to copy, or a field to fill in
+         */
+        struct FormatOp {
+                enum class Field { NONE, TIME, LEVEL, MESSAGE };
+
+                Field field;
+                /** the text to copy, or if the field has a spec, a format for the field on its own */
+                std::string text;
+        };
+
+        /**
+         * @brief Append a field other than the message
+         */
+        static void appendField(fmt::memory_buffer& out, const FormatOp& op, const Message& message);
+        /**
+         * @brief Format a message with a format that couldn't be compiled
+         */
+        std::string formatDynamic(const Message& message, std::string messageString);
+
         Level lowestLevel = Level::WARN;
         std::string logFormat;
+        std::vector<FormatOp> compiledFormat;
+        bool formatCompiled = true;
 
         std::vector<std::shared_ptr<BaseSink>> sinks {};
 };
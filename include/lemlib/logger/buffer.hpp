@@ -1,23 +1,52 @@
 #pragma once
 
-#include <deque>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <string>
+#include <string_view>
 
 #include "pros/rtos.hpp"
+#include "lemlib/logger/messageRing.hpp"
 
 namespace lemlib {
+/**
+ * @brief What a buffer does with a message when it's full
+ */
+enum class OverflowPolicy {
+    /** throw away the oldest message to make room */
+    DROP_OLDEST,
+    /** throw away the new message */
+    DROP_NEWEST,
+};
+
 /**
  * @brief A buffer implementation
  *
- * Asynchronously processes a backlog of strings at a given rate. The strings are processed in a first in last out
- * order.
+ * Asynchronously processes a backlog of strings at a given rate. The strings are processed in a first in first out
+ * order, one at a time or joined into batches.
+ *
+ * The backlog is a MessageRing, which any number of tasks can push to without locking, so pushing never waits for the
+ * buffer's task, even while it's processing a string. When the ring is full, a message is dropped
+ * according to the overflow policy, and counted. Messages longer than a slot are cut short.
  */
 class Buffer {
     public:
+        /**
+         * @brief Number of messages the buffer can hold
+         */
+        static constexpr std::uint32_t SLOT_COUNT = 32; // a power of 2, so positions can wrap
+        /**
+         * @brief Longest message the buffer can hold, in bytes
+         */
+        static constexpr std::size_t SLOT_SIZE = 254;
+
         /**
          * @brief Construct a new Buffer object
          *
+         * The buffer's task isn't started until start() is called, so a derived class can finish setting up what
+         * bufferFunc uses first. Messages pushed before then wait in the buffer.
          */
         Buffer(std::function<void(const std::string&)> bufferFunc);
 
@@ -35,7 +64,7 @@ class Buffer {
          *
          * @param bufferData
          */
-        void pushToBuffer(const std::string& bufferData);
+        void pushToBuffer(std::string_view bufferData);
 
         /**
          * @brief Set the rate of the sink
@@ -44,12 +73,66 @@ class Buffer {
          */
         void setRate(uint32_t rate);
 
+        /**
+         * @brief Get the rate of the sink
+         */
+        uint32_t getRate() const;
+
+        /**
+         * @brief Set how many bytes of messages to process at once, joined into one string
+         *
+         * @param size most bytes at once, though a longer message is still processed. 0 processes one message at a
+         * time, which is the default
+         */
+        void setBatchSize(std::size_t size);
+
+        /**
+         * @brief Set what happens to messages when the buffer is full. Defaults to dropping the new message
+         */
+        void setOverflowPolicy(OverflowPolicy policy);
+
         /**
          * @brief Check to see if the internal buffer is empty
          *
          */
         bool buffersEmpty();
+
+        /**
+         * @brief Get how many messages have been dropped because the buffer was full
+         */
+        std::uint32_t getDropped() const;
+
+        /**
+         * @brief Get how many messages have been cut short because they didn't fit in a slot
+         */
+        std::uint32_t getTruncated() const;
+
+        /**
+         * @brief Get the most messages the buffer has held at once
+         */
+        std::uint32_t getHighWaterMark() const;
+    protected:
+        /**
+         * @brief Start the task that processes the buffer, if it hasn't been already
+         *
+         */
+        void start();
     private:
+        /**
+         * @brief Put a message in the ring
+         *
+         * @return false if the ring is full
+         */
+        bool push(std::string_view message);
+
+        /**
+         * @brief Take the oldest message out of the ring
+         *
+         * @param out where to put it, or nullptr to throw it away
+         * @return false if the ring is empty
+         */
+        bool pop(std::string* out);
+
         /**
          * @brief The function that will be run inside of the buffer's task.
          *
@@ -60,13 +143,19 @@ class Buffer {
          * @brief The function that will be applied to each string in the buffer when it is removed.
          *
          */
-        std::function<void(std::string)> bufferFunc;
+        std::function<void(const std::string&)> bufferFunc;
+
+        MessageRing<SLOT_SIZE, SLOT_COUNT> ring;
 
-        std::deque<std::string> buffer = {};
+        std::atomic<OverflowPolicy> policy = OverflowPolicy::DROP_NEWEST;
+        std::atomic<std::uint32_t> dropped = 0;
+        std::atomic<std::uint32_t> truncated = 0;
+        std::atomic<std::uint32_t> highWaterMark = 0;
+        std::atomic<bool> processing = false;
+        std::atomic<std::size_t> batchSize = 0;
 
-        pros::Mutex mutex;
-        pros::Task task;
+        pros::Task* task = nullptr;
 
-        uint32_t rate;
+        uint32_t rate = 0;
 };
 } // namespace lemlib
@@ -25,6 +25,14 @@ struct Message {
         uint32_t time;
 };
 
+/**
+ * @brief Get the name of a level
+ *
+ * @param level
+ * @return const char*
+ */
+const char* levelName(Level level);
+
 /**
  * @brief Format a level
  *
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+namespace lemlib {
+/**
+ * @brief A ring of preallocated slots that any number of tasks can push messages to and pop them from, without locking
+ *
+ * Each slot has a turn, which says which lap of the ring it's ready for and whether it's been written. A task claims a
+ * position by moving the head or tail past it, then writes or reads the slot and passes it on to the next lap, so a
+ * task never waits for another to finish with a slot. Pushing to a full ring or popping from an empty one fails
+ * instead of waiting.
+ *
+ * @tparam SLOT_SIZE longest message a slot can hold, in bytes
+ * @tparam SLOT_COUNT number of slots, a power of 2 so positions can wrap
+ */
+template <std::size_t SLOT_SIZE, std::uint32_t SLOT_COUNT> class MessageRing {
+        static_assert(std::has_single_bit(SLOT_COUNT), "positions must wrap at a lap of the ring");
+        static_assert(SLOT_SIZE <= UINT16_MAX, "slot sizes are kept in 16 bits");
+    public:
+        /**
+         * @brief Put a message in the ring
+         *
+         * @param data the message
+         * @param size size of the message, at most SLOT_SIZE bytes
+         * @return the number of messages in the ring after it was pushed, or 0 if the ring is full
+         */
+        std::uint32_t push(const std::uint8_t* data, std::size_t size) {
+            std::uint32_t position = head.load(std::memory_order_acquire);
+            while (true) {
+                Slot& slot = slots[position % SLOT_COUNT];
+                if (slot.turn.load(std::memory_order_acquire) == turn(position)) {
+                    if (head.compare_exchange_weak(position, position + 1, std::memory_order_acq_rel)) {
+                        slot.size = size;
+                        std::copy_n(data, size, slot.data.begin());
+                        slot.turn.store(turn(position) + 1, std::memory_order_release);
+                        break;
+                    }
+                } else {
+                    // the slot is still in use a lap behind, unless another task has just taken it
+                    const std::uint32_t previous = position;
+                    position = head.load(std::memory_order_acquire);
+                    if (position == previous) return 0;
+                }
+            }
+            return std::min(position + 1 - tail.load(std::memory_order_relaxed), SLOT_COUNT);
+        }
+
+        /**
+         * @brief Take the oldest message out of the ring
+         *
+         * @param consume called with the message and its size before the slot is freed, or nullptr to throw it away
+         * @return false if the ring is empty
+         */
+        template <typename F> bool pop(F&& consume) {
+            std::uint32_t position = tail.load(std::memory_order_acquire);
+            while (true) {
+                Slot& slot = slots[position % SLOT_COUNT];
+                if (slot.turn.load(std::memory_order_acquire) == turn(position) + 1) {
+                    if (tail.compare_exchange_weak(position, position + 1, std::memory_order_acq_rel)) {
+                        if constexpr (!std::is_null_pointer_v<std::decay_t<F>>) consume(slot.data.data(), slot.size);
+                        slot.turn.store((turn(position) + 2) % TURN_WRAP, std::memory_order_release);
+                        return true;
+                    }
+                } else {
+                    // the slot hasn't been written yet, unless another task has just taken it
+                    const std::uint32_t previous = position;
+                    position = tail.load(std::memory_order_acquire);
+                    if (position == previous) return false;
+                }
+            }
+        }
+
+        /**
+         * @brief Check if there are no messages waiting, or being written
+         */
+        bool empty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+    private:
+        /**
+         * @brief A message in the ring
+         */
+        struct Slot {
+                /** twice the lap of the ring the slot is ready to be written in, plus one once it's written */
+                std::atomic<std::uint32_t> turn = 0;
+                std::uint16_t size = 0;
+                std::array<std::uint8_t, SLOT_SIZE> data;
+        };
+
+        // laps of the ring before positions wrap. Turns count 2 per lap, and wrap with them
+        static constexpr std::uint32_t TURN_WRAP = (UINT32_MAX / SLOT_COUNT + 1) * 2;
+
+        /**
+         * @brief Get the turn a slot has to be on for position to be written to it
+         */
+        static constexpr std::uint32_t turn(std::uint32_t position) { return position / SLOT_COUNT * 2; }
+
+        std::array<Slot, SLOT_COUNT> slots;
+        // positions ever pushed at and popped from, so they can wrap
+        std::atomic<std::uint32_t> head = 0;
+        std::atomic<std::uint32_t> tail = 0;
+};
+} // namespace lemlib
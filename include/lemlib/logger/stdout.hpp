@@ -2,8 +2,10 @@
 
 #define FMT_HEADER_ONLY
 #include "fmt/core.h"
+#include "fmt/format.h"
 
 #include "lemlib/logger/buffer.hpp"
+#include "lemlib/logger/transport.hpp"
 
 namespace lemlib {
 /**
@@ -22,8 +24,21 @@ class BufferedStdout : public Buffer {
          *
          */
         template <typename... T> void print(fmt::format_string<T...> format, T&&... args) {
-            pushToBuffer(fmt::format(format, std::forward<T>(args)...));
+            // formatted on the stack, so printing doesn't allocate
+            fmt::memory_buffer text;
+            fmt::format_to(std::back_inserter(text), format, std::forward<T>(args)...);
+            pushToBuffer(std::string_view(text.data(), text.size()));
         }
+
+        /**
+         * @brief Send what's printed through a transport, in batches sized to its link, or straight to stdout if
+         * it's nullptr (the default)
+         *
+         * @param transport the transport, which must outlive its use here
+         */
+        void setTransport(Transport* transport);
+    private:
+        std::atomic<Transport*> transport = nullptr;
 };
 
 /**
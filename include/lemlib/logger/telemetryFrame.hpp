@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lemlib::telemetry {
+/**
+ * @brief Binary telemetry frames
+ *
+ * A frame is a sync byte, the type, the size of the payload, the time in milliseconds, the payload, and a checksum
+ * of everything after the sync byte. Numbers are little endian, and values are packed as floats. A reader that
+ * loses its place finds the next sync byte with a good checksum.
+ */
+
+/** first byte of every frame */
+constexpr std::uint8_t SYNC = 0xA5;
+/** bytes before the payload: sync, type, payload size and time */
+constexpr std::size_t HEADER_SIZE = 7;
+/** largest payload, in bytes */
+constexpr std::size_t MAX_PAYLOAD = 255;
+/** largest frame, in bytes */
+constexpr std::size_t MAX_FRAME = HEADER_SIZE + MAX_PAYLOAD + 1;
+/** most values in one frame */
+constexpr int MAX_VALUES = MAX_PAYLOAD / sizeof(float);
+
+/** a text message, logged with info(), warn() etc. The payload is the text */
+constexpr std::uint8_t TEXT = 0;
+/** x, y and theta of the chassis */
+constexpr std::uint8_t POSE = 1;
+/** x, y and theta speed of the chassis */
+constexpr std::uint8_t SPEED = 2;
+/** types from here up are free for the program to use */
+constexpr std::uint8_t USER = 64;
+
+/**
+ * @brief A frame read out of a stream
+ */
+struct Frame {
+        std::uint8_t type;
+        /** milliseconds since the program started */
+        std::uint32_t time;
+        /** size of the payload, in bytes */
+        std::uint8_t size;
+        /** points into the stream the frame was read from */
+        const std::uint8_t* payload;
+};
+
+/**
+ * @brief Write a frame
+ *
+ * @param out where to write it, with room for HEADER_SIZE + size + 1 bytes
+ * @param type type of the frame
+ * @param time when it was sent, in milliseconds
+ * @param payload what to send
+ * @param size size of the payload, at most MAX_PAYLOAD bytes
+ * @return std::size_t how many bytes were written
+ */
+std::size_t encode(std::uint8_t* out, std::uint8_t type, std::uint32_t time, const void* payload, std::size_t size);
+
+/**
+ * @brief Read the frame at the start of some data
+ *
+ * @param data what to read from
+ * @param size how many bytes there are
+ * @param frame set to the frame, if there's a whole one
+ * @return int how many bytes the frame took up, 0 if more data is needed to tell, or -1 if data doesn't start with a
+ * frame, in which case skip a byte and try again
+ */
+int decode(const std::uint8_t* data, std::size_t size, Frame& frame);
+
+/**
+ * @brief Get the name of a type LemLib sends, or nullptr for any other type
+ */
+const char* typeName(std::uint8_t type);
+} // namespace lemlib::telemetry
@@ -1,6 +1,12 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include "lemlib/logger/baseSink.hpp"
+#include "lemlib/logger/messageRing.hpp"
+#include "lemlib/logger/telemetryFrame.hpp"
 
 namespace lemlib {
 /**
@@ -10,19 +16,76 @@ namespace lemlib {
  * used for sending data that is not meant to be viewed by the user, but will still be used by something else, like a
  * data visualization tool. Messages sent through this sink will not be cleared from the terminal and not be visible to
  * the user.
+ *
+ * Numbers sent with send() can go out as text, or in binary mode as compact frames (see telemetryFrame.hpp). Binary
+ * frames are packed on the stack and copied into a MessageRing allocated with the sink, so sending one doesn't
+ * allocate or wait for a lock, and the ring is written out by a task of its own. Text messages go out as text frames
+ * in binary mode.
 
  * <h3> Example Usage </h3>
  * @code
  * lemlib::telemetrySink()->setLowestLevel(lemlib::Level::INFO);
  * lemlib::telemetrySink()->info("{},{}", motor1.get_temperature(), motor2.get_temperature());
+ *
+ * lemlib::telemetrySink()->setMode(lemlib::TelemetrySink::Mode::BINARY);
+ * lemlib::telemetrySink()->send(lemlib::telemetry::POSE, pose.x, pose.y, pose.theta);
  * @endcode
  */
 class TelemetrySink : public BaseSink {
     public:
+        /**
+         * @brief How the sink sends telemetry
+         */
+        enum class Mode {
+            /** as text, through the buffered stdout */
+            TEXT,
+            /** as binary frames, through the output */
+            BINARY,
+        };
+        /**
+         * @brief Number of binary frames that can wait to be written
+         */
+        static constexpr std::uint32_t SLOT_COUNT = 32;
+
         /**
          * @brief Construct a new Telemetry Sink object
          */
         TelemetrySink();
+        /**
+         * @brief Set how the sink sends telemetry. Starts in text mode
+         */
+        void setMode(Mode mode);
+        /**
+         * @brief Set where binary frames are written. Defaults to stdout
+         *
+         * @param output called from the sink's task with the next bytes of the stream. Set before binary mode
+         */
+        void setOutput(std::function<void(const std::uint8_t* data, std::size_t size)> output);
+        /**
+         * @brief Send some numbers. Always sent, whatever the lowest level is
+         *
+         * In text mode, they're sent as "type,value,value..."
+         *
+         * @param type type of frame, from telemetry::USER up for the program's own
+         * @param values up to telemetry::MAX_VALUES numbers, sent as floats
+         */
+        template <typename... T> void send(std::uint8_t type, T... values) {
+            static_assert(sizeof...(T) <= telemetry::MAX_VALUES, "too many values for one frame");
+            const std::array<float, sizeof...(T)> packed {static_cast<float>(values)...};
+            send(type, packed.data(), static_cast<int>(packed.size()));
+        }
+        /**
+         * @brief Send some numbers. Always sent, whatever the lowest level is
+         *
+         * @param type type of frame, from telemetry::USER up for the program's own
+         * @param values the numbers
+         * @param count how many numbers, at most telemetry::MAX_VALUES
+         */
+        void send(std::uint8_t type, const float* values, int count);
+        /**
+         * @brief Get how many frames were dropped because the ring was full
+         */
+        std::uint32_t getDropped() const;
     private:
         /**
          * @brief Log the given message
@@ -30,5 +93,20 @@ class TelemetrySink : public BaseSink {
          * @param message
          */
         void sendMessage(const Message& message) override;
+        /**
+         * @brief Put a frame in the ring, or drop it if there isn't room
+         */
+        void push(std::uint8_t type, std::uint32_t time, const void* payload, std::size_t size);
+        /**
+         * @brief Write the ring to the output as it fills
+         */
+        void drain();
+
+        std::atomic<Mode> mode = Mode::TEXT;
+        std::function<void(const std::uint8_t*, std::size_t)> output;
+        pros::Task* task = nullptr;
+
+        MessageRing<telemetry::MAX_FRAME, SLOT_COUNT> ring;
+        std::atomic<std::uint32_t> dropped = 0;
 };
 } // namespace lemlib
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+#include "pros/serial.hpp"
+#include "lemlib/logger/transportFrame.hpp"
+
+namespace lemlib {
+/**
+ * @brief Sends text in batches, as frames with sequence numbers and optional compression
+ *
+ * Sending many messages in one write, compressed, gets far more through a slow link like the radio than writing them
+ * one at a time. The receiver (sim/tools/receiver.cpp) puts the text back together and reports any frames it missed.
+ *
+ * <h3> Example Usage </h3>
+ * @code
+ * lemlib::Transport transport(4000); // 4 kB/s through stdout
+ * transport.setCompression(true);
+ * lemlib::bufferedStdout().setTransport(&transport);
+ * @endcode
+ */
+class Transport {
+    public:
+        /**
+         * @brief Send through stdout
+         *
+         * @param bytesPerSecond how much the link can carry
+         */
+        Transport(std::uint32_t bytesPerSecond);
+        /**
+         * @brief Send through a smart port in generic serial mode
+         *
+         * @param serial the port, which must outlive the transport
+         * @param baudrate the port's baud rate
+         */
+        Transport(pros::Serial* serial, std::uint32_t baudrate);
+        /**
+         * @brief Turn compression on or off. Off to begin with
+         */
+        void setCompression(bool enabled);
+        /**
+         * @brief Get how much text to send at once to keep up with the link
+         *
+         * Sized from how much the link carries in the time, and how much compression has been saving
+         *
+         * @param interval time between sends, in milliseconds
+         * @return std::size_t bytes of text, at most transport::MAX_PAYLOAD
+         */
+        std::size_t getBatchSize(std::uint32_t interval) const;
+        /**
+         * @brief Send some text, in as many frames as it needs
+         *
+         * Waits until a serial port has room for each frame. Only call from one task at a time
+         */
+        void send(std::string_view text);
+        /**
+         * @brief Get the sequence number of the next frame
+         */
+        std::uint16_t getSequence() const;
+        /**
+         * @brief Get how many bytes of text have been sent
+         */
+        std::uint32_t getTextBytes() const;
+        /**
+         * @brief Get how many bytes have been written to the link, frames and all
+         */
+        std::uint32_t getLinkBytes() const;
+    private:
+        /**
+         * @brief Write a frame to the link
+         */
+        void write(std::uint8_t* data, std::size_t size);
+
+        pros::Serial* serial = nullptr;
+        std::uint32_t bytesPerSecond;
+        std::atomic<bool> compression = false;
+        std::atomic<std::uint16_t> sequence = 0;
+        std::atomic<std::uint32_t> textBytes = 0;
+        std::atomic<std::uint32_t> linkBytes = 0;
+        std::array<std::uint8_t, transport::MAX_FRAME> frame;
+};
+} // namespace lemlib
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lemlib::transport {
+/**
+ * @brief Frames the transport sends a batch of text in
+ *
+ * A frame is two magic bytes, flags, a sequence number, the size of the payload, the payload, and a CRC-16 of
+ * everything after the magic bytes. Numbers are little endian. Sequence numbers count up by one a frame, so a
+ * receiver can tell how many frames it missed. A compressed payload is LZSS with a window the size of a frame.
+ */
+
+/** first two bytes of every frame */
+constexpr std::uint8_t MAGIC[2] = {0xA6, 0x5A};
+/** bytes before the payload: magic, flags, sequence number and payload size */
+constexpr std::size_t HEADER_SIZE = 7;
+/** bytes after the payload: the CRC */
+constexpr std::size_t TRAILER_SIZE = 2;
+/** largest payload, in bytes, before or after compression */
+constexpr std::size_t MAX_PAYLOAD = 1024;
+/** largest frame, in bytes */
+constexpr std::size_t MAX_FRAME = HEADER_SIZE + MAX_PAYLOAD + TRAILER_SIZE;
+/** set in the flags if the payload is compressed */
+constexpr std::uint8_t COMPRESSED = 1;
+
+/**
+ * @brief A frame read out of a stream
+ */
+struct Frame {
+        std::uint8_t flags;
+        std::uint16_t sequence;
+        /** size of the payload as sent, in bytes */
+        std::uint16_t size;
+        /** points into the stream the frame was read from */
+        const std::uint8_t* payload;
+};
+
+/**
+ * @brief Write a frame
+ *
+ * @param out where to write it, with room for MAX_FRAME bytes
+ * @param sequence sequence number of the frame
+ * @param data what to send
+ * @param size size of the data, at most MAX_PAYLOAD bytes
+ * @param compress true to compress the data, if that makes it smaller
+ * @return std::size_t how many bytes were written
+ */
+std::size_t encode(std::uint8_t* out, std::uint16_t sequence, const void* data, std::size_t size, bool compress);
+
+/**
+ * @brief Read the frame at the start of some data
+ *
+ * @param data what to read from
+ * @param size how many bytes there are
+ * @param frame set to the frame, if there's a whole one
+ * @return int how many bytes the frame took up, 0 if more data is needed to tell, or -1 if data doesn't start with a
+ * frame, in which case skip a byte and try again
+ */
+int decode(const std::uint8_t* data, std::size_t size, Frame& frame);
+
+/**
+ * @brief Get what a frame carries, decompressing it if it needs to be
+ *
+ * @param frame the frame
+ * @param out where to put it, with room for MAX_PAYLOAD bytes
+ * @return int how many bytes it carries, or -1 if a compressed payload is corrupt
+ */
+int unpack(const Frame& frame, std::uint8_t* out);
+
+/**
+ * @brief Compress some data
+ *
+ * @param in data to compress, at most MAX_PAYLOAD bytes
+ * @param size size of the data
+ * @param out where to put the compressed data
+ * @param capacity how many bytes there's room for
+ * @return std::size_t size of the compressed data, or 0 if it doesn't fit
+ */
+std::size_t compress(const std::uint8_t* in, std::size_t size, std::uint8_t* out, std::size_t capacity);
+
+/**
+ * @brief Decompress data compressed with compress()
+ *
+ * @return int size of the decompressed data, or -1 if it's corrupt or doesn't fit
+ */
+int decompress(const std::uint8_t* in, std::size_t size, std::uint8_t* out, std::size_t capacity);
+} // namespace lemlib::transport
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "lemlib/asset.hpp"
+
+namespace lemlib {
+/**
+ * @brief A point on a path, with everything follow() needs already worked out
+ *
+ * Binary path assets are an array of these, so their layout must not change without bumping PATH_VERSION.
+ */
+struct PathPoint {
+        /** x position, in inches */
+        float x;
+        /** y position, in inches */
+        float y;
+        /** target speed at this point, out of 127. 0 marks the end of the path */
+        float speed;
+        /** curvature of the path at this point, in 1/inches. Positive when the path bends right */
+        float curvature;
+        /** distance along the path from the first point, in inches */
+        float distance;
+};
+
+/**
+ * @brief Header at the start of a binary path asset, followed directly by the points
+ */
+struct PathHeader {
+        /** always PATH_MAGIC */
+        char magic[4];
+        /** format version, PATH_VERSION for the current layout */
+        std::uint32_t version;
+        /** number of points following the header */
+        std::uint32_t count;
+        /** size of each point in bytes, to catch assets made with a different layout */
+        std::uint32_t pointSize;
+};
+
+static_assert(sizeof(PathPoint) == 20, "binary path layout changed, bump PATH_VERSION");
+static_assert(sizeof(PathHeader) % alignof(PathPoint) == 0, "points after the header would be misaligned");
+
+constexpr char PATH_MAGIC[4] = {'L', 'L', 'P', 'B'};
+constexpr std::uint32_t PATH_VERSION = 1;
+
+/**
+ * @brief Check whether an asset is a binary path, rather than a text one
+ *
+ * @param path the asset to check
+ * @return true if the asset starts with the binary path header
+ */
+bool isBinaryPath(const asset& path);
+
+/**
+ * @brief Get the points of a binary path asset, without copying or parsing them
+ *
+ * The points are read straight from the asset, which has to be linked with at least 4 byte alignment.
+ *
+ * @param path the binary path asset
+ * @return the points on the path, or an empty span if the asset isn't a valid binary path
+ */
+std::span<const PathPoint> binaryPathPoints(const asset& path);
+
+/**
+ * @brief Fill in the curvature and cumulative distance of points that only have a position and speed
+ *
+ * The curvature at each point is that of the circle through it and its neighbours. The first and last points take
+ * the curvature of the point next to them.
+ *
+ * @param points the points to update
+ */
+void annotatePath(std::span<PathPoint> points);
+} // namespace lemlib
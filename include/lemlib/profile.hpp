@@ -0,0 +1,92 @@
+#pragma once
+
+namespace lemlib {
+/**
+ * @brief Where a motion profile says the robot should be at a point in time
+ */
+struct ProfileState {
+        /** distance traveled since the start of the profile, in inches */
+        float position;
+        /** velocity, in inches per second */
+        float velocity;
+        /** acceleration, in inches per second squared */
+        float acceleration;
+};
+
+/**
+ * @brief Time-optimal velocity profile along a straight line, with limited velocity, acceleration and jerk
+ *
+ * The profile speeds up from the start velocity, cruises, then slows down to the end velocity, as fast as the limits
+ * allow. With a jerk limit each change in velocity is an S-curve, without one the profile is trapezoidal.
+ */
+class MotionProfile {
+    public:
+        /**
+         * @brief Plan a motion profile
+         *
+         * If the distance is too short to reach the end velocity, the profile ends at the fastest velocity it can
+         * reach instead. If it's too short to slow down to the end velocity, it slows down as hard as it can and ends
+         * faster than asked.
+         *
+         * @param distance how far to travel, in inches. Must not be negative
+         * @param maxVelocity maximum velocity, in inches per second
+         * @param maxAcceleration maximum acceleration and deceleration, in inches per second squared
+         * @param maxJerk maximum rate of change of acceleration, in inches per second cubed. 0 for no limit
+         * @param startVelocity velocity at the start, in inches per second
+         * @param endVelocity velocity to end at, in inches per second
+         *
+         * @b Example
+         * @code {.cpp}
+         * // drive 24 inches at up to 60 inches per second
+         * lemlib::MotionProfile profile(24, 60, 150, 1000);
+         * // where the robot should be half a second in
+         * lemlib::ProfileState state = profile.sample(0.5);
+         * @endcode
+         */
+        MotionProfile(float distance, float maxVelocity, float maxAcceleration, float maxJerk = 0,
+                      float startVelocity = 0, float endVelocity = 0);
+        /**
+         * @brief Get where the robot should be at a point in time
+         *
+         * @param time seconds since the start of the profile. Clamped to the length of the profile
+         * @return ProfileState position, velocity and acceleration
+         */
+        ProfileState sample(float time) const;
+        /**
+         * @brief Get how long the profile takes
+         *
+         * @return float duration, in seconds
+         */
+        float getDuration() const;
+        /**
+         * @brief Get the velocity the profile ends at, which can differ from the one asked for
+         *
+         * @return float end velocity, in inches per second
+         */
+        float getEndVelocity() const;
+    private:
+        /**
+         * @brief A change in velocity, with the acceleration ramped up and down at the jerk limit
+         */
+        struct Ramp {
+                Ramp() = default;
+                Ramp(float startVelocity, float endVelocity, float maxAcceleration, float maxJerk);
+                ProfileState sample(float time) const;
+
+                float startVelocity = 0;
+                float endVelocity = 0;
+                float jerk = 0; // signed
+                float acceleration = 0; // signed peak acceleration
+                float jerkTime = 0; // time spent ramping the acceleration up, and again ramping it down
+                float accelTime = 0; // time spent at the peak acceleration
+                float duration = 0;
+                float distance = 0;
+        };
+
+        Ramp speedUp;
+        Ramp slowDown;
+        float cruiseVelocity = 0;
+        float cruiseTime = 0;
+        float distance = 0;
+};
+} // namespace lemlib
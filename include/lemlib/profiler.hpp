@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include "pros/rtos.hpp"
+
+namespace lemlib::profiler {
+/**
+ * @brief Most tasks the profiler keeps stats for
+ */
+constexpr int MAX_TASKS = 16;
+/**
+ * @brief Number of wake and sleep events the profiler remembers
+ */
+constexpr int EVENT_COUNT = 256;
+
+/**
+ * @brief How a task has been keeping to its period
+ *
+ * A task is running from when a profiled delay returns to when it next calls one. That includes time it spent
+ * preempted, and time blocked on anything other than a profiled delay.
+ */
+struct TaskStats {
+        /** name of the task */
+        const char* name;
+        /** priority of the task */
+        std::uint32_t priority;
+        /** how many times the task has woken up from a profiled delay */
+        std::uint32_t wakes;
+        /** total time running, in microseconds */
+        std::uint64_t runTime;
+        /** longest time running between delays, in microseconds */
+        std::uint32_t maxRunTime;
+        /** total time between when the task asked to wake up and when it did, in microseconds */
+        std::uint64_t latency;
+        /** longest time between when the task asked to wake up and when it did, in microseconds */
+        std::uint32_t maxLatency;
+        /** longest time between two wake ups, in microseconds */
+        std::uint32_t maxPeriod;
+        /** how many times a profiled task of higher priority woke up while this one was running */
+        std::uint32_t preemptions;
+};
+
+/**
+ * @brief Something a profiled task did
+ */
+struct Event {
+        /** when it happened, in microseconds, wrapping every 71 minutes */
+        std::uint32_t time;
+        /** index of the task, see getStats */
+        std::uint8_t task;
+        /** true if the task woke up, false if it went to sleep */
+        bool wake;
+        /** for a wake up, how late it was. For going to sleep, how long it had been running. In microseconds */
+        std::uint32_t value;
+};
+
+/**
+ * @brief Delay the calling task for an amount of time, and profile it
+ *
+ * Drop in replacement for pros::delay in periodic loops
+ *
+ * @param milliseconds how long to delay for
+ */
+void delay(std::uint32_t milliseconds);
+/**
+ * @brief Delay the calling task until a time, and profile it
+ *
+ * Drop in replacement for pros::Task::delay_until in periodic loops
+ *
+ * @param previous when the task last woke up, in milliseconds. Updated to when it wakes up this time
+ * @param period how long after the last time to wake up, in milliseconds
+ */
+void delayUntil(std::uint32_t* previous, std::uint32_t period);
+/**
+ * @brief Tell the profiler the calling task has left its loop
+ *
+ * Call before a profiled task ends, so it isn't counted as running, and being preempted, after it's gone
+ */
+void stop();
+/**
+ * @brief Get how many tasks have been profiled
+ *
+ * Tasks with the same name and priority are profiled as one task, so they shouldn't run at the same time
+ */
+int getTaskCount();
+/**
+ * @brief Get the stats of a profiled task. Call from a task with a priority no higher than the task's
+ *
+ * @param index which task, from 0 to getTaskCount() - 1, in the order they were first profiled
+ */
+TaskStats getStats(int index);
+/**
+ * @brief Get the recent events, oldest first
+ *
+ * An event that's being recorded while they're copied is left out, rather than copied half written.
+ *
+ * @param events where to put the events
+ * @param count most events to get
+ * @return int how many events were copied
+ */
+int getEvents(Event* events, int count);
+/**
+ * @brief Log the stats of every profiled task to the telemetry sink
+ *
+ * @param events true to log the recent events as well
+ */
+void report(bool events = false);
+} // namespace lemlib::profiler
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "pros/rtos.hpp"
+
+namespace lemlib {
+/**
+ * @brief A value one task writes and any task can read, without locks
+ *
+ * The writer never waits. A reader copies the value and checks the sequence number didn't change while it did, and
+ * copies again if it did, so it always gets a value from one write and never half of two. The value is kept as atomic
+ * words, so reading while it's written is well defined.
+ *
+ * There must only be one writer at a time. On a single core, a reader only sees a write part way through if it
+ * interrupted the writer, which can't finish until the reader lets it run. So after a few failed copies, read() sleeps
+ * for a millisecond between them, and a reader with a higher priority than the writer waits for it instead of spinning
+ * forever. A task that mustn't wait, like one that runs on a fixed period, should use tryRead() instead.
+ *
+ * @tparam T the value, which must be trivially copyable and a whole number of 32 bit words
+ */
+template <typename T> class Seqlock {
+        static_assert(std::is_trivially_copyable_v<T>, "a seqlock copies its value word by word");
+        static_assert(sizeof(T) % sizeof(std::uint32_t) == 0, "a seqlock copies its value word by word");
+    public:
+        /**
+         * @brief Seqlock constructor
+         *
+         * @param value the value before the first write
+         */
+        Seqlock(const T& value) { store(value); }
+
+        Seqlock(const Seqlock&) = delete;
+        Seqlock& operator=(const Seqlock&) = delete;
+
+        /**
+         * @brief Publish a new value
+         *
+         * @param value the new value
+         */
+        void write(const T& value) {
+            const std::uint32_t start = sequence.load(std::memory_order_relaxed);
+            // an odd sequence number tells readers a write is in progress
+            sequence.store(start + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            store(value);
+            sequence.store(start + 2, std::memory_order_release);
+        }
+
+        /**
+         * @brief Read the latest value
+         *
+         * @param version set to how many times the value has been written, if not null
+         * @return T the value
+         */
+        T read(std::uint32_t* version = nullptr) const {
+            std::array<std::uint32_t, WORDS> raw;
+            for (int attempts = 1; !copy(raw, version); attempts++) {
+                if (attempts >= SPIN_LIMIT) pros::delay(1);
+            }
+            return std::bit_cast<T>(raw);
+        }
+
+        /**
+         * @brief Copy the latest value once, without retrying if it was being written
+         *
+         * @param value set to the value if it was copied whole, otherwise left as it was
+         * @param version set to how many times the value has been written, if not null and the value was copied
+         * @return true if the value was copied
+         */
+        bool tryRead(T& value, std::uint32_t* version = nullptr) const {
+            std::array<std::uint32_t, WORDS> raw;
+            if (!copy(raw, version)) return false;
+            value = std::bit_cast<T>(raw);
+            return true;
+        }
+
+        /**
+         * @brief Get how many times the value has been written
+         *
+         * It only ever goes up, so a reader can tell if there's been a write since it last read.
+         */
+        std::uint32_t getVersion() const { return sequence.load(std::memory_order_acquire) / 2; }
+    private:
+        static constexpr std::size_t WORDS = sizeof(T) / sizeof(std::uint32_t);
+        // copies that can fail in a row before the reader assumes it interrupted the writer
+        static constexpr int SPIN_LIMIT = 16;
+
+        bool copy(std::array<std::uint32_t, WORDS>& raw, std::uint32_t* version) const {
+            const std::uint32_t before = sequence.load(std::memory_order_acquire);
+            if (before & 1) return false;
+            for (std::size_t i = 0; i < WORDS; i++) raw[i] = words[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) != before) return false;
+            if (version != nullptr) *version = before / 2;
+            return true;
+        }
+
+        void store(const T& value) {
+            // memcpy rather than bit_cast, since the value may have padding
+            std::array<std::uint32_t, WORDS> raw;
+            std::memcpy(raw.data(), &value, sizeof(T));
+            for (std::size_t i = 0; i < WORDS; i++) words[i].store(raw[i], std::memory_order_relaxed);
+        }
+
+        std::atomic<std::uint32_t> sequence = 0;
+        std::array<std::atomic<std::uint32_t>, WORDS> words;
+};
+} // namespace lemlib
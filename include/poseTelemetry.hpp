@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include "lemlib/chassis/chassis.hpp"
+#include "subsystem.hpp"
+
+/**
+ * @brief Sends the pose and speed of the chassis to the telemetry sink, as pose and speed frames
+ *
+ * Best with the sink in binary mode, where each update is two small frames and nothing is formatted or allocated.
+ */
+class PoseTelemetry : public Subsystem {
+    public:
+        /**
+         * @brief PoseTelemetry constructor
+         *
+         * @param chassis the chassis to send the pose of
+         * @param period time between updates, in milliseconds
+         */
+        PoseTelemetry(lemlib::Chassis* chassis, std::uint32_t period = 10);
+        /**
+         * @brief Send the pose and speed
+         */
+        void periodic() override;
+    private:
+        lemlib::Chassis* chassis;
+};
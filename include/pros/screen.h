@@ -21,9 +21,13 @@
 
 #include <stdarg.h>
 #include <stdbool.h>
+#ifndef _GNU_SOURCE
 #define _GNU_SOURCE
 #include <stdio.h>
 #undef _GNU_SOURCE
+#else
+#include <stdio.h>
+#endif
 #include <stdint.h>
 
 #include "pros/colors.h"  // c color macros
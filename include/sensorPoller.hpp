@@ -0,0 +1,147 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include "pros/optical.hpp"
+#include "pros/rtos.hpp"
+#include "subsystem.hpp"
+
+/**
+ * @brief A range of hues, and how close an object has to be, for an optical sensor to watch for
+ */
+struct ColorBand {
+        /** lowest hue in the band, in degrees. If it's more than maxHue, the band wraps around through 0 */
+        float minHue;
+        /** highest hue in the band, in degrees */
+        float maxHue;
+        /** proximity the object has to be closer than, from 0 to 255 */
+        int proximity;
+};
+
+/**
+ * @brief Watches an optical sensor for objects of a color, such as rings going past it, and wakes the tasks that
+ * subscribe to it or runs a callback when one arrives
+ *
+ * The trigger stays active until the object leaves the band by more than the hysteresis, so an object whose reading
+ * flickers at the edge of the band only triggers once.
+ */
+class ColorTrigger {
+    public:
+        /**
+         * @brief Most tasks that can subscribe to one trigger
+         */
+        static constexpr int MAX_SUBSCRIBERS = 4;
+        /**
+         * @brief ColorTrigger constructor
+         *
+         * @param sensor the optical sensor
+         * @param band the color to watch for
+         * @param hueHysteresis how far outside the band the hue has to go, in degrees, for the object to have left
+         * @param proximityHysteresis how far below the band's proximity the proximity has to drop for the object to
+         * have left
+         *
+         * @b Example
+         * @code {.cpp}
+         * pros::Optical colorSensor(9);
+         * // red rings closer than 100. Red hues wrap around 0
+         * ColorTrigger redRing(&colorSensor, {300, 20, 100});
+         * @endcode
+         */
+        ColorTrigger(pros::Optical* sensor, ColorBand band, float hueHysteresis = 10, int proximityHysteresis = 20);
+        /**
+         * @brief Wake a task every time an object arrives
+         *
+         * The task is notified with the bits of getMask(), so a task subscribed to several triggers can wait for all of
+         * them with pros::Task::notify_take(true, TIMEOUT_MAX) and tell them apart by the bits it gets back. Extra
+         * subscribers past MAX_SUBSCRIBERS are ignored
+         *
+         * @param task the task to notify
+         */
+        void subscribe(pros::Task task);
+        /**
+         * @brief Run a function every time an object arrives
+         *
+         * It runs on the poller's subsystem scheduler, so it must be quick and never block
+         *
+         * @param callback the function
+         */
+        void onArrive(std::function<void()> callback);
+        /**
+         * @brief Get the notification bit of this trigger, set when it's added to a SensorPoller
+         */
+        std::uint32_t getMask() const;
+        /**
+         * @brief Whether an object in the band is in front of the sensor
+         */
+        bool isActive() const;
+        /**
+         * @brief Get how many objects have arrived
+         */
+        int getCount() const;
+    private:
+        friend class SensorPoller;
+        /**
+         * @brief Whether a hue is in the band, widened by a margin on either side
+         */
+        bool inBand(double hue, float margin) const;
+        /**
+         * @brief Update the trigger with a reading, and notify the subscribers if an object arrived
+         */
+        void update(double hue, std::int32_t proximity);
+
+        pros::Optical* sensor;
+        ColorBand band;
+        float hueHysteresis;
+        int proximityHysteresis;
+        std::uint32_t mask = 0;
+        int deviceIndex = -1; // where the sensor is in device snapshots
+        std::array<pros::task_t, MAX_SUBSCRIBERS> subscribers {};
+        int subscriberCount = 0;
+        std::function<void()> callback;
+        std::atomic<bool> active = false;
+        std::atomic<int> count = 0;
+};
+
+/**
+ * @brief Reads optical sensors at the rate they measure at, and updates the triggers watching them
+ *
+ * Each sensor is read once per integration time however many triggers watch it, since reading it faster only returns
+ * the same measurement again. Once odometry is running, the sensors are read in the device snapshot instead. Tasks
+ * that wait on triggers instead of reading the sensors themselves take no CPU until something arrives. Add the poller
+ * to a SubsystemScheduler to run it.
+ */
+class SensorPoller : public Subsystem {
+    public:
+        /**
+         * @brief Most triggers one poller can update, one for each notification bit
+         */
+        static constexpr int MAX_TRIGGERS = 32;
+        /**
+         * @brief SensorPoller constructor
+         *
+         * @param integrationTime how long the optical sensors measure for, in milliseconds, from 3 to 712. Shorter is
+         * faster to notice objects, but less sensitive to dim ones
+         */
+        SensorPoller(double integrationTime = 10);
+        /**
+         * @brief Add a trigger. Triggers can only be added before the scheduler starts
+         *
+         * @param trigger the trigger, which must outlive the poller
+         * @return true if the trigger was added
+         */
+        bool add(ColorTrigger* trigger);
+        /**
+         * @brief Set the integration time of every sensor
+         */
+        void initialize() override;
+        /**
+         * @brief Read every sensor and update the triggers
+         */
+        void periodic() override;
+    private:
+        double integrationTime;
+        std::array<ColorTrigger*, MAX_TRIGGERS> triggers {};
+        int triggerCount = 0;
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include "pros/abstract_motor.hpp"
+#include "subsystem.hpp"
+
+/**
+ * @brief What a stalled mechanism looks like to its motors
+ *
+ * A motor is stalled when it's barely turning, but drawing current or putting out torque, which means it's pushing
+ * against something. A motor that's only stopped because it's told to stop draws neither. Set the current, the torque
+ * or both; a limit of 0 is ignored.
+ */
+struct StallSettings {
+        /** speed the motors have to be slower than, in rpm */
+        float velocity;
+        /** current the motors have to draw more than, in mA. 0 to ignore current */
+        int current;
+        /** torque the motors have to put out more than, in Nm. 0 to ignore torque */
+        float torque;
+        /** how long the motors have to stay stalled before it counts, in milliseconds */
+        std::uint32_t window;
+        /** how long after a stall before another can be detected, in milliseconds. Gives the recovery time to work */
+        std::uint32_t cooldown;
+};
+
+/**
+ * @brief Watches a motor or motor group for stalls, and runs a callback when one is detected
+ *
+ * The readings of a group are averaged, since its motors drive the same mechanism.
+ */
+class StallMonitor {
+    public:
+        /**
+         * @brief StallMonitor constructor
+         *
+         * @param motors the motor or motor group, which must outlive the monitor
+         * @param settings when the motors count as stalled
+         *
+         * @b Example
+         * @code {.cpp}
+         * pros::Motor intakeMotor(10, pros::MotorGearset::blue);
+         * // stalled when turning slower than 20 rpm while drawing over 1.5 A, for 200ms. Check again after 500ms
+         * StallMonitor intakeStall(&intakeMotor, {20, 1500, 0, 200, 500});
+         * @endcode
+         */
+        StallMonitor(pros::AbstractMotor* motors, StallSettings settings);
+        /**
+         * @brief Run a function every time a stall is detected
+         *
+         * It runs on the detector's subsystem scheduler, so it must be quick and never block. Start a recovery that
+         * takes time, like reversing for a moment, by asking whatever owns the mechanism to do it
+         *
+         * @param callback the function
+         */
+        void onStall(std::function<void()> callback);
+        /**
+         * @brief Turn detection on or off. Monitors start enabled
+         */
+        void setEnabled(bool enabled);
+        /**
+         * @brief Whether the motors are stalled now
+         */
+        bool isStalled() const;
+        /**
+         * @brief Get how many stalls have been detected
+         */
+        int getCount() const;
+    private:
+        friend class StallDetector;
+        /**
+         * @brief Update the monitor with a reading, and run the callback if a stall was detected
+         *
+         * @param elapsed time since the last update, in milliseconds
+         */
+        void update(float velocity, float current, float torque, std::uint32_t now, std::uint32_t elapsed);
+
+        pros::AbstractMotor* motors;
+        StallSettings settings;
+        int deviceIndex = -1; // where the first motor is in device snapshots
+        int motorCount = 0;
+        std::function<void()> callback;
+        std::atomic<bool> enabled = true;
+        std::atomic<bool> stalled = false;
+        std::atomic<int> count = 0;
+        std::uint32_t stalledTime = 0; // milliseconds
+        std::uint32_t cooldownEnd = 0;
+};
+
+/**
+ * @brief Checks every registered motor for stalls, on one subsystem instead of a task for each mechanism
+ *
+ * Motors are read in the device snapshot once odometry is running, and directly before then. Add the detector to a
+ * SubsystemScheduler to run it.
+ */
+class StallDetector : public Subsystem {
+    public:
+        /**
+         * @brief Most monitors one detector can check
+         */
+        static constexpr int MAX_MONITORS = 8;
+        /**
+         * @brief StallDetector constructor
+         *
+         * @param period time between checks, in milliseconds
+         */
+        StallDetector(std::uint32_t period = 20);
+        /**
+         * @brief Add a monitor. Monitors can only be added before the scheduler starts
+         *
+         * @param monitor the monitor, which must outlive the detector
+         * @return true if the monitor was added
+         */
+        bool add(StallMonitor* monitor);
+        /**
+         * @brief Read every monitor's motors and update it
+         */
+        void periodic() override;
+    private:
+        std::array<StallMonitor*, MAX_MONITORS> monitors {};
+        int monitorCount = 0;
+};
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "pros/rtos.hpp"
+#include "lemlib/seqlock.hpp"
+
+/**
+ * @brief How a subsystem has been keeping to its period
+ */
+struct SubsystemStats {
+        /** how many times it has run */
+        std::uint32_t runs;
+        /** how many times it took longer than its period, or started after its next run was due */
+        std::uint32_t overruns;
+        /** total time spent running, in microseconds */
+        std::uint32_t runTime;
+        /** longest run, in microseconds */
+        std::uint32_t maxRunTime;
+        /** total time between when runs were due and when they started, in microseconds */
+        std::uint32_t jitter;
+        /** longest time between when a run was due and when it started, in microseconds */
+        std::uint32_t maxJitter;
+};
+
+/**
+ * @brief A part of the robot that runs periodically on a SubsystemScheduler
+ *
+ * Subsystems share the scheduler's task, so periodic() must return quickly and never block. Anything that has to
+ * happen later can go on a TimerWheel.
+ */
+class Subsystem {
+    public:
+        /**
+         * @brief Subsystem constructor
+         *
+         * @param name name used when reporting stats
+         * @param period time between runs, in milliseconds
+         * @param priority subsystems due at the same time run in order of priority, highest first
+         */
+        Subsystem(const char* name, std::uint32_t period, int priority = 0);
+        virtual ~Subsystem() = default;
+        /**
+         * @brief Called once on the scheduler's task when it starts, before the first run
+         */
+        virtual void initialize() {}
+        /**
+         * @brief Called every period on the scheduler's task
+         */
+        virtual void periodic() = 0;
+        /**
+         * @brief Get the name of the subsystem
+         */
+        const char* getName() const;
+        /**
+         * @brief Get the time between runs, in milliseconds
+         */
+        std::uint32_t getPeriod() const;
+        /**
+         * @brief Get how the subsystem has been keeping to its period. Safe to call from any task below the
+         * scheduler's priority
+         */
+        SubsystemStats getStats() const;
+    protected:
+        /**
+         * @brief Change the time between runs, from the next run on
+         */
+        void setPeriod(std::uint32_t period);
+    private:
+        friend class SubsystemScheduler;
+        const char* name;
+        std::uint32_t period;
+        int priority;
+        std::uint64_t due = 0; // when the next run is due, in microseconds
+        SubsystemStats stats {};
+        lemlib::Seqlock<SubsystemStats> publishedStats {SubsystemStats {}};
+};
+
+/**
+ * @brief Runs subsystems at their periods, all on one task
+ *
+ * One task instead of one per subsystem saves a stack for each, and means subsystems never preempt each other part way
+ * through touching shared state. Every run is timed, so the stats show which subsystem is taking time away from the
+ * odometry and motion tasks, and whether each is running when it should.
+ */
+class SubsystemScheduler {
+    public:
+        /**
+         * @brief Most subsystems one scheduler can run
+         */
+        static constexpr int MAX_SUBSYSTEMS = 16;
+        /**
+         * @brief Add a subsystem. Subsystems can only be added before the scheduler starts
+         *
+         * @param subsystem the subsystem, which must outlive the scheduler
+         * @return true if the subsystem was added
+         */
+        bool add(Subsystem* subsystem);
+        /**
+         * @brief Start running the subsystems
+         *
+         * The task runs below odometry and above the default priority, so subsystems run on time however busy the
+         * routine or driver control is
+         */
+        void start();
+        /**
+         * @brief Get how many subsystems have been added
+         */
+        int getCount() const;
+        /**
+         * @brief Get a subsystem, in the order they run in when due at the same time
+         */
+        const Subsystem* getSubsystem(int index) const;
+        /**
+         * @brief Log the stats of every subsystem to the info sink
+         */
+        void logStats() const;
+    private:
+        void loop();
+
+        std::array<Subsystem*, MAX_SUBSYSTEMS> subsystems {};
+        int count = 0;
+        pros::Task* task = nullptr;
+};
+
+/**
+ * @brief Chooses between commands for one actuator from several sources
+ *
+ * Each source requests a value at its own level, and the highest level with a request wins. Only the subsystem that
+ * owns the actuator resolves the commands and moves it, so sources never fight over it. Requests and releases can come
+ * from any task.
+ */
+class CommandArbiter {
+    public:
+        /**
+         * @brief Number of levels
+         */
+        static constexpr int LEVELS = 8;
+        /**
+         * @brief Request a value at a level, replacing any request already there
+         */
+        void request(int level, float value);
+        /**
+         * @brief Withdraw the request at a level
+         */
+        void release(int level);
+        /**
+         * @brief Whether there's a request at a level
+         */
+        bool isActive(int level) const;
+        /**
+         * @brief Get the value requested at the highest level with a request
+         *
+         * @param fallback value if there are no requests
+         */
+        float resolve(float fallback) const;
+    private:
+        std::array<std::atomic<float>, LEVELS> values {};
+        std::atomic<std::uint32_t> active = 0;
+};
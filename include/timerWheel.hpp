@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include "pros/rtos.hpp"
+
+/**
+ * @brief Runs actions at set times from one task, so code can plan things like "reverse the intake in 192ms and
+ * run it forwards again in 472ms" without blocking for them
+ *
+ * Actions are kept in a wheel of one millisecond slots, by the time they're due. The task only looks at the slots
+ * that have come due since it last ran, so scheduling and running an action doesn't depend on how many are waiting.
+ * Actions further away than a turn of the wheel wait in their slot until it comes round to them. Between passes, the
+ * task sleeps until the next action is due.
+ *
+ * Actions run on the wheel's task, one after another, so they should be quick and never block.
+ */
+class TimerWheel {
+    public:
+        /**
+         * @brief Number of slots in the wheel, each a millisecond
+         */
+        static constexpr int SLOTS = 256;
+        /**
+         * @brief Most actions that can be waiting at once
+         */
+        static constexpr int MAX_ACTIONS = 32;
+        /**
+         * @brief TimerWheel constructor
+         */
+        TimerWheel();
+        /**
+         * @brief Schedule an action to run after a delay
+         *
+         * @param delay how long from now to run it, in milliseconds
+         * @param action the action. Captures larger than a couple of pointers allocate
+         * @return true if it was scheduled, false if MAX_ACTIONS are already waiting
+         */
+        bool schedule(std::uint32_t delay, std::function<void()> action);
+        /**
+         * @brief Schedule an action to run at a time
+         *
+         * @param time when to run it, in milliseconds since the program started like pros::millis(). A time that's
+         * already passed runs as soon as possible
+         * @param action the action
+         * @return true if it was scheduled, false if MAX_ACTIONS are already waiting
+         */
+        bool scheduleAt(std::uint32_t time, std::function<void()> action);
+        /**
+         * @brief Get how many actions are waiting to run
+         */
+        int getPending();
+        /**
+         * @brief Start the task that runs the actions
+         *
+         * Actions can be scheduled before it starts, and run once it does.
+         */
+        void start();
+    private:
+        struct Entry {
+                std::uint32_t due;
+                std::function<void()> action;
+                int next; // index of the next entry in the same slot or the free list, -1 for none
+        };
+
+        void loop();
+
+        pros::Mutex mutex;
+        std::array<Entry, MAX_ACTIONS> entries {};
+        std::array<int, SLOTS> slots; // index of the first entry in each slot, -1 for none
+        int freeList = 0;
+        int pending = 0;
+        std::uint32_t tick = 0; // the first slot the task hasn't looked at yet
+        pros::Task* task = nullptr;
+};
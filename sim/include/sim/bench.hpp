@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include "lemlib/chassis/chassis.hpp"
+#include "subsystem.hpp"
+
+namespace sim {
+/**
+ * @brief Start recording the timing of every motion the chassis runs
+ */
+void recordMotions(lemlib::Chassis& chassis);
+
+/**
+ * @brief Print a table of the recorded motions, followed by totals for the routine
+ *
+ * @param out where to print
+ * @param routine name of the routine that ran
+ * @param elapsed how long the routine took, in milliseconds
+ */
+void printMotions(std::FILE* out, const char* routine, std::uint32_t elapsed);
+
+/**
+ * @brief Print how long each subsystem took to run, and how late it started, in simulated time
+ *
+ * @param out where to print
+ * @param scheduler the scheduler running the subsystems
+ */
+void printSubsystems(std::FILE* out, const SubsystemScheduler& scheduler);
+
+/**
+ * @brief Print how long each profiled task ran for, how late it woke up, and how often it was preempted
+ *
+ * @param out where to print
+ */
+void printTasks(std::FILE* out);
+} // namespace sim
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+namespace sim {
+/**
+ * @brief Virtual time charged for every kernel call, in microseconds
+ */
+constexpr std::uint32_t KERNEL_CALL_COST = 1;
+
+/**
+ * @brief Get the kernel time
+ *
+ * Time is simulated, so this has nothing to do with the wall clock.
+ *
+ * @return microseconds since the program started
+ */
+std::uint64_t now();
+
+/**
+ * @brief Charge the calling task for time spent running
+ *
+ * Crossing a tick boundary runs the scheduler, so this is where a task that never blocks gets preempted.
+ *
+ * @param micros how long the work took, in microseconds
+ */
+void charge(std::uint32_t micros);
+
+/**
+ * @brief Keeps the calling task from being preempted as a spinning task while it's alive
+ *
+ * A task that stops making kernel calls is assumed to be spinning, and is preempted at its next kernel call as if it
+ * had run until a tick for each slice it spun through. Code that runs for a long time without making kernel calls,
+ * and shouldn't be moved along in time for it, must hold one of these.
+ */
+class PreemptGuard {
+    public:
+        PreemptGuard();
+        PreemptGuard(const PreemptGuard&) = delete;
+        PreemptGuard& operator=(const PreemptGuard&) = delete;
+        ~PreemptGuard();
+};
+} // namespace sim
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include "lemlib/chassis/chassis.hpp"
+
+namespace sim {
+/**
+ * @brief Which of the chassis controllers to tune
+ */
+enum class TuneController { LATERAL, ANGULAR };
+
+/**
+ * @brief Settings for the gain search
+ */
+struct TuneOptions {
+        /** the controller to tune, the other one keeps the gains it was given */
+        TuneController controller = TuneController::LATERAL;
+        /** largest overshoot allowed on any step, in inches or degrees */
+        float maxOvershoot = 1;
+        /** number of random candidates to start the search with */
+        int samples = 32;
+        /** maximum number of refinement rounds after the random candidates */
+        int iterations = 40;
+        /** seed for the random candidates. The same seed always gives the same result */
+        std::uint32_t seed = 1;
+        /** number of candidates to evaluate at once, 0 for one per host core */
+        int jobs = 0;
+        /** where to report progress, nullptr for nowhere */
+        std::FILE* log = stderr;
+};
+
+/**
+ * @brief How a set of gains did on the step tests
+ */
+struct TuneScore {
+        /** settle time plus penalties, in milliseconds. Lower is better */
+        float cost;
+        /** sum of the settle times of every step, in milliseconds */
+        float settleTime;
+        /** worst overshoot of any step, in inches or degrees */
+        float overshoot;
+        /** number of steps that never settled within the small error range */
+        int unsettled;
+};
+
+/**
+ * @brief The best gains found by the search
+ */
+struct TuneResult {
+        lemlib::ControllerSettings settings;
+        TuneScore score;
+        /** score of the gains the search started from */
+        TuneScore initial;
+        /** number of candidates evaluated */
+        int evaluations;
+};
+
+/**
+ * @brief Search for the kP, kI, kD and windup range that settle fastest without overshooting too far
+ *
+ * Every candidate drives a fresh chassis through a series of step responses: forward and back drives of 6 to 48
+ * inches for the lateral controller, and turns of 15 to 180 degrees for the angular one. Each evaluation runs in its
+ * own forked process, so must be called before any tasks are created, and candidates are evaluated as many at a time
+ * as there are jobs. The candidates only depend on the seed and results are combined in a fixed order, so the result
+ * doesn't depend on the number of jobs.
+ *
+ * @param drivetrain the drivetrain to tune on
+ * @param lateral the lateral controller settings
+ * @param angular the angular controller settings
+ * @param sensors the odometry sensors
+ * @param options settings for the search
+ * @return the best gains, with the rest of the settings copied from the controller being tuned
+ */
+TuneResult tune(const lemlib::Drivetrain& drivetrain, const lemlib::ControllerSettings& lateral,
+                const lemlib::ControllerSettings& angular, const lemlib::OdomSensors& sensors,
+                const TuneOptions& options);
+} // namespace sim
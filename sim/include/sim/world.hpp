@@ -0,0 +1,316 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "sim/kernel.hpp"
+
+namespace sim {
+/**
+ * @brief Number of V5 smart ports, port numbers are 1-indexed
+ */
+constexpr int PORT_COUNT = 21;
+
+/**
+ * @brief Number of ADI ports on the brain, 'A' through 'H'
+ */
+constexpr int ADI_PORT_COUNT = 8;
+
+/**
+ * @brief Virtual time charged for every device call, in microseconds
+ */
+constexpr std::uint32_t DEVICE_CALL_COST = 10;
+
+/**
+ * @brief Physical description of the simulated robot
+ *
+ * The defaults describe the robot in src/main.cpp. Motor ports are the physical port numbers, and the mount sign
+ * says which way the wheel turns when the motor spins forwards. The left side is mounted mirrored, which is why the
+ * program reverses those ports.
+ */
+struct RobotConfig {
+        /** physical ports of the left drive motors */
+        std::vector<int> leftPorts = {7, 18, 16};
+        /** physical ports of the right drive motors */
+        std::vector<int> rightPorts = {19, 12, 13};
+        /** -1 if the left motors drive the robot backwards when spun forwards */
+        int leftMount = -1;
+        /** -1 if the right motors drive the robot backwards when spun forwards */
+        int rightMount = 1;
+        /** distance between the left and right wheels, in inches */
+        double trackWidth = 10;
+        /** diameter of the drive wheels, in inches */
+        double wheelDiameter = 4;
+        /** rpm of the drive wheels at full motor speed */
+        double wheelRpm = 360;
+        /** free speed of the drive motor cartridge, in rpm */
+        double motorRpm = 600;
+        /** time constant of the drive velocity response, in seconds */
+        double driveTau = 0.12;
+        /** maximum acceleration of a drive side before the wheels slip, in inches per second squared */
+        double tractionLimit = 250;
+        /** acceleration of a drive side while its wheels slip, in inches per second squared. Wheels that have broken
+         * traction grip less than ones that haven't */
+        double slipTraction = 200;
+        /** inertia of a drive side's wheels and motors, as a fraction of the robot's share of the side. This is how
+         * fast wheels that have broken traction spin up */
+        double wheelInertia = 0.1;
+        /** time constant of a coasting drive side, in seconds */
+        double coastTau = 0.6;
+        /** time constant of a braking drive side, in seconds */
+        double brakeTau = 0.05;
+        /** port of the inertial sensor */
+        int imuPort = 21;
+        /** time the inertial sensor takes to calibrate, in milliseconds */
+        std::uint32_t imuCalibrationTime = 2000;
+        /** port of the rotation sensor used as a tracking wheel */
+        int trackingPort = 8;
+        /** diameter of the tracking wheel, in inches */
+        double trackingDiameter = 2.75;
+        /** lateral offset of the tracking wheel, in inches. Negative is left of the tracking center */
+        double trackingOffset = -1;
+        /** port of the optical sensor used for color sorting */
+        int opticalPort = 9;
+        /** port of the GPS sensor, 0 for none. The robot in src/main.cpp doesn't have one */
+        int gpsPort = 0;
+        /** standard deviation of the noise on GPS positions, in meters */
+        double gpsNoise = 0.01;
+        /** standard deviation of the noise on GPS headings, in degrees */
+        double gpsHeadingNoise = 0.5;
+        /** ports of motors that are not on the drivetrain, such as the intake */
+        std::vector<int> freeMotorPorts = {10};
+        /** time constant of any motor not on the drivetrain, in seconds */
+        double freeMotorTau = 0.05;
+        /** voltage of the battery with nothing drawing from it, in millivolts */
+        double batteryVoltage = 12800;
+        /** resistance of the battery and its wiring, in ohms. The battery sags by this times the current drawn */
+        double batteryResistance = 0.1;
+        /** how much the resistance of a motor's windings rises per degree, as a fraction of it at 25 degrees. A hot
+         * motor has less torque for the same voltage */
+        double windingTempco = 0.00393;
+        /** temperature of every motor when the program starts, in degrees celsius */
+        double motorTemperature = 25;
+};
+
+/**
+ * @brief Control mode of a simulated smart motor, matching the move_* functions of the PROS API
+ */
+enum class MotorMode { VOLTAGE, VELOCITY, POSITION };
+
+/**
+ * @brief State of a simulated smart motor
+ *
+ * Positions and velocities are stored in the motor's own frame (before the program's reversal is applied), in
+ * degrees and rpm at the output shaft.
+ */
+struct MotorState {
+        MotorMode mode = MotorMode::VOLTAGE;
+        std::int32_t targetVoltage = 0; // mV
+        std::int32_t targetVelocity = 0; // rpm
+        double targetPosition = 0; // degrees
+        std::int32_t voltage = 0; // applied voltage, mV
+        std::int32_t brakeMode = 0;
+        std::int32_t encoderUnits = 0;
+        std::int32_t gearset = 1;
+        bool reversed = false;
+        std::int32_t currentLimit = 2500;
+        std::int32_t voltageLimit = 0;
+        double position = 0; // shaft position, degrees
+        double zero = 0; // position that reads as zero, degrees
+        double velocity = 0; // shaft velocity, rpm
+        double current = 0; // mA
+        double temperature = 25; // degrees celsius
+        double torque = 0; // Nm
+        int jam = 0; // direction something is stopping the motor from turning, 0 if nothing is
+};
+
+/**
+ * @brief State of a simulated inertial sensor
+ */
+struct ImuState {
+        std::uint64_t calibrationEnd = 0; // time calibration finishes, microseconds
+        bool calibrated = false;
+        double rotationOffset = 0; // degrees added to the true heading
+        std::uint32_t dataRate = 10;
+};
+
+/**
+ * @brief State of a simulated rotation sensor
+ */
+struct RotationState {
+        bool reversed = false;
+        double offset = 0; // centidegrees subtracted from the raw position
+        std::uint32_t dataRate = 10;
+};
+
+/**
+ * @brief State of a simulated GPS sensor
+ */
+struct GpsState {
+        double offsetX = 0; // meters
+        double offsetY = 0; // meters
+        std::uint32_t dataRate = 10;
+};
+
+/**
+ * @brief State of a simulated optical sensor
+ */
+struct OpticalState {
+        double hue = 0;
+        double saturation = 0;
+        double brightness = 0;
+        std::int32_t proximity = 0;
+        std::int32_t ledPwm = 0;
+        double integrationTime = 100;
+};
+
+/**
+ * @brief State of a simulated ADI port
+ */
+struct AdiState {
+        std::int32_t config = 255; // E_ADI_TYPE_UNDEFINED
+        std::int32_t value = 0;
+};
+
+/**
+ * @brief The simulated robot and everything plugged into it
+ *
+ * Physics is integrated lazily: every device access calls advance(), which steps the model in fixed 1ms increments up
+ * to the current kernel time. All access goes through lock(), which charges the calling task for a device call.
+ */
+class World {
+    public:
+        World();
+
+        /**
+         * @brief Guard for an access to the world, see lock()
+         */
+        class Lock {
+            public:
+                explicit Lock(World& world);
+                Lock(const Lock&) = delete;
+                Lock& operator=(const Lock&) = delete;
+                ~Lock();
+            private:
+                PreemptGuard guard;
+                World& world;
+        };
+
+        /**
+         * @brief Access the world for the duration of the returned guard
+         *
+         * The kernel only switches tasks inside kernel calls, so no mutex is needed. The outermost access is charged
+         * as a device call before anything is touched, which is where a task that never blocks gets preempted.
+         */
+        [[nodiscard]] Lock lock();
+
+        /**
+         * @brief Integrate the physics model up to the current kernel time
+         */
+        void advance();
+
+        /**
+         * @brief Get how many device calls have been made, counting each outermost access once
+         */
+        std::uint64_t getDeviceCalls() const;
+
+        /**
+         * @brief Replace the robot description. Only valid before the program starts
+         */
+        void configure(const RobotConfig& config);
+
+        const RobotConfig& getConfig() const;
+
+        /**
+         * @brief Get the true pose of the robot
+         *
+         * @return x and y in inches, theta in degrees, measured clockwise from the +y axis
+         */
+        std::array<double, 3> truePose();
+
+        /**
+         * @brief Teleport the robot. Heading is in degrees, measured clockwise from the +y axis
+         */
+        void setTruePose(double x, double y, double theta);
+
+        MotorState& motor(int port);
+        ImuState& imu(int port);
+        RotationState& rotation(int port);
+        OpticalState& optical(int port);
+        GpsState& gps(int port);
+        AdiState& adi(int port);
+
+        /**
+         * @brief Get the type of device plugged into a port, using the values of pros::DeviceType
+         */
+        int pluggedType(int port) const;
+
+        /**
+         * @brief Heading of the robot as seen by an inertial sensor, in degrees, unbounded
+         */
+        double imuRotation();
+
+        /**
+         * @brief Raw position of the tracking wheel rotation sensor, in centidegrees
+         */
+        double trackingPosition();
+
+        /**
+         * @brief Raw velocity of the tracking wheel rotation sensor, in centidegrees per second
+         */
+        double trackingVelocity();
+
+        /**
+         * @brief Voltage at the battery terminals, after sagging under the current the motors draw, in millivolts
+         */
+        double batteryVoltage() const;
+
+        /**
+         * @brief Lowest the battery voltage has been, in millivolts
+         */
+        double minBatteryVoltage() const;
+
+        /**
+         * @brief How long either side's wheels have been slipping, in seconds
+         */
+        double slipTime() const;
+    private:
+        void step(double dt);
+        void stepSide(const std::vector<int>& ports, int mount, double& velocity, double& wheelVelocity, double dt);
+        void stepFreeMotor(MotorState& motor, double dt);
+
+        int depth = 0; // nesting of lock()
+        std::uint64_t deviceCalls = 0;
+        RobotConfig config;
+        std::uint64_t lastTime = 0; // microseconds
+
+        double x = 0;
+        double y = 0;
+        double theta = 0; // radians, clockwise from +y
+        double leftVelocity = 0; // inches per second
+        double rightVelocity = 0; // inches per second
+        double leftWheelVelocity = 0; // surface speed of the wheels, inches per second. Differs while they slip
+        double rightWheelVelocity = 0; // inches per second
+        double omega = 0; // radians per second, clockwise
+        double leftDistance = 0; // inches
+        double rightDistance = 0; // inches
+        double trackingDistance = 0; // inches
+        double trackingSpeed = 0; // inches per second
+        double battery = 0; // terminal voltage, millivolts
+        double minBattery = 0; // millivolts
+        double slipping = 0; // seconds
+
+        std::array<MotorState, PORT_COUNT> motors {};
+        std::array<ImuState, PORT_COUNT> imus {};
+        std::array<RotationState, PORT_COUNT> rotations {};
+        std::array<OpticalState, PORT_COUNT> opticals {};
+        std::array<GpsState, PORT_COUNT> gpses {};
+        std::array<AdiState, ADI_PORT_COUNT> adiPorts {};
+        std::array<int, PORT_COUNT> pluggedTypes {};
+};
+
+/**
+ * @brief Get the simulated world
+ */
+World& world();
+} // namespace sim
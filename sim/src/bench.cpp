@@ -0,0 +1,62 @@
+#include <vector>
+#include "lemlib/profiler.hpp"
+#include "sim/bench.hpp"
+
+namespace sim {
+namespace {
+std::vector<lemlib::MotionRecord> records;
+} // namespace
+
+void recordMotions(lemlib::Chassis& chassis) {
+    // the kernel runs one task at a time, so motions can't finish at the same time
+    chassis.setMotionRecorder([](const lemlib::MotionRecord& record) { records.push_back(record); });
+}
+
+void printMotions(std::FILE* out, const char* routine, std::uint32_t elapsed) {
+    std::fprintf(out, "%s\n", routine);
+    std::fprintf(out, "  #  motion          start  elapsed  driving   settle  small  large  timeout  settled\n");
+    int motionTime = 0;
+    int settleTime = 0;
+    int timeouts = 0;
+    int settled = 0;
+    for (std::size_t i = 0; i < records.size(); i++) {
+        const lemlib::MotionRecord& record = records[i];
+        // time spent before getting close to the target is time spent driving
+        const int settle = record.settleTime == -1 ? 0 : record.settleTime;
+        std::fprintf(out, "%3zu  %-14s %6.2f %8d %8d %8d %6d %6d  %-7s  %s\n", i + 1, record.motion,
+                     record.startTime / 1000.0, record.elapsed, record.elapsed - settle, record.settleTime,
+                     record.smallExitTime, record.largeExitTime, record.timedOut ? "yes" : "",
+                     record.settled ? "yes" : "");
+        motionTime += record.elapsed;
+        settleTime += settle;
+        timeouts += record.timedOut;
+        settled += record.settled;
+    }
+    std::fprintf(out, "  %zu motions, %.2f s in motions of %.2f s total, %.2f s settling, %d timed out, %d settled\n",
+                 records.size(), motionTime / 1000.0, elapsed / 1000.0, settleTime / 1000.0, timeouts, settled);
+}
+
+void printSubsystems(std::FILE* out, const SubsystemScheduler& scheduler) {
+    std::fprintf(out, "  subsystem        period   runs  mean run  max run  mean late  max late  overruns\n");
+    for (int i = 0; i < scheduler.getCount(); i++) {
+        const Subsystem* subsystem = scheduler.getSubsystem(i);
+        const SubsystemStats stats = subsystem->getStats();
+        const std::uint32_t runs = stats.runs == 0 ? 1 : stats.runs;
+        std::fprintf(out, "  %-15s %4u ms %6u %6u us %5u us %6u us %6u us %9u\n", subsystem->getName(),
+                     subsystem->getPeriod(), stats.runs, stats.runTime / runs, stats.maxRunTime, stats.jitter / runs,
+                     stats.maxJitter, stats.overruns);
+    }
+}
+
+void printTasks(std::FILE* out) {
+    std::fprintf(out, "  task             priority  wakes  mean run  max run  mean late  max late  max period  preempted\n");
+    for (int i = 0; i < lemlib::profiler::getTaskCount(); i++) {
+        const lemlib::profiler::TaskStats stats = lemlib::profiler::getStats(i);
+        const std::uint32_t wakes = stats.wakes == 0 ? 1 : stats.wakes;
+        std::fprintf(out, "  %-16s %8u %6u %6llu us %5u us %6llu us %6u us %8u us %9u\n", stats.name, stats.priority,
+                     stats.wakes, static_cast<unsigned long long>(stats.runTime / wakes), stats.maxRunTime,
+                     static_cast<unsigned long long>(stats.latency / wakes), stats.maxLatency, stats.maxPeriod,
+                     stats.preemptions);
+    }
+}
+} // namespace sim
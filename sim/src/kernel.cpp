@@ -0,0 +1,607 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "pros/rtos.h"
+#include "sim/kernel.hpp"
+
+namespace sim {
+namespace {
+constexpr std::uint64_t NEVER = UINT64_MAX;
+
+/**
+ * @brief Time a task may hold the CPU without calling into the kernel, in nanoseconds
+ *
+ * A task that makes no kernel calls for two of these in a row is spinning, like a while (true) loop that only reads
+ * globals. The V5 tick interrupt would preempt it. A signal handler can't safely block a task that might be holding a
+ * libc lock, so the signal only counts the slices it spins through, and the kernel preempts it at its next kernel call.
+ */
+constexpr long SLICE = 100000;
+
+/**
+ * @brief Slices a task can spin through before the simulation gives up on it, 10 seconds
+ *
+ * A task that never makes a kernel call can't be preempted, so nothing else will ever run.
+ */
+constexpr int STUCK_SLICES = 100000;
+
+/**
+ * @brief What a blocked task is waiting for
+ */
+enum class Wait { NONE, DELAY, NOTIFY, MUTEX, JOIN };
+
+/**
+ * @brief Task control block
+ *
+ * Every task runs on its own host thread, but only the task holding the baton (Kernel::running) ever executes. The
+ * others wait on their condition variable until the scheduler hands the baton over. A deleted task is never scheduled
+ * again, which parks its thread.
+ */
+struct Tcb {
+        std::string name;
+        std::uint32_t priority;
+        pros::task_state_e_t state = pros::E_TASK_STATE_READY;
+        std::uint32_t notifyValue = 0;
+        bool notified = false;
+        Wait wait = Wait::NONE;
+        void* waitObject = nullptr;
+        std::uint64_t wakeTime = NEVER; // microseconds
+        bool timedOut = false;
+        std::uint64_t sequence = 0; // orders tasks of equal priority, first come first served
+        // set by kernel calls and cleared by the slice signal, to tell a spinning task from a busy one
+        std::atomic<bool> called = false;
+        std::atomic<int> idleSlices = 0; // slices spun through since the last kernel call
+        bool spinning = false; // preempted while spinning, see spin()
+        std::uint64_t spunAt = 0; // value of Kernel::switches when it was preempted
+        timer_t slice;
+        std::condition_variable cv;
+};
+
+/**
+ * @brief A mutex that knows which task holds it, so recursive mutexes can be taken again by their owner
+ */
+struct KernelMutex {
+        Tcb* owner = nullptr;
+        std::uint32_t depth = 0;
+        bool recursive;
+};
+
+/**
+ * @brief Scheduler state
+ *
+ * Time is virtual: it only moves when the running task is charged for a call, or when every task is blocked and the
+ * clock jumps to the next wake up. Only one task runs at a time and every decision depends on nothing but this state,
+ * so a run is reproducible down to the microsecond.
+ */
+struct Kernel {
+        std::mutex mutex;
+        std::uint64_t time = 0; // microseconds
+        std::uint64_t sequence = 0;
+        std::uint64_t switches = 0; // number of times the baton changed hands
+        Tcb* running = nullptr;
+        std::vector<Tcb*> tasks;
+};
+
+thread_local Tcb* currentTcb = nullptr;
+thread_local std::atomic<int> preemptDisabled = 0;
+
+void onSliceExpired(int);
+
+// a function local static, since devices are touched by the program's global constructors
+Kernel& kernel() {
+    static Kernel* kernel = [] {
+        struct sigaction action {};
+        action.sa_handler = onSliceExpired;
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGRTMIN, &action, nullptr);
+        return new Kernel;
+    }();
+    return *kernel;
+}
+
+/**
+ * @brief Holds the kernel mutex, and keeps the task from being counted as spinning while it does
+ */
+class Lock : private PreemptGuard,
+             public std::unique_lock<std::mutex> {
+    public:
+        explicit Lock(std::mutex& mutex)
+            : std::unique_lock<std::mutex>(mutex) {}
+};
+
+/**
+ * @brief Create the slice timer of the calling thread
+ */
+void createSlice(Tcb* tcb) {
+    sigevent event {};
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = SIGRTMIN;
+    event._sigev_un._tid = gettid();
+    timer_create(CLOCK_MONOTONIC, &event, &tcb->slice);
+}
+
+/**
+ * @brief Run the slice timer while a task holds the baton, and stop it while it waits
+ */
+void setSlice(Tcb* tcb, bool running) {
+    const long period = running ? SLICE : 0;
+    const itimerspec spec {{0, period}, {0, period}};
+    timer_settime(tcb->slice, 0, &spec, nullptr);
+}
+
+void spin(Tcb* current, int slices, Lock& lock);
+
+Tcb* self(Lock& lock) {
+    if (currentTcb == nullptr) {
+        Kernel& k = kernel();
+        if (k.running != nullptr) {
+            std::fprintf(stderr, "sim: kernel called from a thread that isn't a task\n");
+            _exit(1);
+        }
+        // adopt the host thread as the first task
+        currentTcb = new Tcb {.name = "main", .priority = TASK_PRIORITY_DEFAULT};
+        currentTcb->state = pros::E_TASK_STATE_RUNNING;
+        k.tasks.push_back(currentTcb);
+        k.running = currentTcb;
+        createSlice(currentTcb);
+        setSlice(currentTcb, true);
+    }
+    // a kernel call is where a task that's been spinning can be preempted safely
+    Tcb* current = currentTcb;
+    const int idleSlices = current->idleSlices.exchange(0, std::memory_order_relaxed);
+    current->called.store(true, std::memory_order_relaxed);
+    if (idleSlices > 0) spin(current, idleSlices, lock);
+    current->spinning = false;
+    return current;
+}
+
+Tcb* resolve(pros::task_t task, Lock& lock) { return task == nullptr ? self(lock) : static_cast<Tcb*>(task); }
+
+/**
+ * @brief Round a wake up to a tick boundary, like the FreeRTOS delay list
+ */
+std::uint64_t tickAfter(std::uint64_t time, std::uint32_t milliseconds) {
+    if (milliseconds == TIMEOUT_MAX) return NEVER;
+    return (time / 1000 + milliseconds) * 1000;
+}
+
+void makeReady(Tcb* tcb) {
+    tcb->state = pros::E_TASK_STATE_READY;
+    tcb->wait = Wait::NONE;
+    tcb->waitObject = nullptr;
+    tcb->wakeTime = NEVER;
+    tcb->sequence = ++kernel().sequence;
+}
+
+/**
+ * @brief Wake every task whose delay or timeout has expired
+ */
+void wakeDue() {
+    Kernel& k = kernel();
+    for (Tcb* tcb : k.tasks) {
+        if (tcb->state == pros::E_TASK_STATE_BLOCKED && tcb->wakeTime <= k.time) {
+            tcb->timedOut = true;
+            makeReady(tcb);
+        }
+    }
+}
+
+/**
+ * @brief Pick the highest priority task matching a filter, the one that's waited longest among equals
+ */
+template <typename F> Tcb* highest(F&& filter) {
+    Tcb* best = nullptr;
+    for (Tcb* tcb : kernel().tasks) {
+        if (!filter(tcb)) continue;
+        if (best == nullptr || tcb->priority > best->priority ||
+            (tcb->priority == best->priority && tcb->sequence < best->sequence))
+            best = tcb;
+    }
+    return best;
+}
+
+/**
+ * @brief Pick the task to run next
+ *
+ * A task preempted while spinning only gets the CPU back after another task has run, since until then there's
+ * nothing new for it to see.
+ */
+Tcb* pickNext() {
+    return highest([](Tcb* tcb) {
+        if (tcb->spinning && tcb->spunAt == kernel().switches) return false;
+        return tcb->state == pros::E_TASK_STATE_READY || tcb->state == pros::E_TASK_STATE_RUNNING;
+    });
+}
+
+/**
+ * @brief Hand the baton to the next task, and wait until it's handed back
+ *
+ * If nothing is ready the clock jumps to the earliest wake up. Returns immediately if the caller was deleted, so its
+ * thread can finish or park.
+ */
+void reschedule(Tcb* current, Lock& lock) {
+    Kernel& k = kernel();
+    Tcb* next;
+    while ((next = pickNext()) == nullptr) {
+        std::uint64_t wake = NEVER;
+        for (Tcb* tcb : k.tasks) {
+            if (tcb->state == pros::E_TASK_STATE_BLOCKED) wake = std::min(wake, tcb->wakeTime);
+        }
+        if (wake == NEVER) {
+            // a spinning task is still better than nothing, let it carry on if it's all that's left
+            next = highest([](Tcb* tcb) {
+                return tcb->state == pros::E_TASK_STATE_READY || tcb->state == pros::E_TASK_STATE_RUNNING;
+            });
+            if (next != nullptr) break;
+            std::fflush(stdout);
+            std::fprintf(stderr, "sim: no task can make progress at %.3f s\n", k.time / 1e6);
+            _exit(1);
+        }
+        k.time = std::max(k.time, wake);
+        wakeDue();
+    }
+    next->state = pros::E_TASK_STATE_RUNNING;
+    if (next == current) return;
+    k.running = next;
+    k.switches++;
+    next->cv.notify_one();
+    setSlice(current, false);
+    if (current->state == pros::E_TASK_STATE_DELETED) return;
+    current->cv.wait(lock, [&] { return k.running == current; });
+    setSlice(current, true);
+}
+
+/**
+ * @brief Let other ready tasks of the same priority run, round robin
+ */
+void yield(Tcb* current, Lock& lock) {
+    makeReady(current);
+    reschedule(current, lock);
+}
+
+/**
+ * @brief Switch away if a task made ready by the caller outranks it
+ */
+void preemptCheck(Tcb* current, Lock& lock) {
+    if (pickNext()->priority > current->priority) {
+        current->state = pros::E_TASK_STATE_READY;
+        reschedule(current, lock);
+    }
+}
+
+/**
+ * @brief Block the caller until it's made ready again or the wake up time passes
+ *
+ * @return false if it timed out
+ */
+bool block(Tcb* current, Wait wait, void* object, std::uint64_t wakeTime, Lock& lock) {
+    current->state = pros::E_TASK_STATE_BLOCKED;
+    current->wait = wait;
+    current->waitObject = object;
+    current->wakeTime = wakeTime;
+    current->timedOut = false;
+    current->sequence = ++kernel().sequence;
+    reschedule(current, lock);
+    return !current->timedOut;
+}
+
+/**
+ * @brief Wake the task that should get an object next, if any are blocked on it
+ */
+Tcb* wakeWaiter(Wait wait, void* object) {
+    Tcb* waiter = highest([&](Tcb* tcb) {
+        return tcb->state == pros::E_TASK_STATE_BLOCKED && tcb->wait == wait && tcb->waitObject == object;
+    });
+    if (waiter != nullptr) makeReady(waiter);
+    return waiter;
+}
+
+/**
+ * @brief Mark a task deleted and release the tasks joining it
+ */
+void retire(Tcb* tcb) {
+    tcb->state = pros::E_TASK_STATE_DELETED;
+    while (wakeWaiter(Wait::JOIN, tcb) != nullptr);
+}
+
+[[noreturn]] void park(Tcb* current, Lock& lock) {
+    while (true) current->cv.wait(lock);
+}
+
+/**
+ * @brief Advance the clock for the running task, and run the tick if one was crossed
+ */
+void chargeTask(Tcb* current, std::uint32_t micros, Lock& lock) {
+    Kernel& k = kernel();
+    const std::uint64_t tick = k.time / 1000;
+    k.time += micros;
+    if (k.time / 1000 == tick) return;
+    wakeDue();
+    yield(current, lock);
+}
+
+/**
+ * @brief Preempt a task that's been spinning, as if it ran until a tick for each slice it spun through
+ */
+void spin(Tcb* current, int slices, Lock& lock) {
+    Kernel& k = kernel();
+    k.time = (k.time / 1000 + slices) * 1000;
+    wakeDue();
+    makeReady(current);
+    current->spinning = true;
+    current->spunAt = k.switches;
+    reschedule(current, lock);
+}
+
+// only touches atomics, and write and _exit, which are async-signal-safe
+void onSliceExpired(int) {
+    Tcb* tcb = currentTcb;
+    if (tcb == nullptr || preemptDisabled.load(std::memory_order_relaxed) > 0) return;
+    if (tcb->called.exchange(false, std::memory_order_relaxed)) return;
+    if (tcb->idleSlices.fetch_add(1, std::memory_order_relaxed) + 1 < STUCK_SLICES) return;
+    // nothing else will ever run, so give up
+    for (const char* part : {"sim: task \"", tcb->name.c_str(), "\" spun for 10 s without a kernel call\n"}) {
+        if (write(STDERR_FILENO, part, std::strlen(part)) < 0) break;
+    }
+    _exit(1);
+}
+
+bool takeMutex(KernelMutex* mutex, std::uint32_t timeout) {
+    Lock lock(kernel().mutex);
+    Tcb* current = self(lock);
+    chargeTask(current, KERNEL_CALL_COST, lock);
+    if (mutex->owner == current && mutex->recursive) {
+        mutex->depth++;
+        return true;
+    }
+    if (mutex->owner == nullptr) {
+        mutex->owner = current;
+        mutex->depth = 1;
+        return true;
+    }
+    if (timeout == 0) return false;
+    // giveMutex hands ownership over before waking the waiter
+    return block(current, Wait::MUTEX, mutex, tickAfter(kernel().time, timeout), lock);
+}
+
+bool giveMutex(KernelMutex* mutex) {
+    Lock lock(kernel().mutex);
+    Tcb* current = self(lock);
+    chargeTask(current, KERNEL_CALL_COST, lock);
+    if (mutex->owner != current) return false;
+    if (--mutex->depth > 0) return true;
+    mutex->owner = wakeWaiter(Wait::MUTEX, mutex);
+    if (mutex->owner != nullptr) {
+        mutex->depth = 1;
+        preemptCheck(current, lock);
+    }
+    return true;
+}
+} // namespace
+
+std::uint64_t now() {
+    Lock lock(kernel().mutex);
+    return kernel().time;
+}
+
+void charge(std::uint32_t micros) {
+    Lock lock(kernel().mutex);
+    chargeTask(self(lock), micros, lock);
+}
+
+PreemptGuard::PreemptGuard() { preemptDisabled++; }
+
+PreemptGuard::~PreemptGuard() { preemptDisabled--; }
+} // namespace sim
+
+namespace pros::c {
+using sim::Lock;
+using sim::Tcb;
+
+uint32_t millis(void) {
+    Lock lock(sim::kernel().mutex);
+    sim::chargeTask(sim::self(lock), sim::KERNEL_CALL_COST, lock);
+    return sim::kernel().time / 1000;
+}
+
+uint64_t micros(void) {
+    Lock lock(sim::kernel().mutex);
+    sim::chargeTask(sim::self(lock), sim::KERNEL_CALL_COST, lock);
+    return sim::kernel().time;
+}
+
+task_t task_create(task_fn_t function, void* const parameters, uint32_t prio, const uint16_t stack_depth,
+                   const char* const name) {
+    Lock lock(sim::kernel().mutex);
+    Tcb* current = sim::self(lock);
+    Tcb* tcb = new Tcb {.name = name == nullptr ? "" : name, .priority = prio};
+    sim::makeReady(tcb);
+    sim::kernel().tasks.push_back(tcb);
+    std::thread([tcb, function, parameters] {
+        sim::currentTcb = tcb;
+        sim::createSlice(tcb);
+        {
+            Lock lock(sim::kernel().mutex);
+            tcb->cv.wait(lock, [tcb] { return sim::kernel().running == tcb; });
+            sim::setSlice(tcb, true);
+        }
+        function(parameters);
+        Lock lock(sim::kernel().mutex);
+        sim::retire(tcb);
+        sim::reschedule(tcb, lock);
+    }).detach();
+    sim::preemptCheck(current, lock);
+    return tcb;
+}
+
+void task_delete(task_t task) {
+    Lock lock(sim::kernel().mutex);
+    Tcb* current = sim::self(lock);
+    Tcb* tcb = sim::resolve(task, lock);
+    if (tcb->state == E_TASK_STATE_DELETED) return;
+    sim::retire(tcb);
+    if (tcb == current) {
+        sim::reschedule(current, lock);
+        sim::park(current, lock);
+    }
+    sim::preemptCheck(current, lock);
+}
+
+void task_delay(const uint32_t milliseconds) {
+    Lock lock(sim::kernel().mutex);
+    Tcb* current = sim::self(lock);
+    if (milliseconds == 0) sim::yield(current, lock);
+    else sim::block(current, sim::Wait::DELAY, nullptr, sim::tickAfter(sim::kernel().time, milliseconds), lock);
+}
+
+void delay(const uint32_t milliseconds) { task_delay(milliseconds); }
+
+void task_delay_until(uint32_t* const prev_time, const uint32_t delta) {
+    Lock lock(sim::kernel().mutex);
+    Tcb* current = sim::self(lock);
+    *prev_time += delta;
+    const uint32_t time = sim::kernel().time / 1000;
+    // wrapping subtraction, so a deadline in the past doesn't block
+    if (int32_t(*prev_time - time) > 0)
+        sim::block(current, sim::Wait::DELAY, nullptr, sim::tickAfter(sim::kernel().time, *prev_time - time), lock);
+}
+
+uint32_t task_get_priority(task_t task) {
+    Lock lock(sim::kernel().mutex);
+    return sim::resolve(task, lock)->priority;
+}
+
+void task_set_priority(task_t task, uint32_t prio) {
+    Lock lock(sim::kernel().mutex);
+    Tcb* current = sim::self(lock);
+    sim::resolve(task, lock)->priority = prio;
+    sim::preemptCheck(current, lock);
+}
+
+task_state_e_t task_get_state(task_t task) {
+    Lock lock(sim::kernel().mutex);
+    return sim::resolve(task, lock)->state;
+}
+
+void task_suspend(task_t task) {
+    Lock lock(sim::kernel().mutex);
+    Tcb* current = sim::self(lock);
+    Tcb* tcb = sim::resolve(task, lock);
+    if (tcb->state == E_TASK_STATE_DELETED) return;
+    tcb->state = E_TASK_STATE_SUSPENDED;
+    if (tcb == current) sim::reschedule(current, lock);
+}
+
+void task_resume(task_t task) {
+    Lock lock(sim::kernel().mutex);
+    Tcb* current = sim::self(lock);
+    Tcb* tcb = sim::resolve(task, lock);
+    if (tcb->state != E_TASK_STATE_SUSPENDED) return;
+    sim::makeReady(tcb);
+    sim::preemptCheck(current, lock);
+}
+
+uint32_t task_get_count(void) {
+    Lock lock(sim::kernel().mutex);
+    uint32_t count = 0;
+    for (Tcb* tcb : sim::kernel().tasks) count += tcb->state != E_TASK_STATE_DELETED;
+    return count;
+}
+
+char* task_get_name(task_t task) {
+    Lock lock(sim::kernel().mutex);
+    return sim::resolve(task, lock)->name.data();
+}
+
+task_t task_get_by_name(const char* name) {
+    Lock lock(sim::kernel().mutex);
+    for (Tcb* tcb : sim::kernel().tasks) {
+        if (tcb->state != E_TASK_STATE_DELETED && tcb->name == name) return tcb;
+    }
+    return nullptr;
+}
+
+task_t task_get_current() {
+    Lock lock(sim::kernel().mutex);
+    return sim::self(lock);
+}
+
+uint32_t task_notify(task_t task) { return task_notify_ext(task, 0, E_NOTIFY_ACTION_INCR, nullptr); }
+
+void task_join(task_t task) {
+    Lock lock(sim::kernel().mutex);
+    Tcb* current = sim::self(lock);
+    Tcb* tcb = sim::resolve(task, lock);
+    if (tcb->state != E_TASK_STATE_DELETED) sim::block(current, sim::Wait::JOIN, tcb, sim::NEVER, lock);
+}
+
+uint32_t task_notify_ext(task_t task, uint32_t value, notify_action_e_t action, uint32_t* prev_value) {
+    Lock lock(sim::kernel().mutex);
+    Tcb* current = sim::self(lock);
+    sim::chargeTask(current, sim::KERNEL_CALL_COST, lock);
+    Tcb* tcb = sim::resolve(task, lock);
+    if (prev_value != nullptr) *prev_value = tcb->notifyValue;
+    switch (action) {
+        case E_NOTIFY_ACTION_NONE: break;
+        case E_NOTIFY_ACTION_BITS: tcb->notifyValue |= value; break;
+        case E_NOTIFY_ACTION_INCR: tcb->notifyValue++; break;
+        case E_NOTIFY_ACTION_OWRITE: tcb->notifyValue = value; break;
+        case E_NOTIFY_ACTION_NO_OWRITE:
+            if (tcb->notified) return 0;
+            tcb->notifyValue = value;
+            break;
+    }
+    tcb->notified = true;
+    if (tcb->state == E_TASK_STATE_BLOCKED && tcb->wait == sim::Wait::NOTIFY && tcb->notifyValue != 0) {
+        sim::makeReady(tcb);
+        sim::preemptCheck(current, lock);
+    }
+    return 1;
+}
+
+uint32_t task_notify_take(bool clear_on_exit, uint32_t timeout) {
+    Lock lock(sim::kernel().mutex);
+    Tcb* current = sim::self(lock);
+    if (current->notifyValue == 0 && timeout != 0)
+        sim::block(current, sim::Wait::NOTIFY, nullptr, sim::tickAfter(sim::kernel().time, timeout), lock);
+    const uint32_t value = current->notifyValue;
+    if (value != 0) current->notifyValue = clear_on_exit ? 0 : value - 1;
+    current->notified = false;
+    return value;
+}
+
+bool task_notify_clear(task_t task) {
+    Lock lock(sim::kernel().mutex);
+    Tcb* tcb = sim::resolve(task, lock);
+    const bool wasNotified = tcb->notified;
+    tcb->notified = false;
+    return wasNotified;
+}
+
+mutex_t mutex_create(void) { return new sim::KernelMutex {.recursive = false}; }
+
+bool mutex_take(mutex_t mutex, uint32_t timeout) {
+    return sim::takeMutex(static_cast<sim::KernelMutex*>(mutex), timeout);
+}
+
+bool mutex_give(mutex_t mutex) { return sim::giveMutex(static_cast<sim::KernelMutex*>(mutex)); }
+
+mutex_t mutex_recursive_create(void) { return new sim::KernelMutex {.recursive = true}; }
+
+bool mutex_recursive_take(mutex_t mutex, uint32_t timeout) {
+    return sim::takeMutex(static_cast<sim::KernelMutex*>(mutex), timeout);
+}
+
+bool mutex_recursive_give(mutex_t mutex) { return sim::giveMutex(static_cast<sim::KernelMutex*>(mutex)); }
+
+void mutex_delete(mutex_t mutex) { delete static_cast<sim::KernelMutex*>(mutex); }
+} // namespace pros::c
@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include "main.h"
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/logger/stdout.hpp"
+#include "sim/bench.hpp"
+#include "sim/kernel.hpp"
+#include "sim/world.hpp"
+#include "subsystem.hpp"
+
+// chassis, subsystems and routines defined in src/main.cpp
+extern lemlib::Chassis chassis;
+extern SubsystemScheduler scheduler;
+void blueneg();
+void redneg();
+void redpos();
+void bluepos();
+void skills();
+
+namespace {
+struct Routine {
+        const char* name;
+        void (*function)();
+};
+
+constexpr Routine routines[] = {
+    {"autonomous", autonomous}, {"blueneg", blueneg}, {"redneg", redneg},
+    {"redpos", redpos},         {"bluepos", bluepos}, {"skills", skills},
+};
+
+void usage(const char* program) {
+    std::fprintf(stderr, "usage: %s [--routine NAME] [--time SECONDS] [--bench] [--telemetry FILE] [--battery MV]"
+                 " [--temperature C] [--jam SECONDS]\n", program);
+    std::fprintf(stderr, "routines:");
+    for (const Routine& routine : routines) std::fprintf(stderr, " %s", routine.name);
+    std::fprintf(stderr, "\n");
+}
+} // namespace
+
+/**
+ * @brief Run initialize() followed by an autonomous routine, then report where the robot ended up
+ *
+ * The routine runs in its own task like it would under competition control, and is stopped when the time limit is
+ * reached. It counts as finished once it has returned and the chassis is no longer in motion. With --bench, the timing
+ * of every motion is printed as well. Binary telemetry is thrown away, unless --telemetry gives a file to write it to.
+ * --battery and --temperature start the robot on a battery charged to that many millivolts, with motors that hot.
+ * --jam jams the intake that long into the routine, until it's run back the other way.
+ */
+int main(int argc, char** argv) {
+    const Routine* routine = &routines[0];
+    double timeLimit = 60;
+    bool bench = false;
+    std::FILE* telemetry = nullptr;
+    sim::RobotConfig config = sim::world().getConfig();
+    double jamTime = -1;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--routine") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            routine = nullptr;
+            for (const Routine& candidate : routines) {
+                if (std::strcmp(candidate.name, name) == 0) routine = &candidate;
+            }
+            if (routine == nullptr) {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--time") == 0 && i + 1 < argc) {
+            timeLimit = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--bench") == 0) {
+            bench = true;
+        } else if (std::strcmp(argv[i], "--telemetry") == 0 && i + 1 < argc) {
+            telemetry = std::fopen(argv[++i], "wb");
+            if (telemetry == nullptr) {
+                std::perror(argv[i]);
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--battery") == 0 && i + 1 < argc) {
+            config.batteryVoltage = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--temperature") == 0 && i + 1 < argc) {
+            config.motorTemperature = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--jam") == 0 && i + 1 < argc) {
+            jamTime = std::atof(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    sim::world().configure(config);
+
+    // keep binary frames out of the report on stdout
+    lemlib::telemetrySink()->setOutput([telemetry](const std::uint8_t* data, std::size_t size) {
+        if (telemetry != nullptr) std::fwrite(data, 1, size, telemetry);
+    });
+    initialize();
+    if (bench) sim::recordMotions(chassis);
+    const std::uint32_t start = pros::c::millis();
+    const std::uint64_t startCalls = sim::world().getDeviceCalls();
+    pros::Task task([routine] { routine->function(); }, "autonomous");
+    const int intakePort = config.freeMotorPorts.empty() ? 0 : config.freeMotorPorts.front();
+    std::uint32_t jammedAt = 0, jamCleared = 0;
+    while ((task.get_state() != pros::E_TASK_STATE_DELETED || chassis.isInMotion()) &&
+           pros::c::millis() - start < timeLimit * 1000) {
+        if (jamTime >= 0 && intakePort != 0) {
+            auto guard = sim::world().lock();
+            sim::world().advance();
+            sim::MotorState& intakeMotor = sim::world().motor(intakePort);
+            const std::uint32_t now = pros::c::millis() - start;
+            // jam it the way it's being driven
+            if (jammedAt == 0 && now >= jamTime * 1000 && intakeMotor.voltage != 0) {
+                intakeMotor.jam = intakeMotor.voltage > 0 ? 1 : -1;
+                jammedAt = now;
+            }
+            if (jammedAt != 0 && jamCleared == 0 && intakeMotor.jam == 0) jamCleared = now;
+        }
+        pros::c::delay(10);
+    }
+    const std::uint32_t elapsed = pros::c::millis() - start;
+    const std::uint64_t deviceCalls = sim::world().getDeviceCalls() - startCalls;
+    task.remove();
+
+    const auto pose = sim::world().truePose();
+    std::printf("%s %s after %.3f s\n", routine->name,
+                elapsed < timeLimit * 1000 ? "finished" : "timed out", elapsed / 1000.0);
+    const lemlib::Pose odom = chassis.getPose();
+    std::printf("odometry pose: x %.2f, y %.2f, theta %.2f\n", odom.x, odom.y, odom.theta);
+    std::printf("true displacement: x %.2f, y %.2f, theta %.2f\n", pose[0], pose[1], pose[2]);
+    if (bench) {
+        sim::printMotions(stdout, routine->name, elapsed);
+        sim::printSubsystems(stdout, scheduler);
+        sim::printTasks(stdout);
+        std::printf("  %llu device calls, %.0f a second\n", static_cast<unsigned long long>(deviceCalls),
+                    deviceCalls / (elapsed / 1000.0));
+        double hottest = 0;
+        for (int port = 1; port <= sim::PORT_COUNT; port++)
+            hottest = std::max(hottest, sim::world().motor(port).temperature);
+        std::printf("  battery down to %.0f mV, hottest motor %.1f C\n", sim::world().minBatteryVoltage(), hottest);
+        std::printf("  wheels slipping for %.2f s\n", sim::world().slipTime());
+        if (jammedAt != 0 && jamCleared != 0)
+            std::printf("  intake jammed at %.2f s, cleared %u ms later\n", jammedAt / 1000.0, jamCleared - jammedAt);
+        else if (jammedAt != 0) std::printf("  intake jammed at %.2f s, never cleared\n", jammedAt / 1000.0);
+    }
+
+    // let the logger drain, then leave without running static destructors under the still running tasks
+    while (!lemlib::bufferedStdout().buffersEmpty()) pros::c::delay(10);
+    std::fflush(stdout);
+    if (telemetry != nullptr) {
+        pros::c::delay(20); // one more pass of the telemetry task
+        std::fclose(telemetry);
+    }
+    _exit(0);
+}
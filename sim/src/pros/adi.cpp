@@ -0,0 +1,130 @@
+#include <cerrno>
+#include "pros/adi.h"
+#include "pros/adi.hpp"
+#include "pros/error.h"
+#include "sim/world.hpp"
+
+namespace {
+/**
+ * @brief Convert 'A'-'H', 'a'-'h' or 1-8 to a port index from 1 to 8, or 0 if the port is invalid
+ */
+std::uint8_t adiPort(std::uint8_t port) {
+    if (port >= 'a' && port <= 'h') return port - 'a' + 1;
+    if (port >= 'A' && port <= 'H') return port - 'A' + 1;
+    if (port >= 1 && port <= sim::ADI_PORT_COUNT) return port;
+    return 0;
+}
+
+/**
+ * @brief Lock the world and run a function on the state of an ADI port
+ */
+template <typename F> std::int32_t withAdi(std::uint8_t port, F&& function) {
+    const std::uint8_t index = adiPort(port);
+    if (index == 0) {
+        errno = ENXIO;
+        return PROS_ERR;
+    }
+    sim::World& world = sim::world();
+    auto guard = world.lock();
+    return function(world.adi(index));
+}
+} // namespace
+
+namespace pros::c {
+adi_port_config_e_t adi_port_get_config(uint8_t port) {
+    return adi_port_config_e_t(withAdi(port, [](sim::AdiState& adi) { return adi.config; }));
+}
+
+int32_t adi_port_get_value(uint8_t port) {
+    return withAdi(port, [](sim::AdiState& adi) { return adi.value; });
+}
+
+int32_t adi_port_set_config(uint8_t port, adi_port_config_e_t type) {
+    return withAdi(port, [&](sim::AdiState& adi) {
+        adi.config = type;
+        adi.value = 0;
+        return PROS_SUCCESS;
+    });
+}
+
+int32_t adi_port_set_value(uint8_t port, int32_t value) {
+    return withAdi(port, [&](sim::AdiState& adi) {
+        adi.value = value;
+        return PROS_SUCCESS;
+    });
+}
+
+int32_t adi_digital_read(uint8_t port) { return adi_port_get_value(port); }
+
+int32_t adi_digital_write(uint8_t port, bool value) { return adi_port_set_value(port, value); }
+
+adi_encoder_t adi_encoder_init(uint8_t port_top, uint8_t port_bottom, bool reverse) {
+    if (adi_port_set_config(port_top, E_ADI_LEGACY_ENCODER) == PROS_ERR) return PROS_ERR;
+    return adiPort(port_top);
+}
+
+int32_t adi_encoder_get(adi_encoder_t enc) { return adi_port_get_value(enc); }
+
+int32_t adi_encoder_reset(adi_encoder_t enc) { return adi_port_set_value(enc, 0); }
+
+int32_t adi_encoder_shutdown(adi_encoder_t enc) { return adi_port_set_config(enc, E_ADI_TYPE_UNDEFINED); }
+} // namespace pros::c
+
+namespace pros {
+namespace adi {
+using namespace pros::c;
+
+Port::Port(std::uint8_t adi_port, adi_port_config_e_t type)
+    : _smart_port(INTERNAL_ADI_PORT),
+      _adi_port(adi_port) {
+    if (type != E_ADI_TYPE_UNDEFINED) adi_port_set_config(_adi_port, type);
+}
+
+Port::Port(ext_adi_port_pair_t port_pair, adi_port_config_e_t type)
+    : _smart_port(port_pair.first),
+      _adi_port(port_pair.second) {
+    if (type != E_ADI_TYPE_UNDEFINED) adi_port_set_config(_adi_port, type);
+}
+
+std::int32_t Port::get_config() const { return adi_port_get_config(_adi_port); }
+
+std::int32_t Port::get_value() const { return adi_port_get_value(_adi_port); }
+
+std::int32_t Port::set_config(adi_port_config_e_t type) const { return adi_port_set_config(_adi_port, type); }
+
+std::int32_t Port::set_value(std::int32_t value) const { return adi_port_set_value(_adi_port, value); }
+
+ext_adi_port_tuple_t Port::get_port() const { return std::make_tuple(_smart_port, _adi_port, PROS_ERR_BYTE); }
+
+DigitalOut::DigitalOut(std::uint8_t adi_port, bool init_state)
+    : Port(adi_port, E_ADI_DIGITAL_OUT) {
+    set_value(init_state);
+}
+
+DigitalOut::DigitalOut(ext_adi_port_pair_t port_pair, bool init_state)
+    : Port(port_pair, E_ADI_DIGITAL_OUT) {
+    set_value(init_state);
+}
+
+Encoder::Encoder(std::uint8_t adi_port_top, std::uint8_t adi_port_bottom, bool reversed)
+    : Port(adi_port_top),
+      _port_pair(adi_port_top, adi_port_bottom) {
+    adi_encoder_init(adi_port_top, adi_port_bottom, reversed);
+}
+
+Encoder::Encoder(ext_adi_port_tuple_t port_tuple, bool reversed)
+    : Port(std::get<1>(port_tuple)),
+      _port_pair(std::get<1>(port_tuple), std::get<2>(port_tuple)) {
+    _smart_port = std::get<0>(port_tuple);
+    adi_encoder_init(std::get<1>(port_tuple), std::get<2>(port_tuple), reversed);
+}
+
+std::int32_t Encoder::reset() const { return adi_encoder_reset(_adi_port); }
+
+std::int32_t Encoder::get_value() const { return adi_encoder_get(_adi_port); }
+
+ext_adi_port_tuple_t Encoder::get_port() const {
+    return std::make_tuple(_smart_port, _port_pair.first, _port_pair.second);
+}
+} // namespace adi
+} // namespace pros
@@ -0,0 +1,30 @@
+#include "pros/device.hpp"
+#include "sim/world.hpp"
+
+namespace pros {
+inline namespace v5 {
+Device::Device(const std::uint8_t port)
+    : _port(port) {}
+
+std::uint8_t Device::get_port() const { return _port; }
+
+bool Device::is_installed() { return get_plugged_type() == _deviceType; }
+
+pros::DeviceType Device::get_plugged_type() const { return get_plugged_type(_port); }
+
+pros::DeviceType Device::get_plugged_type(std::uint8_t port) {
+    if (port < 1 || port > sim::PORT_COUNT) return DeviceType::undefined;
+    sim::World& world = sim::world();
+    auto guard = world.lock();
+    return DeviceType(world.pluggedType(port));
+}
+
+std::vector<Device> Device::get_all_devices(pros::DeviceType device_type) {
+    std::vector<Device> devices;
+    for (std::uint8_t port = 1; port <= sim::PORT_COUNT; port++) {
+        if (get_plugged_type(port) == device_type) devices.push_back(Device(port, device_type));
+    }
+    return devices;
+}
+} // namespace v5
+} // namespace pros
@@ -0,0 +1,47 @@
+#include <cerrno>
+#include <cmath>
+#include "pros/distance.h"
+#include "pros/distance.hpp"
+#include "pros/error.h"
+
+// the simulated field has no walls or game elements to measure, so no port has a distance sensor plugged in
+namespace pros::c {
+int32_t distance_get(uint8_t port) {
+    errno = ENODEV;
+    return PROS_ERR;
+}
+
+int32_t distance_get_confidence(uint8_t port) {
+    errno = ENODEV;
+    return PROS_ERR;
+}
+
+int32_t distance_get_object_size(uint8_t port) {
+    errno = ENODEV;
+    return PROS_ERR;
+}
+
+double distance_get_object_velocity(uint8_t port) {
+    errno = ENODEV;
+    return PROS_ERR_F;
+}
+} // namespace pros::c
+
+namespace pros {
+inline namespace v5 {
+using namespace pros::c;
+
+Distance::Distance(const std::uint8_t port)
+    : Device(port, DeviceType::distance) {}
+
+std::int32_t Distance::get() { return distance_get(_port); }
+
+std::int32_t Distance::get_distance() { return distance_get(_port); }
+
+std::int32_t Distance::get_confidence() { return distance_get_confidence(_port); }
+
+std::int32_t Distance::get_object_size() { return distance_get_object_size(_port); }
+
+double Distance::get_object_velocity() { return distance_get_object_velocity(_port); }
+} // namespace v5
+} // namespace pros
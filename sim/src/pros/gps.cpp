@@ -0,0 +1,213 @@
+#include <cerrno>
+#include <cmath>
+#include <random>
+#include "pros/error.h"
+#include "pros/gps.h"
+#include "pros/gps.hpp"
+#include "sim/world.hpp"
+
+namespace {
+constexpr double INCHES_PER_METER = 39.3701;
+
+/**
+ * @brief A reading of the GPS: the pose of the robot in meters and degrees, with noise
+ */
+struct Reading {
+        double x;
+        double y;
+        double heading;
+};
+
+/**
+ * @brief Lock the world, bring it up to date, and run a function on the state of a GPS sensor and a fresh reading
+ *
+ * The GPS field frame is the simulator's: the origin is where the robot started, and heading 0 is the way it faced.
+ * The noise comes from a fixed seed, so runs stay reproducible. Ports without the GPS set errno and return the error
+ * value.
+ */
+template <typename F, typename E> auto withGps(std::uint8_t port, E error, F&& function) -> decltype(error) {
+    static std::mt19937 rng(1);
+    sim::World& world = sim::world();
+    auto guard = world.lock();
+    const sim::RobotConfig& config = world.getConfig();
+    if (config.gpsPort == 0 || port != config.gpsPort) {
+        errno = ENODEV;
+        return error;
+    }
+    const std::array<double, 3> pose = world.truePose();
+    std::normal_distribution<double> position(0, config.gpsNoise);
+    std::normal_distribution<double> heading(0, config.gpsHeadingNoise);
+    const Reading reading {pose[0] / INCHES_PER_METER + position(rng), pose[1] / INCHES_PER_METER + position(rng),
+                           std::fmod(std::fmod(pose[2] + heading(rng), 360) + 360, 360)};
+    return function(world.gps(port), reading);
+}
+} // namespace
+
+namespace pros::c {
+int32_t gps_initialize_full(uint8_t port, double xInitial, double yInitial, double headingInitial, double xOffset,
+                            double yOffset) {
+    return withGps(port, PROS_ERR, [&](sim::GpsState& gps, const Reading&) {
+        gps.offsetX = xOffset;
+        gps.offsetY = yOffset;
+        return PROS_SUCCESS;
+    });
+}
+
+int32_t gps_set_offset(uint8_t port, double xOffset, double yOffset) {
+    return withGps(port, PROS_ERR, [&](sim::GpsState& gps, const Reading&) {
+        gps.offsetX = xOffset;
+        gps.offsetY = yOffset;
+        return PROS_SUCCESS;
+    });
+}
+
+gps_position_s_t gps_get_offset(uint8_t port) {
+    return withGps(port, gps_position_s_t {PROS_ERR_F, PROS_ERR_F},
+                   [](sim::GpsState& gps, const Reading&) { return gps_position_s_t {gps.offsetX, gps.offsetY}; });
+}
+
+// the simulated GPS always sees the field strip, so it never needs to be told where it is
+int32_t gps_set_position(uint8_t port, double xInitial, double yInitial, double headingInitial) {
+    return withGps(port, PROS_ERR, [](sim::GpsState&, const Reading&) { return PROS_SUCCESS; });
+}
+
+int32_t gps_set_data_rate(uint8_t port, uint32_t rate) {
+    return withGps(port, PROS_ERR, [&](sim::GpsState& gps, const Reading&) {
+        gps.dataRate = std::max<uint32_t>(rate - rate % 5, 5);
+        return PROS_SUCCESS;
+    });
+}
+
+double gps_get_error(uint8_t port) {
+    return withGps(port, PROS_ERR_F, [](sim::GpsState&, const Reading&) { return sim::world().getConfig().gpsNoise; });
+}
+
+gps_status_s_t gps_get_position_and_orientation(uint8_t port) {
+    const gps_status_s_t error {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    return withGps(port, error, [](sim::GpsState&, const Reading& reading) {
+        return gps_status_s_t {reading.x, reading.y, 0, 0, std::remainder(reading.heading, 360)};
+    });
+}
+
+gps_position_s_t gps_get_position(uint8_t port) {
+    return withGps(port, gps_position_s_t {PROS_ERR_F, PROS_ERR_F},
+                   [](sim::GpsState&, const Reading& reading) { return gps_position_s_t {reading.x, reading.y}; });
+}
+
+double gps_get_position_x(uint8_t port) {
+    return withGps(port, PROS_ERR_F, [](sim::GpsState&, const Reading& reading) { return reading.x; });
+}
+
+double gps_get_position_y(uint8_t port) {
+    return withGps(port, PROS_ERR_F, [](sim::GpsState&, const Reading& reading) { return reading.y; });
+}
+
+gps_orientation_s_t gps_get_orientation(uint8_t port) {
+    return withGps(port, gps_orientation_s_t {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F},
+                   [](sim::GpsState&, const Reading& reading) {
+                       return gps_orientation_s_t {0, 0, std::remainder(reading.heading, 360)};
+                   });
+}
+
+// the field is flat
+double gps_get_pitch(uint8_t port) {
+    return withGps(port, PROS_ERR_F, [](sim::GpsState&, const Reading&) { return 0.0; });
+}
+
+double gps_get_roll(uint8_t port) {
+    return withGps(port, PROS_ERR_F, [](sim::GpsState&, const Reading&) { return 0.0; });
+}
+
+double gps_get_yaw(uint8_t port) {
+    return withGps(port, PROS_ERR_F,
+                   [](sim::GpsState&, const Reading& reading) { return std::remainder(reading.heading, 360); });
+}
+
+double gps_get_heading(uint8_t port) {
+    return withGps(port, PROS_ERR_F, [](sim::GpsState&, const Reading& reading) { return reading.heading; });
+}
+
+double gps_get_heading_raw(uint8_t port) { return gps_get_heading(port); }
+
+// rates and accelerations aren't simulated, the readings are those of a robot standing still
+gps_gyro_s_t gps_get_gyro_rate(uint8_t port) {
+    return withGps(port, gps_gyro_s_t {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F},
+                   [](sim::GpsState&, const Reading&) { return gps_gyro_s_t {0, 0, 0}; });
+}
+
+double gps_get_gyro_rate_x(uint8_t port) { return gps_get_gyro_rate(port).x; }
+
+double gps_get_gyro_rate_y(uint8_t port) { return gps_get_gyro_rate(port).y; }
+
+double gps_get_gyro_rate_z(uint8_t port) { return gps_get_gyro_rate(port).z; }
+
+gps_accel_s_t gps_get_accel(uint8_t port) {
+    return withGps(port, gps_accel_s_t {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F},
+                   [](sim::GpsState&, const Reading&) { return gps_accel_s_t {0, 0, 1}; });
+}
+
+double gps_get_accel_x(uint8_t port) { return gps_get_accel(port).x; }
+
+double gps_get_accel_y(uint8_t port) { return gps_get_accel(port).y; }
+
+double gps_get_accel_z(uint8_t port) { return gps_get_accel(port).z; }
+} // namespace pros::c
+
+namespace pros {
+inline namespace v5 {
+using namespace pros::c;
+
+std::int32_t Gps::initialize_full(double xInitial, double yInitial, double headingInitial, double xOffset,
+                                  double yOffset) const {
+    return gps_initialize_full(_port, xInitial, yInitial, headingInitial, xOffset, yOffset);
+}
+
+std::int32_t Gps::set_offset(double xOffset, double yOffset) const { return gps_set_offset(_port, xOffset, yOffset); }
+
+pros::gps_position_s_t Gps::get_offset() const { return gps_get_offset(_port); }
+
+std::int32_t Gps::set_position(double xInitial, double yInitial, double headingInitial) const {
+    return gps_set_position(_port, xInitial, yInitial, headingInitial);
+}
+
+std::int32_t Gps::set_data_rate(std::uint32_t rate) const { return gps_set_data_rate(_port, rate); }
+
+double Gps::get_error() const { return gps_get_error(_port); }
+
+pros::gps_status_s_t Gps::get_position_and_orientation() const { return gps_get_position_and_orientation(_port); }
+
+pros::gps_position_s_t Gps::get_position() const { return gps_get_position(_port); }
+
+double Gps::get_position_x() const { return gps_get_position_x(_port); }
+
+double Gps::get_position_y() const { return gps_get_position_y(_port); }
+
+pros::gps_orientation_s_t Gps::get_orientation() const { return gps_get_orientation(_port); }
+
+double Gps::get_pitch() const { return gps_get_pitch(_port); }
+
+double Gps::get_roll() const { return gps_get_roll(_port); }
+
+double Gps::get_yaw() const { return gps_get_yaw(_port); }
+
+double Gps::get_heading() const { return gps_get_heading(_port); }
+
+double Gps::get_heading_raw() const { return gps_get_heading_raw(_port); }
+
+pros::gps_gyro_s_t Gps::get_gyro_rate() const { return gps_get_gyro_rate(_port); }
+
+double Gps::get_gyro_rate_x() const { return gps_get_gyro_rate_x(_port); }
+
+double Gps::get_gyro_rate_y() const { return gps_get_gyro_rate_y(_port); }
+
+double Gps::get_gyro_rate_z() const { return gps_get_gyro_rate_z(_port); }
+
+pros::gps_accel_s_t Gps::get_accel() const { return gps_get_accel(_port); }
+
+double Gps::get_accel_x() const { return gps_get_accel_x(_port); }
+
+double Gps::get_accel_y() const { return gps_get_accel_y(_port); }
+
+double Gps::get_accel_z() const { return gps_get_accel_z(_port); }
+} // namespace v5
+} // namespace pros
@@ -0,0 +1,226 @@
+#include <cerrno>
+#include <cmath>
+#include "pros/error.h"
+#include "pros/imu.h"
+#include "pros/imu.hpp"
+#include "sim/kernel.hpp"
+#include "sim/world.hpp"
+
+namespace {
+/**
+ * @brief Lock the world, bring it up to date, and run a function on the state of an inertial sensor
+ *
+ * The function isn't run while the sensor is calibrating, instead errno is set and the error value is returned.
+ */
+template <typename F, typename E> auto withImu(std::uint8_t port, E error, F&& function) -> decltype(error) {
+    sim::World& world = sim::world();
+    auto guard = world.lock();
+    world.advance();
+    sim::ImuState& imu = world.imu(port);
+    if (sim::now() < imu.calibrationEnd) {
+        errno = EAGAIN;
+        return error;
+    }
+    // the sensor zeroes itself the moment it finishes calibrating
+    if (!imu.calibrated) {
+        imu.calibrated = true;
+        imu.rotationOffset = -world.imuRotation();
+    }
+    return function(imu, world.imuRotation() + imu.rotationOffset);
+}
+
+double wrapHeading(double rotation) { return std::fmod(std::fmod(rotation, 360) + 360, 360); }
+
+double wrapYaw(double rotation) { return std::remainder(rotation, 360); }
+} // namespace
+
+namespace pros::c {
+int32_t imu_reset(uint8_t port) {
+    sim::World& world = sim::world();
+    auto guard = world.lock();
+    sim::ImuState& imu = world.imu(port);
+    imu.calibrationEnd = sim::now() + world.getConfig().imuCalibrationTime * std::uint64_t(1000);
+    imu.calibrated = false;
+    return PROS_SUCCESS;
+}
+
+int32_t imu_reset_blocking(uint8_t port) {
+    imu_reset(port);
+    while (imu_get_status(port) & E_IMU_STATUS_CALIBRATING) delay(10);
+    return PROS_SUCCESS;
+}
+
+int32_t imu_set_data_rate(uint8_t port, uint32_t rate) {
+    return withImu(port, PROS_ERR, [&](sim::ImuState& imu, double) {
+        imu.dataRate = std::max<uint32_t>(rate - rate % 5, 5);
+        return PROS_SUCCESS;
+    });
+}
+
+double imu_get_rotation(uint8_t port) {
+    return withImu(port, PROS_ERR_F, [](sim::ImuState&, double rotation) { return rotation; });
+}
+
+double imu_get_heading(uint8_t port) {
+    return withImu(port, PROS_ERR_F, [](sim::ImuState&, double rotation) { return wrapHeading(rotation); });
+}
+
+quaternion_s_t imu_get_quaternion(uint8_t port) {
+    const quaternion_s_t error {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    return withImu(port, error, [](sim::ImuState&, double rotation) {
+        // rotation about the z axis only, yaw is counterclockwise positive
+        const double half = -rotation * M_PI / 360;
+        return quaternion_s_t {0, 0, std::sin(half), std::cos(half)};
+    });
+}
+
+euler_s_t imu_get_euler(uint8_t port) {
+    const euler_s_t error {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    return withImu(port, error, [](sim::ImuState&, double rotation) { return euler_s_t {0, 0, wrapYaw(rotation)}; });
+}
+
+imu_gyro_s_t imu_get_gyro_rate(uint8_t port) {
+    const imu_gyro_s_t error {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    return withImu(port, error, [](sim::ImuState&, double) { return imu_gyro_s_t {0, 0, 0}; });
+}
+
+imu_accel_s_t imu_get_accel(uint8_t port) {
+    const imu_accel_s_t error {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    return withImu(port, error, [](sim::ImuState&, double) { return imu_accel_s_t {0, 0, 1}; });
+}
+
+imu_status_e_t imu_get_status(uint8_t port) {
+    sim::World& world = sim::world();
+    auto guard = world.lock();
+    return sim::now() < world.imu(port).calibrationEnd ? E_IMU_STATUS_CALIBRATING : E_IMU_STATUS_READY;
+}
+
+double imu_get_pitch(uint8_t port) {
+    return withImu(port, PROS_ERR_F, [](sim::ImuState&, double) { return 0.0; });
+}
+
+double imu_get_roll(uint8_t port) {
+    return withImu(port, PROS_ERR_F, [](sim::ImuState&, double) { return 0.0; });
+}
+
+double imu_get_yaw(uint8_t port) {
+    return withImu(port, PROS_ERR_F, [](sim::ImuState&, double rotation) { return wrapYaw(rotation); });
+}
+
+int32_t imu_tare_heading(uint8_t port) { return imu_set_heading(port, 0); }
+
+int32_t imu_tare_rotation(uint8_t port) { return imu_set_rotation(port, 0); }
+
+int32_t imu_tare_pitch(uint8_t port) { return imu_set_pitch(port, 0); }
+
+int32_t imu_tare_roll(uint8_t port) { return imu_set_roll(port, 0); }
+
+int32_t imu_tare_yaw(uint8_t port) { return imu_set_yaw(port, 0); }
+
+int32_t imu_tare_euler(uint8_t port) { return imu_set_euler(port, {0, 0, 0}); }
+
+int32_t imu_tare(uint8_t port) { return imu_tare_euler(port) == PROS_ERR ? PROS_ERR : imu_tare_rotation(port); }
+
+int32_t imu_set_euler(uint8_t port, euler_s_t target) { return imu_set_yaw(port, target.yaw); }
+
+int32_t imu_set_rotation(uint8_t port, double target) {
+    return withImu(port, PROS_ERR, [&](sim::ImuState& imu, double rotation) {
+        imu.rotationOffset += target - rotation;
+        return PROS_SUCCESS;
+    });
+}
+
+int32_t imu_set_heading(uint8_t port, double target) {
+    return withImu(port, PROS_ERR, [&](sim::ImuState& imu, double rotation) {
+        imu.rotationOffset += wrapHeading(target) - wrapHeading(rotation);
+        return PROS_SUCCESS;
+    });
+}
+
+int32_t imu_set_pitch(uint8_t port, double target) {
+    return withImu(port, PROS_ERR, [](sim::ImuState&, double) { return PROS_SUCCESS; });
+}
+
+int32_t imu_set_roll(uint8_t port, double target) {
+    return withImu(port, PROS_ERR, [](sim::ImuState&, double) { return PROS_SUCCESS; });
+}
+
+int32_t imu_set_yaw(uint8_t port, double target) {
+    return withImu(port, PROS_ERR, [&](sim::ImuState& imu, double rotation) {
+        imu.rotationOffset += wrapYaw(target) - wrapYaw(rotation);
+        return PROS_SUCCESS;
+    });
+}
+
+imu_orientation_e_t imu_get_physical_orientation(uint8_t port) { return E_IMU_Z_UP; }
+} // namespace pros::c
+
+namespace pros {
+inline namespace v5 {
+using namespace pros::c;
+
+std::int32_t Imu::reset(bool blocking) const { return blocking ? imu_reset_blocking(_port) : imu_reset(_port); }
+
+std::int32_t Imu::set_data_rate(std::uint32_t rate) const { return imu_set_data_rate(_port, rate); }
+
+std::vector<Imu> Imu::get_all_devices() {
+    std::vector<Imu> imus;
+    for (std::uint8_t port = 1; port <= sim::PORT_COUNT; port++) {
+        if (Device::get_plugged_type(port) == DeviceType::imu) imus.push_back(Imu(port));
+    }
+    return imus;
+}
+
+double Imu::get_rotation() const { return imu_get_rotation(_port); }
+
+double Imu::get_heading() const { return imu_get_heading(_port); }
+
+pros::quaternion_s_t Imu::get_quaternion() const { return imu_get_quaternion(_port); }
+
+pros::euler_s_t Imu::get_euler() const { return imu_get_euler(_port); }
+
+double Imu::get_pitch() const { return imu_get_pitch(_port); }
+
+double Imu::get_roll() const { return imu_get_roll(_port); }
+
+double Imu::get_yaw() const { return imu_get_yaw(_port); }
+
+pros::imu_gyro_s_t Imu::get_gyro_rate() const { return imu_get_gyro_rate(_port); }
+
+std::int32_t Imu::tare_rotation() const { return imu_tare_rotation(_port); }
+
+std::int32_t Imu::tare_heading() const { return imu_tare_heading(_port); }
+
+std::int32_t Imu::tare_pitch() const { return imu_tare_pitch(_port); }
+
+std::int32_t Imu::tare_yaw() const { return imu_tare_yaw(_port); }
+
+std::int32_t Imu::tare_roll() const { return imu_tare_roll(_port); }
+
+std::int32_t Imu::tare() const { return imu_tare(_port); }
+
+std::int32_t Imu::tare_euler() const { return imu_tare_euler(_port); }
+
+std::int32_t Imu::set_heading(const double target) const { return imu_set_heading(_port, target); }
+
+std::int32_t Imu::set_rotation(const double target) const { return imu_set_rotation(_port, target); }
+
+std::int32_t Imu::set_yaw(const double target) const { return imu_set_yaw(_port, target); }
+
+std::int32_t Imu::set_pitch(const double target) const { return imu_set_pitch(_port, target); }
+
+std::int32_t Imu::set_roll(const double target) const { return imu_set_roll(_port, target); }
+
+std::int32_t Imu::set_euler(const pros::euler_s_t target) const { return imu_set_euler(_port, target); }
+
+pros::imu_accel_s_t Imu::get_accel() const { return imu_get_accel(_port); }
+
+pros::ImuStatus Imu::get_status() const {
+    return imu_get_status(_port) == E_IMU_STATUS_CALIBRATING ? pros::ImuStatus::calibrating : pros::ImuStatus::ready;
+}
+
+bool Imu::is_calibrating() const { return imu_get_status(_port) & E_IMU_STATUS_CALIBRATING; }
+
+imu_orientation_e_t Imu::get_physical_orientation() const { return imu_get_physical_orientation(_port); }
+} // namespace v5
+} // namespace pros
@@ -0,0 +1,47 @@
+#include <array>
+#include <string>
+#include "pros/llemu.h"
+#include "pros/llemu.hpp"
+
+// The brain screen is 8 lines of text. Nothing is drawn, but the lines are kept so the program behaves the same.
+
+namespace pros::lcd {
+namespace {
+bool initialized = false;
+std::array<std::string, 8> lines;
+} // namespace
+
+bool is_initialized() { return initialized; }
+
+bool initialize() {
+    initialized = true;
+    return true;
+}
+
+bool shutdown() {
+    initialized = false;
+    return true;
+}
+
+bool set_text(std::int16_t line, std::string text) {
+    if (!initialized || line < 0 || line >= std::int16_t(lines.size())) return false;
+    lines.at(line) = std::move(text);
+    return true;
+}
+
+bool clear() {
+    if (!initialized) return false;
+    lines.fill("");
+    return true;
+}
+
+bool clear_line(std::int16_t line) { return set_text(line, ""); }
+
+void register_btn0_cb(lcd_btn_cb_fn_t cb) {}
+
+void register_btn1_cb(lcd_btn_cb_fn_t cb) {}
+
+void register_btn2_cb(lcd_btn_cb_fn_t cb) {}
+
+std::uint8_t read_buttons() { return 0; }
+} // namespace pros::lcd
@@ -0,0 +1,139 @@
+#include <cerrno>
+#include "pros/error.h"
+#include "pros/misc.h"
+#include "pros/misc.hpp"
+#include "sim/world.hpp"
+
+// The simulator has no controller or field control, so the sticks are centered, no buttons are pressed, and the robot
+// is always in autonomous.
+
+namespace pros::c {
+uint8_t competition_get_status(void) { return COMPETITION_AUTONOMOUS; }
+
+uint8_t competition_is_disabled(void) { return false; }
+
+uint8_t competition_is_connected(void) { return false; }
+
+uint8_t competition_is_autonomous(void) { return true; }
+
+uint8_t competition_is_field(void) { return false; }
+
+uint8_t competition_is_switch(void) { return false; }
+
+int32_t controller_is_connected(controller_id_e_t id) { return id == E_CONTROLLER_MASTER; }
+
+int32_t controller_get_analog(controller_id_e_t id, controller_analog_e_t channel) { return 0; }
+
+int32_t controller_get_battery_capacity(controller_id_e_t id) { return 100; }
+
+int32_t controller_get_battery_level(controller_id_e_t id) { return 100; }
+
+int32_t controller_get_digital(controller_id_e_t id, controller_digital_e_t button) { return 0; }
+
+int32_t controller_get_digital_new_press(controller_id_e_t id, controller_digital_e_t button) { return 0; }
+
+int32_t controller_get_digital_new_release(controller_id_e_t id, controller_digital_e_t button) { return 0; }
+
+int32_t controller_print(controller_id_e_t id, uint8_t line, uint8_t col, const char* fmt, ...) {
+    return PROS_SUCCESS;
+}
+
+int32_t controller_set_text(controller_id_e_t id, uint8_t line, uint8_t col, const char* str) { return PROS_SUCCESS; }
+
+int32_t controller_clear_line(controller_id_e_t id, uint8_t line) { return PROS_SUCCESS; }
+
+int32_t controller_clear(controller_id_e_t id) { return PROS_SUCCESS; }
+
+int32_t controller_rumble(controller_id_e_t id, const char* rumble_pattern) { return PROS_SUCCESS; }
+
+int32_t battery_get_voltage(void) {
+    sim::World& world = sim::world();
+    auto guard = world.lock();
+    world.advance();
+    return world.batteryVoltage();
+}
+
+int32_t battery_get_current(void) { return 0; }
+
+double battery_get_temperature(void) { return 25; }
+
+double battery_get_capacity(void) { return 100; }
+
+int32_t usd_is_installed(void) { return false; }
+
+int32_t usd_list_files(const char* path, char* buffer, int32_t len) {
+    errno = ENXIO;
+    return PROS_ERR;
+}
+} // namespace pros::c
+
+namespace pros {
+inline namespace v5 {
+using namespace pros::c;
+
+Controller::Controller(controller_id_e_t id)
+    : _id(id) {}
+
+std::int32_t Controller::is_connected() { return controller_is_connected(_id); }
+
+std::int32_t Controller::get_analog(controller_analog_e_t channel) { return controller_get_analog(_id, channel); }
+
+std::int32_t Controller::get_battery_capacity() { return controller_get_battery_capacity(_id); }
+
+std::int32_t Controller::get_battery_level() { return controller_get_battery_level(_id); }
+
+std::int32_t Controller::get_digital(controller_digital_e_t button) { return controller_get_digital(_id, button); }
+
+std::int32_t Controller::get_digital_new_press(controller_digital_e_t button) {
+    return controller_get_digital_new_press(_id, button);
+}
+
+std::int32_t Controller::get_digital_new_release(controller_digital_e_t button) {
+    return controller_get_digital_new_release(_id, button);
+}
+
+std::int32_t Controller::set_text(std::uint8_t line, std::uint8_t col, const char* str) {
+    return controller_set_text(_id, line, col, str);
+}
+
+std::int32_t Controller::set_text(std::uint8_t line, std::uint8_t col, const std::string& str) {
+    return controller_set_text(_id, line, col, str.c_str());
+}
+
+std::int32_t Controller::clear_line(std::uint8_t line) { return controller_clear_line(_id, line); }
+
+std::int32_t Controller::rumble(const char* rumble_pattern) { return controller_rumble(_id, rumble_pattern); }
+
+std::int32_t Controller::clear() { return controller_clear(_id); }
+} // namespace v5
+
+namespace battery {
+double get_capacity() { return battery_get_capacity(); }
+
+int32_t get_current() { return battery_get_current(); }
+
+double get_temperature() { return battery_get_temperature(); }
+
+int32_t get_voltage() { return battery_get_voltage(); }
+} // namespace battery
+
+namespace competition {
+std::uint8_t get_status() { return competition_get_status(); }
+
+std::uint8_t is_autonomous() { return competition_is_autonomous(); }
+
+std::uint8_t is_connected() { return competition_is_connected(); }
+
+std::uint8_t is_disabled() { return competition_is_disabled(); }
+
+std::uint8_t is_field_control() { return competition_is_field(); }
+
+std::uint8_t is_competition_switch() { return competition_is_switch(); }
+} // namespace competition
+
+namespace usd {
+std::int32_t is_installed() { return usd_is_installed(); }
+
+std::int32_t list_files(const char* path, char* buffer, std::int32_t len) { return usd_list_files(path, buffer, len); }
+} // namespace usd
+} // namespace pros
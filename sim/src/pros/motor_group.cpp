@@ -0,0 +1,539 @@
+#include <cmath>
+#include <mutex>
+#include "pros/error.h"
+#include "pros/motor_group.hpp"
+
+namespace pros {
+inline namespace v5 {
+MotorGroup::MotorGroup(const std::initializer_list<std::int8_t> ports, const pros::v5::MotorGears gearset,
+                       const pros::v5::MotorUnits encoder_units)
+    : MotorGroup(std::vector<std::int8_t>(ports), gearset, encoder_units) {}
+
+MotorGroup::MotorGroup(const std::vector<std::int8_t>& ports, const pros::v5::MotorGears gearset,
+                       const pros::v5::MotorUnits encoder_units)
+    : _ports(ports) {
+    if (gearset != pros::v5::MotorGears::invalid) set_gearing_all(gearset);
+    if (encoder_units != pros::v5::MotorUnits::invalid) set_encoder_units_all(encoder_units);
+}
+
+MotorGroup::MotorGroup(AbstractMotor& motor_group)
+    : _ports(motor_group.get_port_all()) {}
+
+std::int32_t MotorGroup::move(std::int32_t voltage) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    for (std::int8_t port : _ports) Motor(port).move(voltage);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::move_absolute(const double position, const std::int32_t velocity) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    for (std::int8_t port : _ports) Motor(port).move_absolute(position, velocity);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::move_relative(const double position, const std::int32_t velocity) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    for (std::int8_t port : _ports) Motor(port).move_relative(position, velocity);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::move_velocity(const std::int32_t velocity) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    for (std::int8_t port : _ports) Motor(port).move_velocity(velocity);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::move_voltage(const std::int32_t voltage) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    for (std::int8_t port : _ports) Motor(port).move_voltage(voltage);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::brake(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    for (std::int8_t port : _ports) Motor(port).brake();
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::modify_profiled_velocity(const std::int32_t velocity) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    for (std::int8_t port : _ports) Motor(port).modify_profiled_velocity(velocity);
+    return PROS_SUCCESS;
+}
+
+double MotorGroup::get_target_position(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR_F;
+    return Motor(_ports[index]).get_target_position();
+}
+
+std::vector<double> MotorGroup::get_target_position_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<double> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_target_position());
+    return out;
+}
+
+std::int32_t MotorGroup::get_target_velocity(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).get_target_velocity();
+}
+
+std::vector<std::int32_t> MotorGroup::get_target_velocity_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<std::int32_t> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_target_velocity());
+    return out;
+}
+
+double MotorGroup::get_actual_velocity(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR_F;
+    return Motor(_ports[index]).get_actual_velocity();
+}
+
+std::vector<double> MotorGroup::get_actual_velocity_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<double> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_actual_velocity());
+    return out;
+}
+
+std::int32_t MotorGroup::get_current_draw(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).get_current_draw();
+}
+
+std::vector<std::int32_t> MotorGroup::get_current_draw_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<std::int32_t> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_current_draw());
+    return out;
+}
+
+std::int32_t MotorGroup::get_direction(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).get_direction();
+}
+
+std::vector<std::int32_t> MotorGroup::get_direction_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<std::int32_t> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_direction());
+    return out;
+}
+
+double MotorGroup::get_efficiency(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR_F;
+    return Motor(_ports[index]).get_efficiency();
+}
+
+std::vector<double> MotorGroup::get_efficiency_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<double> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_efficiency());
+    return out;
+}
+
+std::uint32_t MotorGroup::get_faults(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).get_faults();
+}
+
+std::vector<std::uint32_t> MotorGroup::get_faults_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<std::uint32_t> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_faults());
+    return out;
+}
+
+std::uint32_t MotorGroup::get_flags(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).get_flags();
+}
+
+std::vector<std::uint32_t> MotorGroup::get_flags_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<std::uint32_t> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_flags());
+    return out;
+}
+
+double MotorGroup::get_position(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR_F;
+    return Motor(_ports[index]).get_position();
+}
+
+std::vector<double> MotorGroup::get_position_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<double> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_position());
+    return out;
+}
+
+double MotorGroup::get_power(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR_F;
+    return Motor(_ports[index]).get_power();
+}
+
+std::vector<double> MotorGroup::get_power_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<double> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_power());
+    return out;
+}
+
+std::int32_t MotorGroup::get_raw_position(std::uint32_t* const timestamp, const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).get_raw_position(timestamp);
+}
+
+std::vector<std::int32_t> MotorGroup::get_raw_position_all(std::uint32_t* const timestamp) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<std::int32_t> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_raw_position(timestamp));
+    return out;
+}
+
+double MotorGroup::get_temperature(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR_F;
+    return Motor(_ports[index]).get_temperature();
+}
+
+std::vector<double> MotorGroup::get_temperature_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<double> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_temperature());
+    return out;
+}
+
+double MotorGroup::get_torque(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR_F;
+    return Motor(_ports[index]).get_torque();
+}
+
+std::vector<double> MotorGroup::get_torque_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<double> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_torque());
+    return out;
+}
+
+std::int32_t MotorGroup::get_voltage(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).get_voltage();
+}
+
+std::vector<std::int32_t> MotorGroup::get_voltage_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<std::int32_t> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_voltage());
+    return out;
+}
+
+std::int32_t MotorGroup::is_over_current(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).is_over_current();
+}
+
+std::vector<std::int32_t> MotorGroup::is_over_current_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<std::int32_t> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).is_over_current());
+    return out;
+}
+
+std::int32_t MotorGroup::is_over_temp(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).is_over_temp();
+}
+
+std::vector<std::int32_t> MotorGroup::is_over_temp_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<std::int32_t> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).is_over_temp());
+    return out;
+}
+
+MotorBrake MotorGroup::get_brake_mode(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return MotorBrake::invalid;
+    return Motor(_ports[index]).get_brake_mode();
+}
+
+std::vector<MotorBrake> MotorGroup::get_brake_mode_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<MotorBrake> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_brake_mode());
+    return out;
+}
+
+std::int32_t MotorGroup::get_current_limit(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).get_current_limit();
+}
+
+std::vector<std::int32_t> MotorGroup::get_current_limit_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<std::int32_t> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_current_limit());
+    return out;
+}
+
+MotorUnits MotorGroup::get_encoder_units(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return MotorUnits::invalid;
+    return Motor(_ports[index]).get_encoder_units();
+}
+
+std::vector<MotorUnits> MotorGroup::get_encoder_units_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<MotorUnits> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_encoder_units());
+    return out;
+}
+
+MotorGears MotorGroup::get_gearing(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return MotorGears::invalid;
+    return Motor(_ports[index]).get_gearing();
+}
+
+std::vector<MotorGears> MotorGroup::get_gearing_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<MotorGears> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_gearing());
+    return out;
+}
+
+std::vector<std::int8_t> MotorGroup::get_port_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<std::int8_t> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_port());
+    return out;
+}
+
+std::int32_t MotorGroup::get_voltage_limit(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).get_voltage_limit();
+}
+
+std::vector<std::int32_t> MotorGroup::get_voltage_limit_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<std::int32_t> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_voltage_limit());
+    return out;
+}
+
+std::int32_t MotorGroup::is_reversed(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).is_reversed();
+}
+
+std::vector<std::int32_t> MotorGroup::is_reversed_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<std::int32_t> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).is_reversed());
+    return out;
+}
+
+MotorType MotorGroup::get_type(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return MotorType::invalid;
+    return Motor(_ports[index]).get_type();
+}
+
+std::vector<MotorType> MotorGroup::get_type_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::vector<MotorType> out;
+    for (std::int8_t port : _ports) out.push_back(Motor(port).get_type());
+    return out;
+}
+
+std::int32_t MotorGroup::set_brake_mode(const MotorBrake mode, const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).set_brake_mode(mode);
+}
+
+std::int32_t MotorGroup::set_brake_mode(const pros::motor_brake_mode_e_t mode, const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).set_brake_mode(mode);
+}
+
+std::int32_t MotorGroup::set_brake_mode_all(const MotorBrake mode) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    for (std::int8_t port : _ports) Motor(port).set_brake_mode(mode);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_brake_mode_all(const pros::motor_brake_mode_e_t mode) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    for (std::int8_t port : _ports) Motor(port).set_brake_mode(mode);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_current_limit(const std::int32_t limit, const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).set_current_limit(limit);
+}
+
+std::int32_t MotorGroup::set_current_limit_all(const std::int32_t limit) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    for (std::int8_t port : _ports) Motor(port).set_current_limit(limit);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_encoder_units(const MotorUnits units, const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).set_encoder_units(units);
+}
+
+std::int32_t MotorGroup::set_encoder_units(const pros::motor_encoder_units_e_t units, const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).set_encoder_units(units);
+}
+
+std::int32_t MotorGroup::set_encoder_units_all(const MotorUnits units) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    for (std::int8_t port : _ports) Motor(port).set_encoder_units(units);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_encoder_units_all(const pros::motor_encoder_units_e_t units) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    for (std::int8_t port : _ports) Motor(port).set_encoder_units(units);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_gearing(std::vector<pros::motor_gearset_e_t> gearsets) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    for (std::size_t i = 0; i < _ports.size() && i < gearsets.size(); i++) Motor(_ports[i]).set_gearing(gearsets[i]);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_gearing(const pros::motor_gearset_e_t gearset, const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).set_gearing(gearset);
+}
+
+std::int32_t MotorGroup::set_gearing(std::vector<MotorGears> gearsets) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    for (std::size_t i = 0; i < _ports.size() && i < gearsets.size(); i++) Motor(_ports[i]).set_gearing(gearsets[i]);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_gearing(const MotorGears gearset, const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).set_gearing(gearset);
+}
+
+std::int32_t MotorGroup::set_gearing_all(const MotorGears gearset) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    for (std::int8_t port : _ports) Motor(port).set_gearing(gearset);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_gearing_all(const pros::motor_gearset_e_t gearset) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    for (std::int8_t port : _ports) Motor(port).set_gearing(gearset);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_reversed(const bool reverse, const std::uint8_t index) {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    _ports[index] = reverse ? -std::abs(_ports[index]) : std::abs(_ports[index]);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_reversed_all(const bool reverse) {
+    std::lock_guard lock(_MotorGroup_mutex);
+    for (std::int8_t port : _ports) Motor(port).set_reversed(reverse);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_voltage_limit(const std::int32_t limit, const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).set_voltage_limit(limit);
+}
+
+std::int32_t MotorGroup::set_voltage_limit_all(const std::int32_t limit) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    for (std::int8_t port : _ports) Motor(port).set_voltage_limit(limit);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_zero_position(const double position, const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).set_zero_position(position);
+}
+
+std::int32_t MotorGroup::set_zero_position_all(const double position) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    for (std::int8_t port : _ports) Motor(port).set_zero_position(position);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::tare_position(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR;
+    return Motor(_ports[index]).tare_position();
+}
+
+std::int32_t MotorGroup::tare_position_all(void) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    for (std::int8_t port : _ports) Motor(port).tare_position();
+    return PROS_SUCCESS;
+}
+
+std::int8_t MotorGroup::size() const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    return _ports.size();
+}
+
+std::int8_t MotorGroup::get_port(const std::uint8_t index) const {
+    std::lock_guard lock(_MotorGroup_mutex);
+    if (index >= _ports.size()) return PROS_ERR_BYTE;
+    return _ports[index];
+}
+
+void MotorGroup::operator+=(AbstractMotor& other) { append(other); }
+
+void MotorGroup::append(AbstractMotor& other) {
+    const std::vector<std::int8_t> ports = other.get_port_all();
+    std::lock_guard lock(_MotorGroup_mutex);
+    _ports.insert(_ports.end(), ports.begin(), ports.end());
+}
+
+void MotorGroup::erase_port(std::int8_t port) {
+    std::lock_guard lock(_MotorGroup_mutex);
+    std::erase_if(_ports, [port](std::int8_t p) { return std::abs(p) == std::abs(port); });
+}
+} // namespace v5
+} // namespace pros
@@ -0,0 +1,480 @@
+#include <algorithm>
+#include <cmath>
+#include "pros/error.h"
+#include "pros/motors.h"
+#include "pros/motors.hpp"
+#include "sim/world.hpp"
+
+namespace {
+/**
+ * @brief Lock the world, bring it up to date, and run a function on the state of a motor
+ *
+ * The function also receives the direction of the motor: -1 if the port is negative or the motor is reversed.
+ */
+template <typename F> auto withMotor(std::int8_t port, F&& function) {
+    sim::World& world = sim::world();
+    auto guard = world.lock();
+    world.advance();
+    sim::MotorState& motor = world.motor(port);
+    const int direction = (port < 0) != motor.reversed ? -1 : 1;
+    return function(motor, direction);
+}
+
+double ticksPerRev(std::int32_t gearset) {
+    switch (gearset) {
+        case pros::E_MOTOR_GEARSET_36: return 1800;
+        case pros::E_MOTOR_GEARSET_06: return 300;
+        default: return 900;
+    }
+}
+
+/**
+ * @brief Convert a shaft angle in degrees to the motor's encoder units
+ */
+double toUnits(const sim::MotorState& motor, double degrees) {
+    switch (motor.encoderUnits) {
+        case pros::E_MOTOR_ENCODER_ROTATIONS: return degrees / 360;
+        case pros::E_MOTOR_ENCODER_COUNTS: return degrees / 360 * ticksPerRev(motor.gearset);
+        default: return degrees;
+    }
+}
+
+/**
+ * @brief Convert a value in the motor's encoder units to a shaft angle in degrees
+ */
+double fromUnits(const sim::MotorState& motor, double value) { return value / toUnits(motor, 1); }
+} // namespace
+
+namespace pros::c {
+int32_t motor_move(int8_t port, int32_t voltage) {
+    if (voltage > 127) voltage = 127;
+    else if (voltage < -127) voltage = -127;
+    return motor_move_voltage(port, voltage * 12000 / 127);
+}
+
+int32_t motor_brake(int8_t port) { return motor_move_voltage(port, 0); }
+
+int32_t motor_move_absolute(int8_t port, double position, const int32_t velocity) {
+    return withMotor(port, [&](sim::MotorState& motor, int direction) {
+        motor.mode = sim::MotorMode::POSITION;
+        motor.targetPosition = direction * fromUnits(motor, position) + motor.zero;
+        motor.targetVelocity = std::abs(velocity);
+        return 1;
+    });
+}
+
+int32_t motor_move_relative(int8_t port, double position, const int32_t velocity) {
+    return withMotor(port, [&](sim::MotorState& motor, int direction) {
+        const double base = motor.mode == sim::MotorMode::POSITION ? motor.targetPosition : motor.position;
+        motor.mode = sim::MotorMode::POSITION;
+        motor.targetPosition = base + direction * fromUnits(motor, position);
+        motor.targetVelocity = std::abs(velocity);
+        return 1;
+    });
+}
+
+int32_t motor_move_velocity(int8_t port, const int32_t velocity) {
+    return withMotor(port, [&](sim::MotorState& motor, int direction) {
+        motor.mode = sim::MotorMode::VELOCITY;
+        motor.targetVelocity = direction * velocity;
+        return 1;
+    });
+}
+
+int32_t motor_move_voltage(int8_t port, const int32_t voltage) {
+    return withMotor(port, [&](sim::MotorState& motor, int direction) {
+        motor.mode = sim::MotorMode::VOLTAGE;
+        motor.targetVoltage = direction * std::clamp(voltage, -12000, 12000);
+        return 1;
+    });
+}
+
+int32_t motor_modify_profiled_velocity(int8_t port, const int32_t velocity) {
+    return withMotor(port, [&](sim::MotorState& motor, int direction) {
+        motor.targetVelocity = motor.mode == sim::MotorMode::POSITION ? std::abs(velocity) : direction * velocity;
+        return 1;
+    });
+}
+
+double motor_get_target_position(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int direction) {
+        return direction * toUnits(motor, motor.targetPosition - motor.zero);
+    });
+}
+
+int32_t motor_get_target_velocity(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int direction) { return direction * motor.targetVelocity; });
+}
+
+double motor_get_actual_velocity(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int direction) { return direction * motor.velocity; });
+}
+
+int32_t motor_get_current_draw(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int) { return int32_t(motor.current); });
+}
+
+int32_t motor_get_direction(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int direction) { return motor.velocity * direction < 0 ? -1 : 1; });
+}
+
+double motor_get_efficiency(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int) {
+        if (motor.voltage == 0 || motor.current == 0) return 0.0;
+        const double input = std::fabs(motor.voltage / 1000.0 * motor.current / 1000.0);
+        const double output = std::fabs(motor.torque * motor.velocity * 2 * M_PI / 60);
+        return std::clamp(output / input * 100, 0.0, 100.0);
+    });
+}
+
+int32_t motor_is_over_current(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int) { return int32_t(motor.current >= motor.currentLimit); });
+}
+
+int32_t motor_is_over_temp(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int) { return int32_t(motor.temperature >= 55); });
+}
+
+uint32_t motor_get_faults(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int) {
+        uint32_t faults = E_MOTOR_FAULT_NO_FAULTS;
+        if (motor.temperature >= 55) faults |= E_MOTOR_FAULT_MOTOR_OVER_TEMP;
+        if (motor.current >= motor.currentLimit) faults |= E_MOTOR_FAULT_OVER_CURRENT;
+        return faults;
+    });
+}
+
+uint32_t motor_get_flags(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int) {
+        uint32_t flags = E_MOTOR_FLAGS_NONE;
+        if (std::fabs(motor.velocity) < 1) flags |= E_MOTOR_FLAGS_ZERO_VELOCITY;
+        if (std::fabs(motor.position - motor.zero) < 1) flags |= E_MOTOR_FLAGS_ZERO_POSITION;
+        return flags;
+    });
+}
+
+int32_t motor_get_raw_position(int8_t port, uint32_t* const timestamp) {
+    return withMotor(port, [&](sim::MotorState& motor, int direction) {
+        if (timestamp != nullptr) *timestamp = millis();
+        return int32_t(direction * motor.position / 360 * ticksPerRev(motor.gearset));
+    });
+}
+
+double motor_get_position(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int direction) {
+        return direction * toUnits(motor, motor.position - motor.zero);
+    });
+}
+
+double motor_get_power(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int) {
+        return std::fabs(motor.voltage / 1000.0 * motor.current / 1000.0);
+    });
+}
+
+double motor_get_temperature(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int) { return motor.temperature; });
+}
+
+double motor_get_torque(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int) { return motor.torque; });
+}
+
+int32_t motor_get_voltage(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int direction) { return direction * motor.voltage; });
+}
+
+int32_t motor_set_zero_position(int8_t port, const double position) {
+    return withMotor(port, [&](sim::MotorState& motor, int direction) {
+        motor.zero = direction * fromUnits(motor, position);
+        return 1;
+    });
+}
+
+int32_t motor_tare_position(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int) {
+        motor.zero = motor.position;
+        return 1;
+    });
+}
+
+int32_t motor_set_brake_mode(int8_t port, const motor_brake_mode_e_t mode) {
+    return withMotor(port, [&](sim::MotorState& motor, int) {
+        motor.brakeMode = mode;
+        return 1;
+    });
+}
+
+int32_t motor_set_current_limit(int8_t port, const int32_t limit) {
+    return withMotor(port, [&](sim::MotorState& motor, int) {
+        motor.currentLimit = std::clamp(limit, 0, 2500);
+        return 1;
+    });
+}
+
+int32_t motor_set_encoder_units(int8_t port, const motor_encoder_units_e_t units) {
+    return withMotor(port, [&](sim::MotorState& motor, int) {
+        motor.encoderUnits = units;
+        return 1;
+    });
+}
+
+int32_t motor_set_gearing(int8_t port, const motor_gearset_e_t gearset) {
+    return withMotor(port, [&](sim::MotorState& motor, int) {
+        motor.gearset = gearset;
+        return 1;
+    });
+}
+
+int32_t motor_set_voltage_limit(int8_t port, const int32_t limit) {
+    return withMotor(port, [&](sim::MotorState& motor, int) {
+        motor.voltageLimit = std::clamp(limit, 0, 12000);
+        return 1;
+    });
+}
+
+motor_brake_mode_e_t motor_get_brake_mode(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int) { return motor_brake_mode_e_t(motor.brakeMode); });
+}
+
+int32_t motor_get_current_limit(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int) { return motor.currentLimit; });
+}
+
+motor_encoder_units_e_t motor_get_encoder_units(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int) { return motor_encoder_units_e_t(motor.encoderUnits); });
+}
+
+motor_gearset_e_t motor_get_gearing(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int) { return motor_gearset_e_t(motor.gearset); });
+}
+
+int32_t motor_get_voltage_limit(int8_t port) {
+    return withMotor(port, [&](sim::MotorState& motor, int) { return motor.voltageLimit; });
+}
+
+motor_type_e_t motor_get_type(int8_t port) { return E_MOTOR_TYPE_V5; }
+} // namespace pros::c
+
+namespace pros {
+inline namespace v5 {
+using namespace pros::c;
+
+Motor::Motor(const std::int8_t port, const pros::v5::MotorGears gearset, const pros::v5::MotorUnits encoder_units)
+    : Device(std::abs(port), DeviceType::motor),
+      _port(port) {
+    if (gearset != pros::v5::MotorGears::invalid) set_gearing(gearset);
+    if (encoder_units != pros::v5::MotorUnits::invalid) set_encoder_units(encoder_units);
+}
+
+std::int32_t Motor::move(std::int32_t voltage) const { return motor_move(_port, voltage); }
+
+std::int32_t Motor::move_absolute(const double position, const std::int32_t velocity) const {
+    return motor_move_absolute(_port, position, velocity);
+}
+
+std::int32_t Motor::move_relative(const double position, const std::int32_t velocity) const {
+    return motor_move_relative(_port, position, velocity);
+}
+
+std::int32_t Motor::move_velocity(const std::int32_t velocity) const { return motor_move_velocity(_port, velocity); }
+
+std::int32_t Motor::move_voltage(const std::int32_t voltage) const { return motor_move_voltage(_port, voltage); }
+
+std::int32_t Motor::brake(void) const { return motor_brake(_port); }
+
+std::int32_t Motor::modify_profiled_velocity(const std::int32_t velocity) const {
+    return motor_modify_profiled_velocity(_port, velocity);
+}
+
+double Motor::get_target_position(const std::uint8_t index) const { return motor_get_target_position(_port); }
+
+std::int32_t Motor::get_target_velocity(const std::uint8_t index) const { return motor_get_target_velocity(_port); }
+
+double Motor::get_actual_velocity(const std::uint8_t index) const { return motor_get_actual_velocity(_port); }
+
+std::int32_t Motor::get_current_draw(const std::uint8_t index) const { return motor_get_current_draw(_port); }
+
+std::int32_t Motor::get_direction(const std::uint8_t index) const { return motor_get_direction(_port); }
+
+double Motor::get_efficiency(const std::uint8_t index) const { return motor_get_efficiency(_port); }
+
+std::uint32_t Motor::get_faults(const std::uint8_t index) const { return motor_get_faults(_port); }
+
+std::uint32_t Motor::get_flags(const std::uint8_t index) const { return motor_get_flags(_port); }
+
+double Motor::get_position(const std::uint8_t index) const { return motor_get_position(_port); }
+
+double Motor::get_power(const std::uint8_t index) const { return motor_get_power(_port); }
+
+std::int32_t Motor::get_raw_position(std::uint32_t* const timestamp, const std::uint8_t index) const {
+    return motor_get_raw_position(_port, timestamp);
+}
+
+double Motor::get_temperature(const std::uint8_t index) const { return motor_get_temperature(_port); }
+
+double Motor::get_torque(const std::uint8_t index) const { return motor_get_torque(_port); }
+
+std::int32_t Motor::get_voltage(const std::uint8_t index) const { return motor_get_voltage(_port); }
+
+std::int32_t Motor::is_over_current(const std::uint8_t index) const { return motor_is_over_current(_port); }
+
+std::int32_t Motor::is_over_temp(const std::uint8_t index) const { return motor_is_over_temp(_port); }
+
+MotorBrake Motor::get_brake_mode(const std::uint8_t index) const {
+    return static_cast<MotorBrake>(motor_get_brake_mode(_port));
+}
+
+std::int32_t Motor::get_current_limit(const std::uint8_t index) const { return motor_get_current_limit(_port); }
+
+MotorUnits Motor::get_encoder_units(const std::uint8_t index) const {
+    return static_cast<MotorUnits>(motor_get_encoder_units(_port));
+}
+
+MotorGears Motor::get_gearing(const std::uint8_t index) const {
+    return static_cast<MotorGears>(motor_get_gearing(_port));
+}
+
+std::int32_t Motor::get_voltage_limit(const std::uint8_t index) const { return motor_get_voltage_limit(_port); }
+
+std::int32_t Motor::is_reversed(const std::uint8_t index) const { return _port < 0; }
+
+MotorType Motor::get_type(const std::uint8_t index) const { return static_cast<MotorType>(motor_get_type(_port)); }
+
+std::int32_t Motor::set_brake_mode(const MotorBrake mode, const std::uint8_t index) const {
+    return motor_set_brake_mode(_port, static_cast<motor_brake_mode_e_t>(mode));
+}
+
+std::int32_t Motor::set_brake_mode(const pros::motor_brake_mode_e_t mode, const std::uint8_t index) const {
+    return motor_set_brake_mode(_port, mode);
+}
+
+std::int32_t Motor::set_current_limit(const std::int32_t limit, const std::uint8_t index) const {
+    return motor_set_current_limit(_port, limit);
+}
+
+std::int32_t Motor::set_encoder_units(const MotorUnits units, const std::uint8_t index) const {
+    return motor_set_encoder_units(_port, static_cast<motor_encoder_units_e_t>(units));
+}
+
+std::int32_t Motor::set_encoder_units(const pros::motor_encoder_units_e_t units, const std::uint8_t index) const {
+    return motor_set_encoder_units(_port, units);
+}
+
+std::int32_t Motor::set_gearing(const MotorGears gearset, const std::uint8_t index) const {
+    return motor_set_gearing(_port, static_cast<motor_gearset_e_t>(gearset));
+}
+
+std::int32_t Motor::set_gearing(const pros::motor_gearset_e_t gearset, const std::uint8_t index) const {
+    return motor_set_gearing(_port, gearset);
+}
+
+std::int32_t Motor::set_reversed(const bool reverse, const std::uint8_t index) {
+    // the sign of the port is the reversal, so the stored port is rewritten
+    _port = reverse ? -std::abs(_port) : std::abs(_port);
+    return 1;
+}
+
+std::int32_t Motor::set_voltage_limit(const std::int32_t limit, const std::uint8_t index) const {
+    return motor_set_voltage_limit(_port, limit);
+}
+
+std::int32_t Motor::set_zero_position(const double position, const std::uint8_t index) const {
+    return motor_set_zero_position(_port, position);
+}
+
+std::int32_t Motor::tare_position(const std::uint8_t index) const { return motor_tare_position(_port); }
+
+std::int8_t Motor::size() const { return 1; }
+
+std::vector<Motor> Motor::get_all_devices() {
+    std::vector<Motor> motors;
+    for (std::uint8_t port = 1; port <= sim::PORT_COUNT; port++) {
+        if (Device::get_plugged_type(port) == DeviceType::motor) motors.push_back(Motor(port));
+    }
+    return motors;
+}
+
+std::int8_t Motor::get_port(const std::uint8_t index) const { return _port; }
+
+std::vector<double> Motor::get_target_position_all(void) const { return {get_target_position()}; }
+
+std::vector<std::int32_t> Motor::get_target_velocity_all(void) const { return {get_target_velocity()}; }
+
+std::vector<double> Motor::get_actual_velocity_all(void) const { return {get_actual_velocity()}; }
+
+std::vector<std::int32_t> Motor::get_current_draw_all(void) const { return {get_current_draw()}; }
+
+std::vector<std::int32_t> Motor::get_direction_all(void) const { return {get_direction()}; }
+
+std::vector<double> Motor::get_efficiency_all(void) const { return {get_efficiency()}; }
+
+std::vector<std::uint32_t> Motor::get_faults_all(void) const { return {get_faults()}; }
+
+std::vector<std::uint32_t> Motor::get_flags_all(void) const { return {get_flags()}; }
+
+std::vector<double> Motor::get_position_all(void) const { return {get_position()}; }
+
+std::vector<double> Motor::get_power_all(void) const { return {get_power()}; }
+
+std::vector<std::int32_t> Motor::get_raw_position_all(std::uint32_t* const timestamp) const {
+    return {get_raw_position(timestamp)};
+}
+
+std::vector<double> Motor::get_temperature_all(void) const { return {get_temperature()}; }
+
+std::vector<double> Motor::get_torque_all(void) const { return {get_torque()}; }
+
+std::vector<std::int32_t> Motor::get_voltage_all(void) const { return {get_voltage()}; }
+
+std::vector<std::int32_t> Motor::is_over_current_all(void) const { return {is_over_current()}; }
+
+std::vector<std::int32_t> Motor::is_over_temp_all(void) const { return {is_over_temp()}; }
+
+std::vector<MotorBrake> Motor::get_brake_mode_all(void) const { return {get_brake_mode()}; }
+
+std::vector<std::int32_t> Motor::get_current_limit_all(void) const { return {get_current_limit()}; }
+
+std::vector<MotorUnits> Motor::get_encoder_units_all(void) const { return {get_encoder_units()}; }
+
+std::vector<MotorGears> Motor::get_gearing_all(void) const { return {get_gearing()}; }
+
+std::vector<std::int8_t> Motor::get_port_all(void) const { return {_port}; }
+
+std::vector<std::int32_t> Motor::get_voltage_limit_all(void) const { return {get_voltage_limit()}; }
+
+std::vector<std::int32_t> Motor::is_reversed_all(void) const { return {is_reversed()}; }
+
+std::vector<MotorType> Motor::get_type_all(void) const { return {get_type()}; }
+
+std::int32_t Motor::set_brake_mode_all(const MotorBrake mode) const { return set_brake_mode(mode); }
+
+std::int32_t Motor::set_brake_mode_all(const pros::motor_brake_mode_e_t mode) const { return set_brake_mode(mode); }
+
+std::int32_t Motor::set_current_limit_all(const std::int32_t limit) const { return set_current_limit(limit); }
+
+std::int32_t Motor::set_encoder_units_all(const MotorUnits units) const { return set_encoder_units(units); }
+
+std::int32_t Motor::set_encoder_units_all(const pros::motor_encoder_units_e_t units) const {
+    return set_encoder_units(units);
+}
+
+std::int32_t Motor::set_gearing_all(const MotorGears gearset) const { return set_gearing(gearset); }
+
+std::int32_t Motor::set_gearing_all(const pros::motor_gearset_e_t gearset) const { return set_gearing(gearset); }
+
+std::int32_t Motor::set_reversed_all(const bool reverse) { return set_reversed(reverse); }
+
+std::int32_t Motor::set_voltage_limit_all(const std::int32_t limit) const { return set_voltage_limit(limit); }
+
+std::int32_t Motor::set_zero_position_all(const double position) const { return set_zero_position(position); }
+
+std::int32_t Motor::tare_position_all(void) const { return tare_position(); }
+
+namespace literals {
+const pros::Motor operator""_mtr(const unsigned long long int m) { return Motor(m); }
+
+const pros::Motor operator""_rmtr(const unsigned long long int m) { return Motor(-m); }
+} // namespace literals
+} // namespace v5
+} // namespace pros
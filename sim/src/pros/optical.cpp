@@ -0,0 +1,133 @@
+#include <cmath>
+#include "pros/error.h"
+#include "pros/optical.h"
+#include "pros/optical.hpp"
+#include "sim/world.hpp"
+
+namespace {
+/**
+ * @brief Lock the world and run a function on the state of an optical sensor
+ */
+template <typename F> auto withOptical(std::uint8_t port, F&& function) {
+    sim::World& world = sim::world();
+    auto guard = world.lock();
+    return function(world.optical(port));
+}
+} // namespace
+
+namespace pros::c {
+double optical_get_hue(uint8_t port) {
+    return withOptical(port, [](sim::OpticalState& optical) { return optical.hue; });
+}
+
+double optical_get_saturation(uint8_t port) {
+    return withOptical(port, [](sim::OpticalState& optical) { return optical.saturation; });
+}
+
+double optical_get_brightness(uint8_t port) {
+    return withOptical(port, [](sim::OpticalState& optical) { return optical.brightness; });
+}
+
+int32_t optical_get_proximity(uint8_t port) {
+    return withOptical(port, [](sim::OpticalState& optical) { return optical.proximity; });
+}
+
+int32_t optical_set_led_pwm(uint8_t port, uint8_t value) {
+    return withOptical(port, [&](sim::OpticalState& optical) {
+        optical.ledPwm = std::min<int32_t>(value, 100);
+        return PROS_SUCCESS;
+    });
+}
+
+int32_t optical_get_led_pwm(uint8_t port) {
+    return withOptical(port, [](sim::OpticalState& optical) { return optical.ledPwm; });
+}
+
+optical_rgb_s_t optical_get_rgb(uint8_t port) {
+    return withOptical(port, [](sim::OpticalState& optical) {
+        // hsv to rgb, scaled by brightness
+        const double h = optical.hue / 60;
+        const double c = optical.saturation * optical.brightness;
+        const double x = c * (1 - std::fabs(std::fmod(h, 2) - 1));
+        double r = 0, g = 0, b = 0;
+        if (h < 1) r = c, g = x;
+        else if (h < 2) r = x, g = c;
+        else if (h < 3) g = c, b = x;
+        else if (h < 4) g = x, b = c;
+        else if (h < 5) r = x, b = c;
+        else r = c, b = x;
+        const double m = optical.brightness - c;
+        return optical_rgb_s_t {(r + m) * 255, (g + m) * 255, (b + m) * 255, optical.brightness};
+    });
+}
+
+optical_raw_s_t optical_get_raw(uint8_t port) {
+    const optical_rgb_s_t rgb = optical_get_rgb(port);
+    return optical_raw_s_t {uint32_t((rgb.red + rgb.green + rgb.blue) * 4), uint32_t(rgb.red * 4),
+                            uint32_t(rgb.green * 4), uint32_t(rgb.blue * 4)};
+}
+
+optical_direction_e_t optical_get_gesture(uint8_t port) { return NO_GESTURE; }
+
+optical_gesture_s_t optical_get_gesture_raw(uint8_t port) { return optical_gesture_s_t {}; }
+
+int32_t optical_enable_gesture(uint8_t port) { return PROS_SUCCESS; }
+
+int32_t optical_disable_gesture(uint8_t port) { return PROS_SUCCESS; }
+
+double optical_get_integration_time(uint8_t port) {
+    return withOptical(port, [](sim::OpticalState& optical) { return optical.integrationTime; });
+}
+
+int32_t optical_set_integration_time(uint8_t port, double time) {
+    return withOptical(port, [&](sim::OpticalState& optical) {
+        optical.integrationTime = std::clamp(time, 3.0, 712.0);
+        return PROS_SUCCESS;
+    });
+}
+} // namespace pros::c
+
+namespace pros {
+inline namespace v5 {
+using namespace pros::c;
+
+Optical::Optical(const std::uint8_t port)
+    : Device(port, DeviceType::optical) {}
+
+std::vector<Optical> Optical::get_all_devices() {
+    std::vector<Optical> opticals;
+    for (std::uint8_t port = 1; port <= sim::PORT_COUNT; port++) {
+        if (Device::get_plugged_type(port) == DeviceType::optical) opticals.push_back(Optical(port));
+    }
+    return opticals;
+}
+
+double Optical::get_hue() { return optical_get_hue(_port); }
+
+double Optical::get_saturation() { return optical_get_saturation(_port); }
+
+double Optical::get_brightness() { return optical_get_brightness(_port); }
+
+std::int32_t Optical::get_proximity() { return optical_get_proximity(_port); }
+
+std::int32_t Optical::set_led_pwm(uint8_t value) { return optical_set_led_pwm(_port, value); }
+
+std::int32_t Optical::get_led_pwm() { return optical_get_led_pwm(_port); }
+
+pros::c::optical_rgb_s_t Optical::get_rgb() { return optical_get_rgb(_port); }
+
+pros::c::optical_raw_s_t Optical::get_raw() { return optical_get_raw(_port); }
+
+pros::c::optical_direction_e_t Optical::get_gesture() { return optical_get_gesture(_port); }
+
+pros::c::optical_gesture_s_t Optical::get_gesture_raw() { return optical_get_gesture_raw(_port); }
+
+std::int32_t Optical::enable_gesture() { return optical_enable_gesture(_port); }
+
+std::int32_t Optical::disable_gesture() { return optical_disable_gesture(_port); }
+
+double Optical::get_integration_time() { return optical_get_integration_time(_port); }
+
+std::int32_t Optical::set_integration_time(double time) { return optical_set_integration_time(_port, time); }
+} // namespace v5
+} // namespace pros
@@ -0,0 +1,128 @@
+#include <cmath>
+#include "pros/error.h"
+#include "pros/rotation.h"
+#include "pros/rotation.hpp"
+#include "sim/world.hpp"
+
+namespace {
+/**
+ * @brief Lock the world, bring it up to date, and run a function on the state of a rotation sensor
+ *
+ * Only the tracking wheel port is connected to the drivetrain, every other rotation sensor reads a stationary shaft.
+ * The function receives the raw position and velocity in centidegrees with the sensor's reversal applied.
+ */
+template <typename F> auto withRotation(std::uint8_t port, F&& function) {
+    sim::World& world = sim::world();
+    auto guard = world.lock();
+    world.advance();
+    sim::RotationState& rotation = world.rotation(port);
+    const bool tracking = port == world.getConfig().trackingPort;
+    const int direction = rotation.reversed ? -1 : 1;
+    const double position = tracking ? direction * world.trackingPosition() : 0;
+    const double velocity = tracking ? direction * world.trackingVelocity() : 0;
+    return function(rotation, position, velocity);
+}
+} // namespace
+
+namespace pros::c {
+int32_t rotation_reset(uint8_t port) {
+    return withRotation(port, [](sim::RotationState& rotation, double position, double) {
+        // the position resets to the current angle
+        rotation.offset = position - std::fmod(std::fmod(position, 36000) + 36000, 36000);
+        return PROS_SUCCESS;
+    });
+}
+
+int32_t rotation_set_data_rate(uint8_t port, uint32_t rate) {
+    return withRotation(port, [&](sim::RotationState& rotation, double, double) {
+        rotation.dataRate = std::max<uint32_t>(rate - rate % 5, 5);
+        return PROS_SUCCESS;
+    });
+}
+
+int32_t rotation_set_position(uint8_t port, int32_t position) {
+    return withRotation(port, [&](sim::RotationState& rotation, double raw, double) {
+        rotation.offset = raw - position;
+        return PROS_SUCCESS;
+    });
+}
+
+int32_t rotation_reset_position(uint8_t port) { return rotation_set_position(port, 0); }
+
+int32_t rotation_get_position(uint8_t port) {
+    return withRotation(port, [](sim::RotationState& rotation, double position, double) {
+        return int32_t(std::lround(position - rotation.offset));
+    });
+}
+
+int32_t rotation_get_velocity(uint8_t port) {
+    return withRotation(port, [](sim::RotationState&, double, double velocity) { return int32_t(velocity); });
+}
+
+int32_t rotation_get_angle(uint8_t port) {
+    return withRotation(port, [](sim::RotationState&, double position, double) {
+        return int32_t(std::fmod(std::fmod(position, 36000) + 36000, 36000));
+    });
+}
+
+int32_t rotation_set_reversed(uint8_t port, bool value) {
+    return withRotation(port, [&](sim::RotationState& rotation, double, double) {
+        // flipping the direction negates the reported position
+        if (rotation.reversed != value) rotation.offset = -rotation.offset;
+        rotation.reversed = value;
+        return PROS_SUCCESS;
+    });
+}
+
+int32_t rotation_reverse(uint8_t port) { return rotation_set_reversed(port, !rotation_get_reversed(port)); }
+
+int32_t rotation_init_reverse(uint8_t port, bool reverse_flag) {
+    return withRotation(port, [&](sim::RotationState& rotation, double, double) {
+        rotation.reversed = reverse_flag;
+        return PROS_SUCCESS;
+    });
+}
+
+int32_t rotation_get_reversed(uint8_t port) {
+    return withRotation(port, [](sim::RotationState& rotation, double, double) { return int32_t(rotation.reversed); });
+}
+} // namespace pros::c
+
+namespace pros {
+inline namespace v5 {
+using namespace pros::c;
+
+Rotation::Rotation(const std::int8_t port)
+    : Device(std::abs(port), DeviceType::rotation) {
+    rotation_init_reverse(_port, port < 0);
+}
+
+std::int32_t Rotation::reset() { return rotation_reset(_port); }
+
+std::int32_t Rotation::set_data_rate(std::uint32_t rate) const { return rotation_set_data_rate(_port, rate); }
+
+std::int32_t Rotation::set_position(std::int32_t position) const { return rotation_set_position(_port, position); }
+
+std::int32_t Rotation::reset_position(void) const { return rotation_reset_position(_port); }
+
+std::vector<Rotation> Rotation::get_all_devices() {
+    std::vector<Rotation> rotations;
+    for (std::uint8_t port = 1; port <= sim::PORT_COUNT; port++) {
+        if (Device::get_plugged_type(port) == DeviceType::rotation) rotations.push_back(Rotation(port));
+    }
+    return rotations;
+}
+
+std::int32_t Rotation::get_position() const { return rotation_get_position(_port); }
+
+std::int32_t Rotation::get_velocity() const { return rotation_get_velocity(_port); }
+
+std::int32_t Rotation::get_angle() const { return rotation_get_angle(_port); }
+
+std::int32_t Rotation::set_reversed(bool value) const { return rotation_set_reversed(_port, value); }
+
+std::int32_t Rotation::reverse() const { return rotation_reverse(_port); }
+
+std::int32_t Rotation::get_reversed() const { return rotation_get_reversed(_port); }
+} // namespace v5
+} // namespace pros
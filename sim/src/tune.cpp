@@ -0,0 +1,288 @@
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <fcntl.h>
+#include <limits>
+#include <map>
+#include <random>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "lemlib/util.hpp"
+#include "pros/rtos.hpp"
+#include "sim/kernel.hpp"
+#include "sim/tune.hpp"
+
+namespace sim {
+namespace {
+constexpr std::uint32_t SAMPLE_PERIOD = 10; // milliseconds
+
+/**
+ * @brief A step the robot is asked to make, and how long it gets to settle
+ */
+struct Step {
+        float size; // inches or degrees
+        std::uint32_t window; // milliseconds
+};
+
+constexpr Step LATERAL_STEPS[] = {{6, 1000}, {12, 1250}, {24, 1500}, {48, 2000}};
+constexpr Step ANGULAR_STEPS[] = {{15, 750}, {45, 1000}, {90, 1250}, {180, 1500}};
+
+/**
+ * @brief Gains being searched over, in the order kP, kI, kD, windup range
+ */
+using Gains = std::array<float, 4>;
+
+/**
+ * @brief Round to 4 significant digits, so the printed gains are the ones that were evaluated
+ */
+float round4(float value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.4g", value);
+    return std::strtof(text, nullptr);
+}
+
+Gains round4(Gains gains) {
+    for (float& gain : gains) gain = round4(gain);
+    gains[3] = std::max(gains[3], 0.0f);
+    return gains;
+}
+
+lemlib::ControllerSettings withGains(lemlib::ControllerSettings settings, const Gains& gains) {
+    settings.kP = gains[0];
+    settings.kI = gains[1];
+    settings.kD = gains[2];
+    settings.windupRange = gains[3];
+    return settings;
+}
+
+/**
+ * @brief Score the response to a single step from how the error changed over time
+ *
+ * The error is positive before reaching the target, so overshoot is how far it went negative.
+ */
+void scoreStep(const std::vector<float>& errors, float tolerance, float maxOvershoot, std::uint32_t window,
+               TuneScore& score) {
+    float overshoot = 0;
+    std::size_t settled = 0;
+    for (std::size_t i = 0; i < errors.size(); i++) {
+        overshoot = std::max(overshoot, -errors[i]);
+        if (std::fabs(errors[i]) > tolerance) settled = i + 1;
+    }
+    const bool unsettled = settled == errors.size();
+    score.settleTime += settled * SAMPLE_PERIOD;
+    score.overshoot = std::max(score.overshoot, overshoot);
+    score.unsettled += unsettled;
+    // a step that never settles costs twice its window, and overshooting costs a window per allowed overshoot
+    score.cost += settled * SAMPLE_PERIOD + (unsettled ? window : 0) +
+                  std::max(overshoot - maxOvershoot, 0.0f) / maxOvershoot * window;
+}
+
+/**
+ * @brief Sample the error of the running motion every sample period until the window closes, then stop it
+ */
+template <typename F> std::vector<float> sampleStep(lemlib::Chassis& chassis, std::uint32_t window, F&& error) {
+    std::vector<float> errors;
+    std::uint32_t time = pros::millis();
+    for (std::uint32_t elapsed = 0; elapsed < window; elapsed += SAMPLE_PERIOD) {
+        pros::Task::delay_until(&time, SAMPLE_PERIOD);
+        errors.push_back(error(chassis.getPose()));
+    }
+    chassis.cancelAllMotions();
+    chassis.waitUntilDone();
+    return errors;
+}
+
+/**
+ * @brief Run the step tests on a fresh chassis and score them
+ *
+ * Lateral steps drive forward then back along the y axis, angular steps turn away from heading 0 and back.
+ */
+TuneScore runSteps(const lemlib::Drivetrain& drivetrain, const lemlib::ControllerSettings& lateral,
+                   const lemlib::ControllerSettings& angular, const lemlib::OdomSensors& sensors,
+                   const TuneOptions& options) {
+    // never destroyed, the process exits when it's done
+    auto* chassis = new lemlib::Chassis(drivetrain, lateral, angular, sensors);
+    chassis->calibrate();
+    TuneScore score {0, 0, 0, 0};
+
+    if (options.controller == TuneController::LATERAL) {
+        for (const Step& step : LATERAL_STEPS) {
+            for (const float target : {step.size, 0.0f}) {
+                const float start = chassis->getPose().y;
+                const float direction = target > start ? 1 : -1;
+                chassis->moveToPoint(0, target, step.window, {.forwards = direction > 0});
+                const auto errors = sampleStep(*chassis, step.window, [&](lemlib::Pose pose) {
+                    return (target - pose.y) * direction;
+                });
+                scoreStep(errors, lateral.smallError, options.maxOvershoot, step.window, score);
+            }
+        }
+    } else {
+        for (const Step& step : ANGULAR_STEPS) {
+            for (const float heading : {step.size, 0.0f}) {
+                // turnToHeading takes the shortest way round, so unwrap the target the same way
+                const float start = chassis->getPose().theta;
+                const float target = start + lemlib::angleError(heading, start, false);
+                const float direction = target > start ? 1 : -1;
+                chassis->turnToHeading(heading, step.window);
+                const auto errors = sampleStep(*chassis, step.window, [&](lemlib::Pose pose) {
+                    return (target - pose.theta) * direction;
+                });
+                scoreStep(errors, angular.smallError, options.maxOvershoot, step.window, score);
+            }
+        }
+    }
+    return score;
+}
+
+/**
+ * @brief Evaluate a batch of candidates, each in its own process, keeping up to the given number running at once
+ *
+ * A candidate whose process fails gets an infinite cost.
+ */
+std::vector<TuneScore> evaluate(const std::vector<Gains>& candidates, const lemlib::Drivetrain& drivetrain,
+                                const lemlib::ControllerSettings& lateral, const lemlib::ControllerSettings& angular,
+                                const lemlib::OdomSensors& sensors, const TuneOptions& options, int jobs) {
+    const float infinity = std::numeric_limits<float>::infinity();
+    std::vector<TuneScore> scores(candidates.size(), TuneScore {infinity, infinity, infinity, 0});
+    std::map<pid_t, std::pair<std::size_t, int>> running; // process to candidate index and pipe
+    std::size_t next = 0;
+    while (next < candidates.size() || !running.empty()) {
+        if (next < candidates.size() && running.size() < std::size_t(jobs)) {
+            int fds[2];
+            if (pipe(fds) != 0) std::abort();
+            std::fflush(nullptr);
+            const pid_t pid = fork();
+            if (pid == 0) {
+                close(fds[0]);
+                // keep the program's logging out of the way of the results
+                const int null = open("/dev/null", O_WRONLY);
+                dup2(null, STDOUT_FILENO);
+                const Gains& gains = candidates[next];
+                const bool tuningLateral = options.controller == TuneController::LATERAL;
+                const TuneScore score =
+                    runSteps(drivetrain, tuningLateral ? withGains(lateral, gains) : lateral,
+                             tuningLateral ? angular : withGains(angular, gains), sensors, options);
+                // small enough that the write is atomic
+                const bool written = write(fds[1], &score, sizeof(score)) == sizeof(score);
+                _exit(written ? 0 : 1);
+            }
+            close(fds[1]);
+            if (pid < 0) {
+                close(fds[0]);
+                next++;
+                continue;
+            }
+            running[pid] = {next++, fds[0]};
+            continue;
+        }
+        int status;
+        const pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        const auto it = running.find(pid);
+        if (it == running.end()) continue;
+        const auto [index, fd] = it->second;
+        TuneScore score;
+        ssize_t size;
+        do size = read(fd, &score, sizeof(score));
+        while (size < 0 && errno == EINTR);
+        if (size == sizeof(score) && WIFEXITED(status) && WEXITSTATUS(status) == 0) scores[index] = score;
+        close(fd);
+        running.erase(it);
+    }
+    return scores;
+}
+
+void logCandidate(std::FILE* log, const char* label, const Gains& gains, const TuneScore& score) {
+    if (log == nullptr) return;
+    std::fprintf(log, "%-10s kP %-8.4g kI %-8.4g kD %-8.4g windup %-8.4g cost %8.0f settle %6.0f overshoot %5.2f%s\n",
+                 label, gains[0], gains[1], gains[2], gains[3], score.cost, score.settleTime, score.overshoot,
+                 score.unsettled > 0 ? " unsettled" : "");
+}
+} // namespace
+
+TuneResult tune(const lemlib::Drivetrain& drivetrain, const lemlib::ControllerSettings& lateral,
+                const lemlib::ControllerSettings& angular, const lemlib::OdomSensors& sensors,
+                const TuneOptions& options) {
+    // the coordinator never makes kernel calls, it mustn't be taken for a spinning task and moved along in time
+    PreemptGuard guard;
+    const int jobs = options.jobs > 0 ? options.jobs : std::max<int>(std::thread::hardware_concurrency(), 1);
+    const lemlib::ControllerSettings& start =
+        options.controller == TuneController::LATERAL ? lateral : angular;
+    const auto run = [&](const std::vector<Gains>& candidates) {
+        return evaluate(candidates, drivetrain, lateral, angular, sensors, options, jobs);
+    };
+
+    // scale of each gain, for the random candidates and the first refinement steps
+    const float kP = start.kP != 0 ? std::fabs(start.kP) : 1;
+    const Gains scale = {kP, kP / 50, start.kD != 0 ? std::fabs(start.kD) : kP * 5,
+                         start.windupRange != 0 ? start.windupRange : start.smallError * 3};
+
+    // random candidates around the starting gains, log uniform over a factor of 4 either way
+    std::mt19937 random(options.seed);
+    std::uniform_real_distribution<float> unit(-1, 1);
+    std::vector<Gains> candidates = {round4({start.kP, start.kI, start.kD, start.windupRange})};
+    for (int i = 0; i < options.samples; i++) {
+        const float kPSample = scale[0] * std::pow(4.0f, unit(random));
+        const float kISample = scale[1] * unit(random);
+        const float kDSample = scale[2] * std::pow(4.0f, unit(random));
+        const float windupSample = scale[3] * std::pow(4.0f, unit(random));
+        candidates.push_back(round4({kPSample, kISample, kDSample, windupSample}));
+    }
+    std::vector<TuneScore> scores = run(candidates);
+    TuneResult result {start, scores[0], scores[0], int(candidates.size())};
+    Gains best = candidates[0];
+    // ties go to the earliest candidate, so the order results arrive in doesn't matter
+    for (std::size_t i = 0; i < candidates.size(); i++) {
+        logCandidate(options.log, i == 0 ? "start" : "sample", candidates[i], scores[i]);
+        if (scores[i].cost < result.score.cost) {
+            result.score = scores[i];
+            best = candidates[i];
+        }
+    }
+
+    // pattern search: try a step either way along each gain, move to the best one, and halve the steps if none helped
+    Gains steps = {0.5, scale[1], 0.5, scale[3] / 2};
+    for (int iteration = 0; iteration < options.iterations; iteration++) {
+        candidates.clear();
+        for (std::size_t gain = 0; gain < best.size(); gain++) {
+            for (const float sign : {1.0f, -1.0f}) {
+                Gains candidate = best;
+                // kP and kD are stepped by a factor, kI and windup range by an amount
+                if (gain == 0 || gain == 2) candidate[gain] *= sign > 0 ? 1 + steps[gain] : 1 / (1 + steps[gain]);
+                else candidate[gain] += sign * steps[gain];
+                candidate = round4(candidate);
+                if (candidate != best) candidates.push_back(candidate);
+            }
+        }
+        if (candidates.empty()) break;
+        scores = run(candidates);
+        result.evaluations += candidates.size();
+        std::size_t improved = candidates.size();
+        for (std::size_t i = 0; i < candidates.size(); i++) {
+            if (scores[i].cost < result.score.cost) {
+                result.score = scores[i];
+                improved = i;
+            }
+        }
+        if (improved < candidates.size()) {
+            best = candidates[improved];
+            char label[32];
+            std::snprintf(label, sizeof(label), "round %d", iteration + 1);
+            logCandidate(options.log, label, best, result.score);
+        } else {
+            for (float& step : steps) step /= 2;
+        }
+    }
+
+    result.settings = withGains(start, best);
+    return result;
+}
+} // namespace sim
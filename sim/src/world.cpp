@@ -0,0 +1,258 @@
+#include <algorithm>
+#include <cmath>
+#include "sim/kernel.hpp"
+#include "sim/world.hpp"
+
+namespace sim {
+namespace {
+// pros::DeviceType values
+constexpr int DEVICE_MOTOR = 2;
+constexpr int DEVICE_ROTATION = 4;
+constexpr int DEVICE_IMU = 6;
+constexpr int DEVICE_OPTICAL = 16;
+constexpr int DEVICE_GPS = 20;
+
+// 11W motor characteristics at the motor, before the cartridge
+constexpr double STALL_CURRENT = 2500; // mA
+constexpr double STALL_TORQUE = 2.1 / 36.0; // Nm
+constexpr double THERMAL_GAIN = 0.0000035; // degrees per second per mA^2
+constexpr double THERMAL_TAU = 300; // seconds
+constexpr double AMBIENT = 25; // degrees celsius
+
+int index(int port) { return std::clamp(std::abs(port), 1, PORT_COUNT) - 1; }
+
+double cartridgeRatio(std::int32_t gearset) {
+    switch (gearset) {
+        case 0: return 36;
+        case 2: return 6;
+        default: return 18;
+    }
+}
+
+/**
+ * @brief Resistance of a motor's windings, as a multiple of what it is at 25 degrees
+ */
+double resistance(const MotorState& motor, double tempco) { return 1 + tempco * (motor.temperature - AMBIENT); }
+
+/**
+ * @brief Run the motor's internal controller to get the voltage applied this step
+ *
+ * The motor can't apply more than the battery supplies.
+ */
+void updateOutput(MotorState& motor, double freeRpm, double battery) {
+    double voltage = motor.targetVoltage;
+    if (motor.mode != MotorMode::VOLTAGE) {
+        double velocity = motor.targetVelocity;
+        // move_absolute and move_relative use a trapezoidal profile, approximated by a clamped P controller
+        if (motor.mode == MotorMode::POSITION)
+            velocity = std::clamp(10 * (motor.targetPosition - motor.position), -std::fabs(velocity),
+                                  std::fabs(velocity));
+        voltage = (velocity / freeRpm + (velocity - motor.velocity) / freeRpm * 4) * 12000;
+    }
+    double limit = motor.voltageLimit > 0 ? std::min(motor.voltageLimit, 12000) : 12000;
+    limit = std::min(limit, battery);
+    motor.voltage = std::clamp(voltage, -limit, limit);
+}
+
+/**
+ * @brief Update the current, torque and temperature of a motor from its voltage and speed
+ */
+void updateElectrical(MotorState& motor, double freeRpm, double tempco, double dt) {
+    const double command = motor.voltage / 12000.0;
+    const double speed = motor.velocity / freeRpm;
+    const double current = std::clamp(std::fabs(command - speed) * STALL_CURRENT / resistance(motor, tempco), 0.0,
+                                      double(std::max(motor.currentLimit, 0)));
+    motor.current = current;
+    motor.torque = current / STALL_CURRENT * STALL_TORQUE * cartridgeRatio(motor.gearset);
+    motor.temperature += (THERMAL_GAIN * current * current - (motor.temperature - AMBIENT) / THERMAL_TAU) * dt;
+}
+} // namespace
+
+World::World() { configure(RobotConfig()); }
+
+World::Lock::Lock(World& world)
+    : world(world) {
+    if (world.depth++ == 0) {
+        world.deviceCalls++;
+        charge(DEVICE_CALL_COST);
+    }
+}
+
+World::Lock::~Lock() { world.depth--; }
+
+World::Lock World::lock() { return Lock(*this); }
+
+std::uint64_t World::getDeviceCalls() const { return deviceCalls; }
+
+void World::configure(const RobotConfig& config) {
+    auto guard = lock();
+    this->config = config;
+    pluggedTypes.fill(0);
+    for (int port : config.leftPorts) pluggedTypes.at(index(port)) = DEVICE_MOTOR;
+    for (int port : config.rightPorts) pluggedTypes.at(index(port)) = DEVICE_MOTOR;
+    for (int port : config.freeMotorPorts) pluggedTypes.at(index(port)) = DEVICE_MOTOR;
+    pluggedTypes.at(index(config.imuPort)) = DEVICE_IMU;
+    pluggedTypes.at(index(config.trackingPort)) = DEVICE_ROTATION;
+    pluggedTypes.at(index(config.opticalPort)) = DEVICE_OPTICAL;
+    if (config.gpsPort != 0) pluggedTypes.at(index(config.gpsPort)) = DEVICE_GPS;
+    for (MotorState& motor : motors) motor.temperature = config.motorTemperature;
+    battery = config.batteryVoltage;
+    minBattery = battery;
+}
+
+const RobotConfig& World::getConfig() const { return config; }
+
+void World::advance() {
+    auto guard = lock();
+    const std::uint64_t time = now();
+    while (lastTime + 1000 <= time) {
+        step(0.001);
+        lastTime += 1000;
+    }
+}
+
+void World::stepSide(const std::vector<int>& ports, int mount, double& velocity, double& wheelVelocity, double dt) {
+    const double maxSpeed = config.wheelRpm / 60 * M_PI * config.wheelDiameter;
+    // each motor pushes towards the speed its voltage would hold, harder the cooler it is
+    double effort = 0;
+    bool stopped = true;
+    std::int32_t brakeMode = 0;
+    for (int port : ports) {
+        const MotorState& state = motor(port);
+        effort +=
+            (mount * state.voltage / 12000.0 * maxSpeed - wheelVelocity) / resistance(state, config.windingTempco);
+        if (state.voltage != 0) stopped = false;
+        brakeMode = std::max(brakeMode, state.brakeMode);
+    }
+    if (!ports.empty()) effort /= ports.size();
+
+    const double slip = wheelVelocity - velocity;
+    if (stopped) {
+        // stopped motors hold the wheels to the ground
+        double accel = -velocity / (brakeMode == 0 ? config.coastTau : config.brakeTau);
+        accel = std::clamp(accel, -config.tractionLimit, config.tractionLimit);
+        // don't let braking overshoot past zero
+        if (std::fabs(accel * dt) > std::fabs(velocity)) velocity = 0;
+        else velocity += accel * dt;
+        wheelVelocity = velocity;
+    } else if (slip == 0 && std::fabs(effort / config.driveTau) <= config.tractionLimit) {
+        velocity += effort / config.driveTau * dt;
+        wheelVelocity = velocity;
+    } else {
+        // the wheels have broken traction. The ground pushes the robot towards the speed of the wheels, and holds the
+        // wheels back just as hard, so the motors spin them up against little more than their own inertia
+        const double direction = slip != 0 ? (slip > 0 ? 1 : -1) : (effort > 0 ? 1 : -1);
+        const double accel = direction * config.slipTraction;
+        const double wheelAccel = ((1 + config.wheelInertia) * effort / config.driveTau - accel) / config.wheelInertia;
+        velocity += accel * dt;
+        wheelVelocity += wheelAccel * dt;
+        // the wheels grip again once they're back down to the speed of the ground
+        if ((wheelVelocity - velocity) * direction <= 0) {
+            velocity = (velocity + config.wheelInertia * wheelVelocity) / (1 + config.wheelInertia);
+            wheelVelocity = velocity;
+        }
+    }
+
+    // shaft speed of each motor on this side
+    const double wheelRpm = wheelVelocity / (M_PI * config.wheelDiameter) * 60;
+    const double shaftRpm = mount * wheelRpm * config.motorRpm / config.wheelRpm;
+    for (int port : ports) {
+        MotorState& state = motor(port);
+        state.velocity = shaftRpm;
+        state.position += shaftRpm / 60 * 360 * dt;
+        updateElectrical(state, config.motorRpm, config.windingTempco, dt);
+    }
+}
+
+void World::stepFreeMotor(MotorState& motor, double dt) {
+    const double freeRpm = 3600 / cartridgeRatio(motor.gearset);
+    double target = motor.voltage / 12000.0 * freeRpm;
+    double tau = config.freeMotorTau;
+    if (motor.voltage == 0) {
+        target = 0;
+        if (motor.brakeMode == 0) tau *= 10;
+    }
+    // a jam holds the motor still until it's driven back out the other way
+    if (motor.jam != 0 && motor.voltage * motor.jam < 0) motor.jam = 0;
+    if (motor.jam != 0) motor.velocity = 0;
+    else motor.velocity += (target - motor.velocity) / tau * dt;
+    motor.position += motor.velocity / 60 * 360 * dt;
+    updateElectrical(motor, freeRpm, config.windingTempco, dt);
+}
+
+void World::step(double dt) {
+    for (int port : config.leftPorts) updateOutput(motor(port), config.motorRpm, battery);
+    for (int port : config.rightPorts) updateOutput(motor(port), config.motorRpm, battery);
+    for (int port : config.freeMotorPorts)
+        updateOutput(motor(port), 3600 / cartridgeRatio(motor(port).gearset), battery);
+    stepSide(config.leftPorts, config.leftMount, leftVelocity, leftWheelVelocity, dt);
+    stepSide(config.rightPorts, config.rightMount, rightVelocity, rightWheelVelocity, dt);
+    if (leftWheelVelocity != leftVelocity || rightWheelVelocity != rightVelocity) slipping += dt;
+    for (int port : config.freeMotorPorts) stepFreeMotor(motor(port), dt);
+
+    // the battery sags under the current the motors draw, which limits them on the next step
+    double current = 0;
+    for (const MotorState& motor : motors) current += motor.current;
+    battery = config.batteryVoltage - current * config.batteryResistance;
+    minBattery = std::min(minBattery, battery);
+
+    // differential drive kinematics, heading measured clockwise
+    omega = (leftVelocity - rightVelocity) / config.trackWidth;
+    const double speed = (leftVelocity + rightVelocity) / 2;
+    const double midTheta = theta + omega * dt / 2;
+    x += speed * std::sin(midTheta) * dt;
+    y += speed * std::cos(midTheta) * dt;
+    theta += omega * dt;
+    leftDistance += leftVelocity * dt;
+    rightDistance += rightVelocity * dt;
+
+    // a wheel offset to the left moves faster when turning clockwise
+    trackingSpeed = speed - config.trackingOffset * omega;
+    trackingDistance += trackingSpeed * dt;
+}
+
+std::array<double, 3> World::truePose() {
+    auto guard = lock();
+    advance();
+    return {x, y, theta * 180 / M_PI};
+}
+
+void World::setTruePose(double x, double y, double theta) {
+    auto guard = lock();
+    advance();
+    this->x = x;
+    this->y = y;
+    this->theta = theta * M_PI / 180;
+}
+
+MotorState& World::motor(int port) { return motors.at(index(port)); }
+
+ImuState& World::imu(int port) { return imus.at(index(port)); }
+
+RotationState& World::rotation(int port) { return rotations.at(index(port)); }
+
+OpticalState& World::optical(int port) { return opticals.at(index(port)); }
+
+GpsState& World::gps(int port) { return gpses.at(index(port)); }
+
+AdiState& World::adi(int port) { return adiPorts.at(std::clamp(port, 1, ADI_PORT_COUNT) - 1); }
+
+int World::pluggedType(int port) const { return pluggedTypes.at(index(port)); }
+
+double World::imuRotation() { return theta * 180 / M_PI; }
+
+double World::trackingPosition() { return trackingDistance / (M_PI * config.trackingDiameter) * 36000; }
+
+double World::trackingVelocity() { return trackingSpeed / (M_PI * config.trackingDiameter) * 36000; }
+
+double World::batteryVoltage() const { return battery; }
+
+double World::minBatteryVoltage() const { return minBattery; }
+
+double World::slipTime() const { return slipping; }
+
+World& world() {
+    static World world;
+    return world;
+}
+} // namespace sim
@@ -0,0 +1,137 @@
+#include <array>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "pros/rtos.hpp"
+#include "sim/kernel.hpp"
+#include "lemlib/logger/buffer.hpp"
+
+namespace {
+constexpr int OVERFILL = 8; // messages pushed past a full buffer
+constexpr int PRODUCERS = 3;
+constexpr int PRODUCED = 200; // messages each producer pushes
+
+int failures = 0;
+
+/**
+ * @brief A buffer that keeps everything it processes
+ */
+class Recorder : public lemlib::Buffer {
+    public:
+        Recorder(lemlib::OverflowPolicy policy)
+            : Buffer([this](const std::string& message) { received.push_back(message); }) {
+            setRate(1);
+            setOverflowPolicy(policy);
+        }
+
+        using Buffer::start;
+
+        /**
+         * @brief Start the task if it isn't running, and wait for it to process everything pushed
+         */
+        void drain() {
+            start();
+            for (int i = 0; i < 1000 && !buffersEmpty(); i++) pros::delay(1);
+        }
+
+        std::vector<std::string> received;
+};
+
+/**
+ * @brief Fill a buffer past full before its task starts, and check which messages it keeps
+ *
+ * @param first the first message that should be kept
+ */
+void checkOverflow(const char* name, lemlib::OverflowPolicy policy, int first) {
+    Recorder buffer(policy);
+    {
+        // pushing makes no kernel calls
+        sim::PreemptGuard guard;
+        for (int i = 0; i < int(lemlib::Buffer::SLOT_COUNT) + OVERFILL; i++) buffer.pushToBuffer(std::to_string(i));
+    }
+    buffer.drain();
+    bool kept = buffer.received.size() == lemlib::Buffer::SLOT_COUNT;
+    for (std::size_t i = 0; kept && i < buffer.received.size(); i++)
+        kept = buffer.received[i] == std::to_string(first + i);
+    if (!kept || buffer.getDropped() != OVERFILL || buffer.getHighWaterMark() != lemlib::Buffer::SLOT_COUNT) {
+        std::printf("%s kept %zu messages from %s, dropped %u, and held at most %u\n", name, buffer.received.size(),
+                    buffer.received.empty() ? "none" : buffer.received.front().c_str(), buffer.getDropped(),
+                    buffer.getHighWaterMark());
+        failures++;
+    }
+}
+} // namespace
+
+/**
+ * @brief Check the logger's buffer keeps the right messages when it overflows under each policy, counts what it drops
+ * and cuts short, joins batches without splitting messages, and loses nothing it doesn't count when several tasks push
+ * faster than it's processed
+ */
+int main() {
+    checkOverflow("dropping the newest", lemlib::OverflowPolicy::DROP_NEWEST, 0);
+    checkOverflow("dropping the oldest", lemlib::OverflowPolicy::DROP_OLDEST, OVERFILL);
+
+    Recorder truncating(lemlib::OverflowPolicy::DROP_NEWEST);
+    const std::size_t tooLong = lemlib::Buffer::SLOT_SIZE + 46;
+    truncating.pushToBuffer(std::string(tooLong, 'x'));
+    truncating.drain();
+    if (truncating.getTruncated() != 1 || truncating.received.size() != 1 ||
+        truncating.received[0] != std::string(lemlib::Buffer::SLOT_SIZE, 'x')) {
+        std::printf("a %zu byte message was cut short %u times\n", tooLong, truncating.getTruncated());
+        failures++;
+    }
+
+    Recorder batching(lemlib::OverflowPolicy::DROP_NEWEST);
+    batching.setBatchSize(10);
+    for (const char* message : {"aaaa", "bbbb", "cccc", "dddddddddddddd", "ee"}) batching.pushToBuffer(message);
+    batching.drain();
+    const std::vector<std::string> batches = {"aaaabbbb", "cccc", "dddddddddddddd", "ee"};
+    if (batching.received != batches) {
+        std::printf("batches of 10 bytes were:");
+        for (const std::string& batch : batching.received) std::printf(" \"%s\"", batch.c_str());
+        std::printf("\n");
+        failures++;
+    }
+
+    // producers push 3 messages a millisecond each, and the buffer processes one
+    Recorder contended(lemlib::OverflowPolicy::DROP_OLDEST);
+    contended.start();
+    std::vector<pros::Task> producers;
+    for (int p = 0; p < PRODUCERS; p++) {
+        producers.emplace_back([&contended, p] {
+            for (int i = 0; i < PRODUCED; i++) {
+                contended.pushToBuffer(std::to_string(p * PRODUCED + i));
+                if (i % 3 == 2) pros::delay(1);
+            }
+        });
+    }
+    pros::delay(PRODUCED);
+    contended.drain();
+    std::array<int, PRODUCERS> last;
+    last.fill(-1);
+    int outOfOrder = 0;
+    for (const std::string& message : contended.received) {
+        const int value = std::stoi(message);
+        int& previous = last[value / PRODUCED];
+        outOfOrder += value % PRODUCED <= previous;
+        previous = value % PRODUCED;
+    }
+    if (contended.received.size() + contended.getDropped() != PRODUCERS * PRODUCED || outOfOrder != 0 ||
+        contended.getHighWaterMark() > lemlib::Buffer::SLOT_COUNT) {
+        std::printf("%d producers pushed %d messages, %zu were processed, %d out of order, %u dropped, and at most %u "
+                    "were held\n",
+                    PRODUCERS, PRODUCERS * PRODUCED, contended.received.size(), outOfOrder, contended.getDropped(),
+                    contended.getHighWaterMark());
+        failures++;
+    }
+
+    std::fflush(stdout);
+    // the buffers' tasks are still running, so leave without destroying them
+    if (failures != 0) _exit(1);
+    std::printf("logger buffer: overflow policies, truncation and batching ok, %zu of %d messages processed with %d "
+                "producers\n",
+                contended.received.size(), PRODUCERS * PRODUCED, PRODUCERS);
+    std::fflush(stdout);
+    _exit(0);
+}
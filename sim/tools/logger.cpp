@@ -0,0 +1,195 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <unistd.h>
+#include "lemlib/logger/baseSink.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr int MESSAGES = 200000;
+constexpr const char* FORMAT = "[LemLib] {level}: {message}"; // what the info sink uses
+
+std::atomic<long> allocations = 0;
+
+/**
+ * @brief What a sink sends is counted, and checked against the text it should be when one is set
+ */
+struct Output {
+        const char* format;
+        long bytes = 0;
+        const std::string* expected = nullptr;
+        long mismatches = 0;
+        std::string mismatch; // the first message that didn't match
+
+        void receive(const std::string& message) {
+            bytes += message.size();
+            if (expected == nullptr || message == *expected) return;
+            if (mismatches++ == 0) mismatch = message;
+        }
+};
+
+/**
+ * @brief A sink that only counts what it's sent, so the time measured is formatting
+ */
+class CountingSink : public lemlib::BaseSink {
+    public:
+        CountingSink(const char* format)
+            : output {format} {
+            setFormat(format);
+            setLowestLevel(lemlib::Level::INFO);
+        }
+
+        Output output;
+    private:
+        void sendMessage(const lemlib::Message& message) override { output.receive(message.message); }
+};
+
+/**
+ * @brief The counting sink with an extra formatting argument, which can't be compiled
+ */
+class ExtraArgSink : public CountingSink {
+    public:
+        ExtraArgSink()
+            : CountingSink("[LemLib] {level} {zero}: {message}") {}
+    private:
+        fmt::dynamic_format_arg_store<fmt::format_context>
+        getExtraFormattingArgs(const lemlib::Message& messageInfo) override {
+            fmt::dynamic_format_arg_store<fmt::format_context> args;
+            args.push_back(fmt::arg("zero", 0));
+            return args;
+        }
+};
+
+/**
+ * @brief How BaseSink::log worked before formats were compiled: format the message, then parse the sink's format
+ * and substitute it in
+ */
+class LegacySink {
+    public:
+        Output output {FORMAT};
+
+        template <typename... T> void log(lemlib::Level level, fmt::format_string<T...> format, T&&... args) {
+            std::string messageString = fmt::format(format, std::forward<T>(args)...);
+            lemlib::Message message = lemlib::Message {.level = level, .time = pros::millis()};
+            fmt::dynamic_format_arg_store<fmt::format_context> formattingArgs;
+            formattingArgs.push_back(fmt::arg("time", message.time));
+            formattingArgs.push_back(fmt::arg("level", message.level));
+            formattingArgs.push_back(fmt::arg("message", messageString));
+            message.message = fmt::vformat(FORMAT, std::move(formattingArgs));
+            output.receive(message.message);
+        }
+};
+
+struct Result {
+        double ns;
+        double allocations;
+        long bytes;
+};
+
+/**
+ * @brief Log what a motion logs every update, as fast as possible
+ */
+template <typename Sink> Result run(Sink& sink) {
+    const long allocationsBefore = allocations;
+    const long bytesBefore = sink.output.bytes;
+    const auto start = Clock::now();
+    for (int i = 0; i < MESSAGES; i++) {
+        const float angular = i * 0.25f;
+        const float lateral = 127 - i * 0.125f;
+        sink.log(lemlib::Level::INFO, "Angular Out: {}, Lateral Out: {}", angular, lateral);
+    }
+    const std::chrono::duration<double, std::nano> took = Clock::now() - start;
+    return {took.count() / MESSAGES, double(allocations - allocationsBefore) / MESSAGES,
+            sink.output.bytes - bytesBefore};
+}
+
+/**
+ * @brief Log the same messages as run(), checking each one is the sink's format filled in by fmt::format
+ *
+ * @return true if every message matched
+ */
+template <typename Sink> bool check(Sink& sink, const char* name) {
+    std::string expected;
+    sink.output.expected = &expected;
+    for (int i = 0; i < MESSAGES; i++) {
+        const float angular = i * 0.25f;
+        const float lateral = 127 - i * 0.125f;
+        expected = fmt::format(fmt::runtime(sink.output.format), fmt::arg("level", lemlib::Level::INFO),
+                               fmt::arg("zero", 0),
+                               fmt::arg("message", fmt::format("Angular Out: {}, Lateral Out: {}", angular, lateral)));
+        sink.log(lemlib::Level::INFO, "Angular Out: {}, Lateral Out: {}", angular, lateral);
+    }
+    sink.output.expected = nullptr;
+    if (sink.output.mismatches == 0) return true;
+    std::printf("%s sink got %ld of %d messages wrong, the first was \"%s\"\n", name, sink.output.mismatches, MESSAGES,
+                sink.output.mismatch.c_str());
+    return false;
+}
+} // namespace
+
+// every form of new counts an allocation, and every form of delete frees with what its new allocated with. The deletes
+// that call free aren't inlined, or GCC sees free called on what new returned and warns they don't match
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return ::operator new(size); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    // aligned_alloc needs the size to be a multiple of the alignment
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    if (void* p = std::aligned_alloc(align, (size + align - 1) / align * align + (size == 0 ? align : 0))) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) { return ::operator new(size, alignment); }
+
+[[gnu::noinline]] void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete[](void* p) noexcept { ::operator delete(p); }
+
+void operator delete(void* p, std::size_t) noexcept { ::operator delete(p); }
+
+void operator delete[](void* p, std::size_t) noexcept { ::operator delete(p); }
+
+[[gnu::noinline]] void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+
+void operator delete[](void* p, std::align_val_t alignment) noexcept { ::operator delete(p, alignment); }
+
+void operator delete(void* p, std::size_t, std::align_val_t alignment) noexcept { ::operator delete(p, alignment); }
+
+void operator delete[](void* p, std::size_t, std::align_val_t alignment) noexcept { ::operator delete(p, alignment); }
+
+/**
+ * @brief Time BaseSink::log with the info sink's format, as it was and with the format compiled, and count heap
+ * allocations per message
+ *
+ * A sink with an extra formatting argument still parses its format every message, and is timed too. Every message
+ * reads the kernel clock, which is a simulator call here. Host time is measured, not simulated time.
+ */
+int main() {
+    LegacySink legacy;
+    CountingSink compiled(FORMAT);
+    ExtraArgSink extra;
+    // warm up, and check every sink writes exactly what fmt::format does
+    const bool legacyMatches = check(legacy, "vformat");
+    const bool compiledMatches = check(compiled, "compiled");
+    const bool extraMatches = check(extra, "extra argument");
+    if (!legacyMatches || !compiledMatches || !extraMatches) return 1;
+    std::printf("%d messages of \"%s\"\n", MESSAGES, FORMAT);
+    std::printf("  sink                 per message  messages/s  allocations/message\n");
+    for (const auto& [name, result] :
+         {std::pair {"vformat (before)", run(legacy)}, std::pair {"compiled", run(compiled)},
+          std::pair {"extra argument", run(extra)}}) {
+        std::printf("  %-19s %9.0f ns %11.3g %20.1f\n", name, result.ns, 1e9 / result.ns, result.allocations);
+    }
+    std::fflush(stdout);
+    _exit(0);
+}
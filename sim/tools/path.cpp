@@ -0,0 +1,75 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "lemlib/path.hpp"
+
+namespace {
+/**
+ * @brief Read a text path: "x, y, speed" on each line, up to a line reading "endData"
+ *
+ * @return false if a line before endData isn't a point
+ */
+bool readTextPath(const char* filename, std::vector<lemlib::PathPoint>& points) {
+    std::ifstream file(filename);
+    if (!file) {
+        std::fprintf(stderr, "%s: can't open\n", filename);
+        return false;
+    }
+    std::string line;
+    for (int number = 1; std::getline(file, line); number++) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line == "endData") return true;
+        lemlib::PathPoint point {0, 0, 0, 0, 0};
+        char end;
+        if (std::sscanf(line.c_str(), "%f, %f, %f %c", &point.x, &point.y, &point.speed, &end) != 3) {
+            std::fprintf(stderr, "%s:%d: expected \"x, y, speed\", got \"%s\"\n", filename, number, line.c_str());
+            return false;
+        }
+        points.push_back(point);
+    }
+    return true;
+}
+} // namespace
+
+/**
+ * @brief Convert a text path asset to the binary format follow() can use without parsing
+ *
+ * The output goes in static/ next to the text path, and is embedded and passed to follow() the same way.
+ */
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::fprintf(stderr, "usage: %s INPUT.txt OUTPUT.path\n", argv[0]);
+        return 1;
+    }
+    std::vector<lemlib::PathPoint> points;
+    if (!readTextPath(argv[1], points)) return 1;
+    if (points.empty()) {
+        std::fprintf(stderr, "%s: no points in path\n", argv[1]);
+        return 1;
+    }
+    lemlib::annotatePath(points);
+
+    lemlib::PathHeader header {};
+    std::memcpy(header.magic, lemlib::PATH_MAGIC, sizeof(header.magic));
+    header.version = lemlib::PATH_VERSION;
+    header.count = points.size();
+    header.pointSize = sizeof(lemlib::PathPoint);
+
+    std::FILE* out = std::fopen(argv[2], "wb");
+    if (out == nullptr) {
+        std::fprintf(stderr, "%s: can't open for writing\n", argv[2]);
+        return 1;
+    }
+    const bool written = std::fwrite(&header, sizeof(header), 1, out) == 1 &&
+                         std::fwrite(points.data(), sizeof(lemlib::PathPoint), points.size(), out) == points.size();
+    if (std::fclose(out) != 0 || !written) {
+        std::fprintf(stderr, "%s: write failed\n", argv[2]);
+        std::remove(argv[2]);
+        return 1;
+    }
+    std::printf("%s: %zu points, %.1f inches\n", argv[2], points.size(), points.back().distance);
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <cstdio>
+#include <unistd.h>
+#include "pros/optical.hpp"
+#include "pros/rtos.hpp"
+#include "sim/world.hpp"
+#include "sensorPoller.hpp"
+
+namespace {
+constexpr int PORT = 9; // the simulated robot's optical sensor
+
+int failures = 0;
+
+/**
+ * @brief Put an object in front of the sensor, then poll it
+ */
+void show(SensorPoller& poller, double hue, std::int32_t proximity) {
+    {
+        auto guard = sim::world().lock();
+        sim::OpticalState& optical = sim::world().optical(PORT);
+        optical.hue = hue;
+        optical.proximity = proximity;
+    }
+    poller.periodic();
+}
+
+/**
+ * @brief Check a trigger is in the state it should be, and print what it was if it isn't
+ */
+void expect(const char* step, const ColorTrigger& trigger, const char* name, bool active, int count) {
+    if (trigger.isActive() == active && trigger.getCount() == count) return;
+    std::printf("%s: %s trigger was %s with %d arrivals, expected %s with %d\n", step, name,
+                trigger.isActive() ? "active" : "inactive", trigger.getCount(), active ? "active" : "inactive", count);
+    failures++;
+}
+} // namespace
+
+/**
+ * @brief Check color triggers only fire once for an object whose reading flickers at the edge of the band, and that
+ * bands wrapping around through 0 match both sides
+ *
+ * The poller reads the sensor directly, as it does before odometry is running, so each step is one reading.
+ */
+int main() {
+    pros::Optical sensor(PORT);
+    ColorTrigger red(&sensor, {300, 20, 100}); // wraps around through 0
+    ColorTrigger blue(&sensor, {200, 240, 100});
+    SensorPoller poller;
+    poller.add(&red);
+    poller.add(&blue);
+    poller.initialize();
+    red.subscribe(pros::Task::current());
+    int callbacks = 0;
+    red.onArrive([&] { callbacks++; });
+
+    show(poller, 120, 0);
+    expect("nothing there", red, "red", false, 0);
+    show(poller, 350, 150);
+    expect("red below 360", red, "red", true, 1);
+    expect("red below 360", blue, "blue", false, 0);
+    const std::uint32_t notified = pros::Task::notify_take(true, 0);
+    if (notified != red.getMask()) {
+        std::printf("red arriving notified 0x%x, expected 0x%x\n", notified, red.getMask());
+        failures++;
+    }
+    // leaving the band by less than the hysteresis, either way, doesn't end the object
+    for (const double hue : {25.0, 5.0, 28.0, 295.0, 10.0}) show(poller, hue, 150);
+    expect("hue flickering at the edge", red, "red", true, 1);
+    show(poller, 10, 90);
+    expect("proximity flickering at the edge", red, "red", true, 1);
+    show(poller, 10, 70);
+    expect("red moving away", red, "red", false, 1);
+    show(poller, 5, 150);
+    expect("red above 0", red, "red", true, 2);
+    show(poller, 35, 150);
+    expect("hue past the hysteresis", red, "red", false, 2);
+    show(poller, 30, 150);
+    expect("hue in the hysteresis", red, "red", false, 2);
+    show(poller, 210, 150);
+    expect("blue", red, "red", false, 2);
+    expect("blue", blue, "blue", true, 1);
+    if (callbacks != red.getCount()) {
+        std::printf("red ran its callback %d times for %d arrivals\n", callbacks, red.getCount());
+        failures++;
+    }
+    if (failures != 0) return 1;
+    std::printf("color triggers: hysteresis and wrap-around ok\n");
+    std::fflush(stdout);
+    _exit(0);
+}
@@ -0,0 +1,107 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <unistd.h>
+#include <vector>
+#include "lemlib/chassis/pursuit.hpp"
+#include "sim/kernel.hpp"
+
+namespace {
+constexpr float LOOKAHEAD = 10; // inches
+constexpr float SPACING = 1; // inches between path points
+constexpr float TICK_DISTANCE = 0.75; // inches the robot moves per tick, about full speed
+constexpr float OFFSET = 1; // inches the robot is off to the side of the path
+constexpr int MAX_TICKS = 2000;
+
+/**
+ * @brief Make an S shaped path of evenly spaced points, like a long skills path would be
+ */
+std::vector<lemlib::PathPoint> makePath(int count) {
+    std::vector<lemlib::PathPoint> path;
+    for (int i = 0; i < count; i++) {
+        const float s = i * SPACING;
+        path.push_back({24 * std::sin(s / 40), s, i + 1 < count ? 100.0f : 0.0f, 0, 0});
+    }
+    lemlib::annotatePath(path);
+    return path;
+}
+
+/**
+ * @brief Where the robot is on a tick: moving along the path, a little off to its left
+ */
+lemlib::Pose robotPose(const std::vector<lemlib::PathPoint>& path, int tick) {
+    const float s = tick * TICK_DISTANCE;
+    const int i = std::min<int>(s / SPACING, path.size() - 2);
+    const lemlib::Pose a(path[i].x, path[i].y);
+    const lemlib::Pose b(path[i + 1].x, path[i + 1].y);
+    const lemlib::Pose along = b - a;
+    const float length = std::hypot(along.x, along.y);
+    const lemlib::Pose point = a.lerp(b, s / SPACING - i);
+    return {point.x - along.y / length * OFFSET, point.y + along.x / length * OFFSET};
+}
+
+struct Result {
+        double perTick; // nanoseconds
+        std::vector<lemlib::Pose> lookaheads;
+};
+
+/**
+ * @brief Run the closest and lookahead point searches of follow() for every tick, searching the whole path or only
+ * near the last closest point
+ */
+Result run(const std::vector<lemlib::PathPoint>& path, int ticks, bool indexed) {
+    Result result;
+    result.lookaheads.reserve(ticks);
+    const auto start = std::chrono::steady_clock::now();
+    lemlib::Pose lastLookahead(path[0].x, path[0].y, 0);
+    int closest = lemlib::findClosest(robotPose(path, 0), path, 0, path.size());
+    for (int tick = 0; tick < ticks; tick++) {
+        const lemlib::Pose pose = robotPose(path, tick);
+        if (indexed) {
+            const float closestDist = path[closest].distance;
+            closest = lemlib::findClosest(pose, path, lemlib::pathIndexAt(path, closestDist - LOOKAHEAD),
+                                          lemlib::pathIndexAt(path, closestDist + LOOKAHEAD) + 1);
+            lastLookahead = lemlib::lookaheadPoint(
+                lastLookahead, pose, path, closest, LOOKAHEAD,
+                lemlib::pathIndexAt(path, path[closest].distance + 3 * LOOKAHEAD) + 1);
+        } else {
+            closest = lemlib::findClosest(pose, path, 0, path.size());
+            lastLookahead = lemlib::lookaheadPoint(lastLookahead, pose, path, closest, LOOKAHEAD, path.size());
+        }
+        result.lookaheads.push_back(lastLookahead);
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    result.perTick = elapsed.count() / ticks;
+    return result;
+}
+} // namespace
+
+/**
+ * @brief Time the closest and lookahead point searches follow() does every tick, against the number of points
+ *
+ * Searching the whole path every tick, like follow() used to, is compared to searching near the last closest point
+ * using the cumulative distances. Both have to pick the same lookahead points. This measures host time, not
+ * simulated time.
+ */
+int main() {
+    // nothing here makes kernel calls, so it mustn't be mistaken for a spinning task
+    sim::PreemptGuard guard;
+    std::printf("pure pursuit tick, %.0f in lookahead, %.0f in between points\n", LOOKAHEAD, SPACING);
+    std::printf("  points   ticks  full scan     indexed   speedup  mismatches\n");
+    for (const int count : {100, 1000, 10000, 100000}) {
+        const std::vector<lemlib::PathPoint> path = makePath(count);
+        const int ticks = std::min<int>((count - 1) * SPACING / TICK_DISTANCE, MAX_TICKS);
+        const Result full = run(path, ticks, false);
+        const Result indexed = run(path, ticks, true);
+        int mismatches = 0;
+        for (int i = 0; i < ticks; i++) {
+            const lemlib::Pose& a = full.lookaheads[i];
+            const lemlib::Pose& b = indexed.lookaheads[i];
+            mismatches += a.x != b.x || a.y != b.y || a.theta != b.theta;
+        }
+        std::printf("%8d %7d %8.0f ns %8.0f ns %8.1fx %11d\n", count, ticks, full.perTick, indexed.perTick,
+                    full.perTick / indexed.perTick, mismatches);
+    }
+    std::fflush(stdout);
+    _exit(0);
+}
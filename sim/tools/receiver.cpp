@@ -0,0 +1,82 @@
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "lemlib/logger/transportFrame.hpp"
+
+namespace transport = lemlib::transport;
+
+/**
+ * @brief Put the text sent through a lemlib::Transport back together
+ *
+ * Reads the stream from a file or stdin, and writes the text it carried to stdout. Missed frames are found from gaps
+ * in the sequence numbers, and marked in the text. Bytes that aren't part of a good frame are skipped. A summary,
+ * including how much compression saved, goes to stderr.
+ */
+int main(int argc, char** argv) {
+    if (argc > 2 || (argc == 2 && argv[1][0] == '-' && argv[1][1] != '\0')) {
+        std::fprintf(stderr, "usage: %s [FILE]\n", argv[0]);
+        return 1;
+    }
+    std::FILE* in = argc == 1 || std::strcmp(argv[1], "-") == 0 ? stdin : std::fopen(argv[1], "rb");
+    if (in == nullptr) {
+        std::fprintf(stderr, "%s: can't open\n", argv[1]);
+        return 1;
+    }
+
+    std::vector<std::uint8_t> data;
+    std::array<std::uint8_t, transport::MAX_PAYLOAD> text;
+    std::size_t start = 0;
+    bool first = true;
+    std::uint16_t expected = 0;
+    std::size_t frames = 0, lost = 0, gaps = 0, corrupt = 0, skipped = 0, linkBytes = 0, textBytes = 0;
+    // read as it comes in, so it can follow a live stream
+    for (std::array<std::uint8_t, 4096> chunk; true;) {
+        const std::size_t count = std::fread(chunk.data(), 1, chunk.size(), in);
+        data.insert(data.end(), chunk.begin(), chunk.begin() + count);
+        while (start < data.size()) {
+            transport::Frame frame;
+            const int size = transport::decode(data.data() + start, data.size() - start, frame);
+            if (size == 0) break;
+            if (size < 0) {
+                skipped++;
+                start++;
+                continue;
+            }
+            start += size;
+            frames++;
+            linkBytes += size;
+            const std::uint16_t missed = frame.sequence - expected;
+            if (!first && missed != 0) {
+                gaps++;
+                lost += missed;
+                std::printf("\n[%u frames lost]\n", missed);
+            }
+            first = false;
+            expected = frame.sequence + 1;
+            const int textSize = transport::unpack(frame, text.data());
+            if (textSize < 0) {
+                corrupt++;
+                std::printf("\n[frame %u corrupt]\n", frame.sequence);
+                continue;
+            }
+            textBytes += textSize;
+            std::fwrite(text.data(), 1, textSize, stdout);
+        }
+        std::fflush(stdout);
+        // keep what's left of a frame that's partly arrived
+        data.erase(data.begin(), data.begin() + start);
+        start = 0;
+        if (count == 0) break;
+    }
+    skipped += data.size();
+
+    std::fprintf(stderr, "%zu frames, %zu lost in %zu gaps, %zu corrupt, %zu bytes skipped\n", frames, lost, gaps,
+                 corrupt, skipped);
+    if (linkBytes > 0) {
+        std::fprintf(stderr, "%zu bytes of text in %zu bytes of frames (%.2fx)\n", textBytes, linkBytes,
+                     double(textBytes) / linkBytes);
+    }
+    return 0;
+}
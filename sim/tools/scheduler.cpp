@@ -0,0 +1,110 @@
+#include <cstdio>
+#include <unistd.h>
+#include "pros/rtos.hpp"
+#include "sim/kernel.hpp"
+#include "subsystem.hpp"
+
+namespace {
+constexpr std::uint32_t DURATION = 495; // ms the scheduler runs for, stopping short of runs due at 500
+constexpr int HEAVY_RUN = 4; // the run of the heavy subsystem that overruns
+constexpr std::uint32_t HEAVY_TIME = 45000; // us it takes
+
+/**
+ * @brief A subsystem's run, in the order runs started
+ */
+struct Run {
+        int priority;
+        std::uint32_t start; // ms since the scheduler started
+};
+
+std::array<Run, 256> runs;
+int runCount = 0;
+std::uint32_t startTime = 0;
+int failures = 0;
+
+/**
+ * @brief A subsystem that records when it runs, and can be made to take too long
+ */
+class Recorder : public Subsystem {
+    public:
+        Recorder(const char* name, std::uint32_t period, int priority, int slowRun = -1)
+            : Subsystem(name, period, priority),
+              priority(priority),
+              slowRun(slowRun) {}
+
+        void periodic() override {
+            const std::uint32_t now = pros::millis() - startTime;
+            runs[runCount++] = {priority, now};
+            // a run a period after the last one would be catching up on a missed run
+            if (started > 0 && (now / getPeriod()) <= (last / getPeriod())) {
+                std::printf("%s ran at %u ms, in the same period as its run at %u ms\n", getName(), now, last);
+                failures++;
+            }
+            last = now;
+            if (started++ == slowRun) sim::charge(HEAVY_TIME);
+        }
+
+        const int priority;
+    private:
+        const int slowRun;
+        int started = 0;
+        std::uint32_t last = 0;
+};
+
+/**
+ * @brief Check a subsystem ran as many times and overran as many times as it should have
+ */
+void expect(const Recorder& subsystem, std::uint32_t runs, std::uint32_t overruns) {
+    const SubsystemStats stats = subsystem.getStats();
+    if (stats.runs == runs && stats.overruns == overruns) return;
+    std::printf("%s ran %u times with %u overruns, expected %u with %u\n", subsystem.getName(), stats.runs,
+                stats.overruns, runs, overruns);
+    failures++;
+}
+} // namespace
+
+/**
+ * @brief Check the subsystem scheduler runs subsystems due together in priority order, and skips the runs a slow one
+ * misses instead of running them back to back
+ *
+ * The heavy subsystem's fifth run, due at 80 ms, takes 45 ms. It skips its runs due at 100 and 120 ms. The fast and
+ * slow subsystems start late at 125 ms, for their runs due at 90 and 100 ms, so the fast one skips its runs due from 100
+ * to 120 ms and the slow one its run due at 125 ms.
+ */
+int main() {
+    Recorder heavy("heavy", 20, 0, HEAVY_RUN);
+    Recorder fast("fast", 10, 2);
+    Recorder slow("slow", 25, 1);
+    SubsystemScheduler scheduler;
+    // added out of order, since they're sorted by priority as they're added
+    scheduler.add(&heavy);
+    scheduler.add(&fast);
+    scheduler.add(&slow);
+    startTime = pros::millis();
+    scheduler.start();
+    pros::delay(DURATION);
+
+    for (int i = 0; i < scheduler.getCount(); i++) {
+        const Subsystem* expected = i == 0 ? &fast : i == 1 ? static_cast<Subsystem*>(&slow) : &heavy;
+        if (scheduler.getSubsystem(i) == expected) continue;
+        std::printf("%s was in position %d, expected %s\n", scheduler.getSubsystem(i)->getName(), i,
+                    expected->getName());
+        failures++;
+    }
+    for (int i = 1; i < runCount; i++) {
+        if (runs[i].start != runs[i - 1].start || runs[i].priority <= runs[i - 1].priority) continue;
+        std::printf("priority %d ran before priority %d at %u ms\n", runs[i - 1].priority, runs[i].priority,
+                    runs[i].start);
+        failures++;
+    }
+    // every 10 ms from 0 to 490 but 100 to 120, every 25 ms from 0 to 475 but 125, every 20 ms from 0 to 480 but 100
+    // and 120
+    expect(fast, 47, 1);
+    expect(slow, 19, 1);
+    expect(heavy, 23, 1);
+
+    if (failures != 0) return 1;
+    std::printf("subsystem scheduler: priorities and overruns ok\n");
+    std::fflush(stdout);
+    _exit(0);
+}
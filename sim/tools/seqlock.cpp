@@ -0,0 +1,160 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "lemlib/pose.hpp"
+#include "lemlib/seqlock.hpp"
+#include "sim/kernel.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr auto DURATION = std::chrono::milliseconds(500);
+constexpr auto WRITE_PERIOD = std::chrono::microseconds(50); // much faster than odometry, to make contention likely
+
+/**
+ * @brief The same size and shape as what odometry publishes. Every field is set from one counter, so a reader can
+ * tell if it got parts of two writes
+ */
+struct State {
+        lemlib::Pose pose;
+        lemlib::Pose speed;
+        lemlib::Pose localSpeed;
+        lemlib::Pose deviation;
+        std::uint64_t time;
+        std::uint32_t request;
+
+        static State make(std::uint32_t n) {
+            const float f = n % (1 << 24); // exact in a float
+            return {{f, f, f}, {f, f, f}, {f, f, f}, {f, f, f}, n, n};
+        }
+
+        bool consistent() const {
+            const float f = request % (1 << 24);
+            for (const lemlib::Pose& p : {pose, speed, localSpeed, deviation}) {
+                if (p.x != f || p.y != f || p.theta != f) return false;
+            }
+            return time == request;
+        }
+};
+
+/**
+ * @brief The state behind a mutex, like LemLib guards chassis state
+ */
+class Locked {
+    public:
+        void write(const State& value) {
+            std::lock_guard lock(mutex);
+            state = value;
+        }
+
+        State read() {
+            std::lock_guard lock(mutex);
+            return state;
+        }
+    private:
+        std::mutex mutex;
+        State state = State::make(0);
+};
+
+/**
+ * @brief The seqlock read like read() does it on the brain, except that a reader that catches a write part way
+ * through always copies again. Host threads really do run at once, so the writer finishes without the reader sleeping
+ * to let it, and sleeping is a kernel call they can't make
+ */
+class Spinning {
+    public:
+        void write(const State& value) { seqlock.write(value); }
+
+        State read() {
+            State value = State::make(0);
+            while (!seqlock.tryRead(value));
+            return value;
+        }
+    private:
+        lemlib::Seqlock<State> seqlock {State::make(0)};
+};
+
+struct Result {
+        double readsPerSecond;
+        double readNs; // mean time per read
+        double writeNs; // mean time per write
+        double writeMaxUs; // longest write
+        long torn;
+};
+
+/**
+ * @brief Have one writer publish on a fixed period while some readers read as fast as they can
+ */
+template <typename Store> Result run(Store& store, int readers) {
+    std::atomic<bool> done = false;
+    std::atomic<long> reads = 0;
+    std::atomic<long> torn = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < readers; i++) {
+        threads.emplace_back([&] {
+            long count = 0;
+            long bad = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                bad += !store.read().consistent();
+                count++;
+            }
+            reads += count;
+            torn += bad;
+        });
+    }
+
+    double writeTotal = 0;
+    double writeMax = 0;
+    long writes = 0;
+    const auto start = Clock::now();
+    auto next = start;
+    while (Clock::now() - start < DURATION) {
+        const auto before = Clock::now();
+        store.write(State::make(++writes));
+        const std::chrono::duration<double, std::nano> took = Clock::now() - before;
+        writeTotal += took.count();
+        writeMax = std::max(writeMax, took.count());
+        next += WRITE_PERIOD;
+        while (Clock::now() < next) {}
+    }
+    done = true;
+    for (std::thread& thread : threads) thread.join();
+
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    const double readTime = seconds * std::min<int>(readers, std::thread::hardware_concurrency());
+    return {reads / seconds, reads > 0 ? readTime / reads * 1e9 : 0, writeTotal / writes, writeMax / 1000, torn};
+}
+} // namespace
+
+/**
+ * @brief Compare publishing the odometry state through a seqlock to guarding it with a mutex, with more and more tasks
+ * reading it
+ *
+ * With the mutex, the writer waits whenever a reader holds the lock, and for as long as that reader is descheduled
+ * while holding it. The seqlock writer never waits, and its readers retry instead. Both must only ever read whole
+ * writes. Host threads stand in for tasks here, so this measures host time, not simulated time.
+ */
+int main() {
+    // nothing here makes kernel calls, so it mustn't be mistaken for a spinning task
+    sim::PreemptGuard guard;
+    std::printf("odometry state (%zu bytes) published every %lld us for %lld ms, %u host cores\n", sizeof(State),
+                static_cast<long long>(WRITE_PERIOD.count()), static_cast<long long>(DURATION.count()),
+                std::thread::hardware_concurrency());
+    std::printf("readers  store     reads/s    per read   per write  worst write  torn\n");
+    for (const int readers : {1, 2, 4}) {
+        Spinning seqlock;
+        Locked locked;
+        const Result lockFree = run(seqlock, readers);
+        const Result mutex = run(locked, readers);
+        for (const auto& [name, result] : {std::pair {"seqlock", lockFree}, std::pair {"mutex", mutex}}) {
+            std::printf("%7d  %-7s %10.3g %8.0f ns %8.0f ns %9.1f us %5ld\n", readers, name, result.readsPerSecond,
+                        result.readNs, result.writeNs, result.writeMaxUs, result.torn);
+        }
+    }
+    std::fflush(stdout);
+    _exit(0);
+}
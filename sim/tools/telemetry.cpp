@@ -0,0 +1,181 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "lemlib/logger/telemetryFrame.hpp"
+
+namespace {
+namespace telemetry = lemlib::telemetry;
+
+/**
+ * @brief Get the names of the values in a type of frame LemLib sends, or nullptr if it isn't one
+ */
+const char* const* fieldNames(std::uint8_t type) {
+    static const char* const xyTheta[] = {"x", "y", "theta"};
+    if (type == telemetry::POSE || type == telemetry::SPEED) return xyTheta;
+    return nullptr;
+}
+
+/**
+ * @brief Print the name of a field, numbered if the type has no names for its values
+ */
+void printField(std::uint8_t type, int index) {
+    const char* const* names = fieldNames(type);
+    if (names != nullptr && index < 3) std::fputs(names[index], stdout);
+    else std::printf("v%d", index);
+}
+
+/**
+ * @brief Print text as a quoted CSV field or JSON string
+ */
+void printText(const telemetry::Frame& frame, bool json) {
+    std::putchar('"');
+    for (int i = 0; i < frame.size; i++) {
+        const unsigned char c = frame.payload[i];
+        if (!json && c == '"') std::fputs("\"\"", stdout);
+        else if (json && (c == '"' || c == '\\')) std::printf("\\%c", c);
+        else if (json && c < 0x20) std::printf("\\u%04x", c);
+        else std::putchar(c);
+    }
+    std::putchar('"');
+}
+
+float value(const telemetry::Frame& frame, int index) {
+    float f;
+    std::memcpy(&f, frame.payload + index * sizeof(float), sizeof(float));
+    return f;
+}
+
+void printCsv(const telemetry::Frame& frame, bool withType) {
+    std::printf("%u", frame.time);
+    if (withType) {
+        const char* name = telemetry::typeName(frame.type);
+        if (name != nullptr) std::printf(",%s", name);
+        else std::printf(",%u", frame.type);
+    }
+    if (frame.type == telemetry::TEXT) {
+        std::putchar(',');
+        printText(frame, false);
+    } else {
+        for (int i = 0; i < frame.size / 4; i++) std::printf(",%.9g", value(frame, i));
+    }
+    std::putchar('\n');
+}
+
+void printJson(const telemetry::Frame& frame) {
+    const char* name = telemetry::typeName(frame.type);
+    std::printf("{\"time\":%u,", frame.time);
+    if (name != nullptr) std::printf("\"type\":\"%s\"", name);
+    else std::printf("\"type\":%u", frame.type);
+    if (frame.type == telemetry::TEXT) {
+        std::fputs(",\"text\":", stdout);
+        printText(frame, true);
+    } else if (fieldNames(frame.type) != nullptr) {
+        for (int i = 0; i < frame.size / 4; i++) {
+            std::fputs(",\"", stdout);
+            printField(frame.type, i);
+            std::printf("\":%.9g", value(frame, i));
+        }
+    } else {
+        std::fputs(",\"values\":[", stdout);
+        for (int i = 0; i < frame.size / 4; i++) std::printf("%s%.9g", i == 0 ? "" : ",", value(frame, i));
+        std::putchar(']');
+    }
+    std::fputs("}\n", stdout);
+}
+
+/**
+ * @brief Parse a type given by name or number
+ *
+ * @return -1 if it's neither
+ */
+int parseType(const char* text) {
+    for (int type = 0; type < 256; type++) {
+        const char* name = telemetry::typeName(type);
+        if (name != nullptr && std::strcmp(name, text) == 0) return type;
+    }
+    char* end;
+    const long type = std::strtol(text, &end, 10);
+    if (*text == '\0' || *end != '\0' || type < 0 || type > 255) return -1;
+    return type;
+}
+} // namespace
+
+/**
+ * @brief Decode a binary telemetry stream, as the telemetry sink writes it, into CSV or JSON lines
+ *
+ * Every frame is one line. With --type, only frames of that type are printed, under a header naming their values.
+ * Bytes that aren't part of a frame, like text printed to the same terminal, are skipped and counted.
+ */
+int main(int argc, char** argv) {
+    bool json = false;
+    int only = -1;
+    const char* filename = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (std::strcmp(argv[i], "--type") == 0 && i + 1 < argc) {
+            only = parseType(argv[++i]);
+            if (only == -1) {
+                std::fprintf(stderr, "%s: not a frame type\n", argv[i]);
+                return 1;
+            }
+        } else if (argv[i][0] != '-' && filename == nullptr) {
+            filename = argv[i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--json] [--type NAME|NUMBER] [FILE]\n", argv[0]);
+            return 1;
+        }
+    }
+    std::FILE* in = filename == nullptr ? stdin : std::fopen(filename, "rb");
+    if (in == nullptr) {
+        std::fprintf(stderr, "%s: can't open\n", filename);
+        return 1;
+    }
+    std::vector<std::uint8_t> data;
+    std::uint8_t chunk[4096];
+    for (std::size_t size; (size = std::fread(chunk, 1, sizeof(chunk), in)) > 0;)
+        data.insert(data.end(), chunk, chunk + size);
+
+    if (!json && only != -1) {
+        std::fputs("time", stdout);
+        if (only == telemetry::TEXT) std::fputs(",text", stdout);
+        // unnamed values are numbered, as many as the first frame has
+        for (std::size_t i = 0; only != telemetry::TEXT && i < data.size(); i++) {
+            telemetry::Frame frame;
+            if (telemetry::decode(data.data() + i, data.size() - i, frame) <= 0 || frame.type != only) continue;
+            for (int j = 0; j < frame.size / 4; j++) {
+                std::putchar(',');
+                printField(frame.type, j);
+            }
+            break;
+        }
+        std::putchar('\n');
+    } else if (!json) {
+        std::puts("time,type,values");
+    }
+
+    std::size_t frames = 0;
+    std::size_t skipped = 0;
+    std::size_t i = 0;
+    while (i < data.size()) {
+        telemetry::Frame frame;
+        const int size = telemetry::decode(data.data() + i, data.size() - i, frame);
+        if (size == 0) break;
+        if (size < 0) {
+            skipped++;
+            i++;
+            continue;
+        }
+        i += size;
+        frames++;
+        if (only != -1 && frame.type != only) continue;
+        if (json) printJson(frame);
+        else printCsv(frame, only == -1);
+    }
+    skipped += data.size() - i;
+    std::fprintf(stderr, "%zu frames, %zu bytes skipped\n", frames, skipped);
+    return 0;
+}
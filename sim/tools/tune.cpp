@@ -0,0 +1,92 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include "sim/tune.hpp"
+
+// drivetrain, sensors and controller settings defined in src/main.cpp
+extern lemlib::Drivetrain drivetrain;
+extern lemlib::OdomSensors sensors;
+extern lemlib::ControllerSettings linearController;
+extern lemlib::ControllerSettings angularController;
+
+namespace {
+void usage(const char* program) {
+    std::fprintf(stderr,
+                 "usage: %s [--lateral | --angular] [--overshoot LIMIT] [--samples N] [--iterations N] [--seed N] "
+                 "[--jobs N]\n",
+                 program);
+}
+
+void printScore(const char* label, const sim::TuneScore& score) {
+    std::printf("// %s: settled in %.0f ms total, worst overshoot %.2f, %d steps unsettled\n", label,
+                score.settleTime, score.overshoot, score.unsettled);
+}
+
+/**
+ * @brief Print the settings the way they're written in src/main.cpp, so they can be pasted over the old ones
+ */
+void printSettings(const lemlib::ControllerSettings& settings, bool lateral) {
+    const char* name = lateral ? "linearController" : "angularController";
+    const char* units = lateral ? "inches" : "degrees";
+    const int indent = std::strlen("lemlib::ControllerSettings ") + std::strlen(name) + 1;
+    std::printf("// %s motion controller\n", lateral ? "lateral" : "angular");
+    std::printf("lemlib::ControllerSettings %s(%g, // proportional gain (kP)\n", name, settings.kP);
+    std::printf("%*s%g, // integral gain (kI)\n", indent, "", settings.kI);
+    std::printf("%*s%g, // derivative gain (kD)\n", indent, "", settings.kD);
+    std::printf("%*s%g, // anti windup\n", indent, "", settings.windupRange);
+    std::printf("%*s%g, // small error range, in %s\n", indent, "", settings.smallError, units);
+    std::printf("%*s%g, // small error range timeout, in milliseconds\n", indent, "", settings.smallErrorTimeout);
+    std::printf("%*s%g, // large error range, in %s\n", indent, "", settings.largeError, units);
+    std::printf("%*s%g, // large error range timeout, in milliseconds\n", indent, "", settings.largeErrorTimeout);
+    std::printf("%*s%g // maximum acceleration (slew)\n", indent, "", settings.slew);
+    std::printf("%*s);\n", indent - 1, "");
+}
+} // namespace
+
+/**
+ * @brief Tune the gains of one of the chassis controllers in src/main.cpp, then print settings to paste back in
+ *
+ * The search starts from the gains currently in src/main.cpp, and only the robot's globals have been constructed by
+ * the time it runs, so every candidate starts from the same state.
+ */
+int main(int argc, char** argv) {
+    sim::TuneOptions options;
+    bool overshootSet = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--lateral") == 0) {
+            options.controller = sim::TuneController::LATERAL;
+        } else if (std::strcmp(argv[i], "--angular") == 0) {
+            options.controller = sim::TuneController::ANGULAR;
+        } else if (std::strcmp(argv[i], "--overshoot") == 0 && i + 1 < argc) {
+            options.maxOvershoot = std::atof(argv[++i]);
+            overshootSet = true;
+        } else if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            options.samples = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            options.iterations = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.seed = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            options.jobs = std::atoi(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    const bool lateral = options.controller == sim::TuneController::LATERAL;
+    // half an inch or two degrees past the target is about as far as the routines can afford
+    if (!overshootSet) options.maxOvershoot = lateral ? 0.5 : 2;
+    if (options.maxOvershoot <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const sim::TuneResult result = sim::tune(drivetrain, linearController, angularController, sensors, options);
+    std::printf("// tuned from %d candidates with seed %u\n", result.evaluations, options.seed);
+    printScore("before", result.initial);
+    printScore("after", result.score);
+    printSettings(result.settings, lateral);
+    std::fflush(stdout);
+    _exit(0);
+}
@@ -0,0 +1,83 @@
+#include <cstdio>
+#include <unistd.h>
+#include "pros/rtos.hpp"
+#include "timerWheel.hpp"
+
+namespace {
+/**
+ * @brief When an action was due and when it ran
+ */
+struct Run {
+        int id;
+        std::uint32_t due;
+        std::uint32_t ran;
+};
+
+TimerWheel wheel;
+std::array<Run, 64> runs;
+int runCount = 0;
+int failures = 0;
+
+/**
+ * @brief Schedule an action that records when it ran
+ */
+void scheduleRecorded(int id, std::uint32_t due) {
+    if (wheel.scheduleAt(due, [id, due] { runs[runCount++] = {id, due, pros::millis()}; })) return;
+    std::printf("action %d due at %u couldn't be scheduled\n", id, due);
+    failures++;
+}
+} // namespace
+
+/**
+ * @brief Check the timer wheel runs every action once, at the millisecond it's due, in order, including actions more
+ * than a turn of the wheel away and actions that are already due
+ */
+int main() {
+    const std::uint32_t start = pros::millis();
+    int id = 0;
+    scheduleRecorded(id++, start + 3); // before the task starts
+    wheel.start();
+    // 256 and 512 land in the same slot as 0, and 300 and 600 in the same slot as 44
+    for (const std::uint32_t delay : {1, 44, 100, 100, 255, 256, 257, 300, 511, 512, 600, 700})
+        scheduleRecorded(id++, start + delay);
+    // an action that schedules one due straight away, which has to go in a slot the wheel hasn't passed
+    wheel.scheduleAt(start + 150, [&id] { scheduleRecorded(id++, pros::millis()); });
+    pros::delay(200);
+    scheduleRecorded(id++, start + 20); // already passed
+    pros::delay(600);
+    const int expected = id;
+
+    if (runCount != expected || wheel.getPending() != 0) {
+        std::printf("%d of %d actions ran, %d still pending\n", runCount, expected, wheel.getPending());
+        failures++;
+    }
+    for (int i = 0; i < runCount; i++) {
+        const Run& run = runs[i];
+        // an action scheduled after it was due runs as soon as it's scheduled instead
+        const std::uint32_t earliest = run.id == expected - 1 ? start + 200 : run.due;
+        if (run.ran < earliest || run.ran > earliest + 1) {
+            std::printf("action %d due at %u ran at %u\n", run.id, run.due - start, run.ran - start);
+            failures++;
+        }
+        if (i > 0 && run.due == runs[i - 1].due && run.id < runs[i - 1].id) {
+            std::printf("action %d ran before action %d, which was scheduled first\n", runs[i - 1].id, run.id);
+            failures++;
+        }
+    }
+
+    // scheduling past MAX_ACTIONS fails, and the wheel can be filled again once they've run
+    for (int round = 0; round < 2; round++) {
+        int scheduled = 0;
+        while (wheel.schedule(10, [] {})) scheduled++;
+        if (scheduled != TimerWheel::MAX_ACTIONS) {
+            std::printf("%d actions fitted in the wheel, expected %d\n", scheduled, TimerWheel::MAX_ACTIONS);
+            failures++;
+        }
+        pros::delay(20);
+    }
+
+    if (failures != 0) return 1;
+    std::printf("timer wheel: %d actions ran on time and in order\n", runCount);
+    std::fflush(stdout);
+    _exit(0);
+}
@@ -0,0 +1,37 @@
+#include "intake.hpp"
+
+namespace {
+constexpr std::uint32_t UNJAM_TIME = 500; // milliseconds to run backwards for
+} // namespace
+
+IntakeController::IntakeController(pros::Motor* motor, std::uint32_t period)
+    : Subsystem("Intake", period),
+      motor(motor) {
+    arbiter.request(DRIVE, 0);
+}
+
+void IntakeController::set(int speed) { arbiter.request(DRIVE, speed); }
+
+void IntakeController::request(Level level, int speed) { arbiter.request(level, speed); }
+
+void IntakeController::release(Level level) {
+    // the routine or driver always has a speed, even if it's 0
+    if (level == DRIVE) arbiter.request(DRIVE, 0);
+    else arbiter.release(level);
+}
+
+void IntakeController::setUnjam(bool enabled) { unjam = enabled; }
+
+void IntakeController::clearJam() {
+    if (!unjam || arbiter.isActive(UNJAM)) return;
+    // set when it ends first, so an update in between doesn't end it straight away
+    unjamEnd = pros::millis() + UNJAM_TIME;
+    // back out of the jam, the opposite way to what the intake was stuck going
+    arbiter.request(UNJAM, arbiter.resolve(0) > 0 ? -127 : 127);
+}
+
+void IntakeController::periodic() {
+    const std::uint32_t now = pros::millis();
+    if (arbiter.isActive(UNJAM) && static_cast<std::int32_t>(now - unjamEnd) >= 0) arbiter.release(UNJAM);
+    motor->move(arbiter.resolve(0));
+}
@@ -0,0 +1,305 @@
+#include <cmath>
+#include "pros/imu.hpp"
+#include "pros/misc.hpp"
+#include "pros/rtos.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/profiler.hpp"
+#include "lemlib/util.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/chassis/trackingWheel.hpp"
+
+lemlib::ExpoDriveCurve lemlib::defaultDriveCurve = lemlib::ExpoDriveCurve(0, 0, 1);
+
+/**
+ * @brief Construct a new OdomSensors
+ *
+ * @param vertical1 pointer to the first vertical tracking wheel
+ * @param vertical2 pointer to the second vertical tracking wheel
+ * @param horizontal1 pointer to the first horizontal tracking wheel
+ * @param horizontal2 pointer to the second horizontal tracking wheel
+ * @param imu pointer to the IMU
+ */
+lemlib::OdomSensors::OdomSensors(TrackingWheel* vertical1, TrackingWheel* vertical2, TrackingWheel* horizontal1,
+                                 TrackingWheel* horizontal2, pros::Imu* imu)
+    : vertical1(vertical1),
+      vertical2(vertical2),
+      horizontal1(horizontal1),
+      horizontal2(horizontal2),
+      imu(imu) {}
+
+/**
+ * @brief Construct a new Drivetrain
+ *
+ * @param leftMotors pointer to the left motors
+ * @param rightMotors pointer to the right motors
+ * @param trackWidth the track width of the robot
+ * @param wheelDiameter the diameter of the wheel used on the drivetrain
+ * @param rpm the rpm of the wheels
+ * @param horizontalDrift higher values make the robot move faster but causes more overshoot on turns
+ */
+lemlib::Drivetrain::Drivetrain(pros::MotorGroup* leftMotors, pros::MotorGroup* rightMotors, float trackWidth,
+                               float wheelDiameter, float rpm, float horizontalDrift)
+    : leftMotors(leftMotors),
+      rightMotors(rightMotors),
+      trackWidth(trackWidth),
+      wheelDiameter(wheelDiameter),
+      rpm(rpm),
+      horizontalDrift(horizontalDrift) {}
+
+/**
+ * @brief Construct a new Chassis
+ *
+ * @param drivetrain drivetrain to be used for the chassis
+ * @param lateralSettings settings for the lateral controller
+ * @param angularSettings settings for the angular controller
+ * @param sensors sensors to be used for odometry
+ * @param throttleCurve curve applied to throttle input during driver control
+ * @param steerCurve curve applied to steer input during driver control
+ */
+lemlib::Chassis::Chassis(Drivetrain drivetrain, ControllerSettings linearSettings, ControllerSettings angularSettings,
+                         OdomSensors sensors, DriveCurve* throttleCurve, DriveCurve* steerCurve)
+    : lateralPID(linearSettings.kP, linearSettings.kI, linearSettings.kD, linearSettings.windupRange, true),
+      angularPID(angularSettings.kP, angularSettings.kI, angularSettings.kD, angularSettings.windupRange, true),
+      lateralSettings(linearSettings),
+      angularSettings(angularSettings),
+      drivetrain(drivetrain),
+      compensator(drivetrain.leftMotors, drivetrain.rightMotors, drivetrain.trackWidth, drivetrain.wheelDiameter,
+                  drivetrain.rpm),
+      sensors(sensors),
+      throttleCurve(throttleCurve),
+      steerCurve(steerCurve),
+      lateralLargeExit(lateralSettings.largeError, lateralSettings.largeErrorTimeout),
+      lateralSmallExit(lateralSettings.smallError, lateralSettings.smallErrorTimeout),
+      angularLargeExit(angularSettings.largeError, angularSettings.largeErrorTimeout),
+      angularSmallExit(angularSettings.smallError, angularSettings.smallErrorTimeout) {}
+
+/**
+ * @brief calibrate the IMU given a sensors struct
+ *
+ * @param sensors reference to the sensors struct
+ */
+void calibrateIMU(lemlib::OdomSensors& sensors) {
+    int attempt = 1;
+    bool calibrated = false;
+    // calibrate inertial, and if calibration fails, then repeat 5 times or until successful
+    while (attempt <= 5) {
+        sensors.imu->reset();
+        // wait until IMU is calibrated
+        do pros::delay(10);
+        while (sensors.imu->get_status() != pros::ImuStatus::error && sensors.imu->is_calibrating());
+        // exit if imu has been calibrated
+        if (!std::isnan(sensors.imu->get_heading()) && !std::isinf(sensors.imu->get_heading())) {
+            calibrated = true;
+            break;
+        }
+        // indicate error
+        pros::c::controller_rumble(pros::E_CONTROLLER_MASTER, "---");
+        lemlib::infoSink()->warn("IMU failed to calibrate! Attempt #{}", attempt);
+        attempt++;
+    }
+    // check if calibration attempts were successful
+    if (attempt > 5) {
+        sensors.imu = nullptr;
+        lemlib::infoSink()->error("IMU calibration failed, defaulting to tracking wheels / motor encoders");
+    }
+}
+
+void lemlib::Chassis::calibrate(bool calibrateImu) {
+    // calibrate the IMU if it exists and the user doesn't specify otherwise
+    if (sensors.imu != nullptr && calibrateImu) calibrateIMU(sensors);
+    // initialize odom
+    if (sensors.vertical1 == nullptr)
+        sensors.vertical1 = new lemlib::TrackingWheel(drivetrain.leftMotors, drivetrain.wheelDiameter,
+                                                      -(drivetrain.trackWidth / 2), drivetrain.rpm);
+    if (sensors.vertical2 == nullptr)
+        sensors.vertical2 = new lemlib::TrackingWheel(drivetrain.rightMotors, drivetrain.wheelDiameter,
+                                                      drivetrain.trackWidth / 2, drivetrain.rpm);
+    sensors.vertical1->reset();
+    sensors.vertical2->reset();
+    if (sensors.horizontal1 != nullptr) sensors.horizontal1->reset();
+    if (sensors.horizontal2 != nullptr) sensors.horizontal2->reset();
+    setSensors(sensors, drivetrain);
+    init();
+    // rumble to controller to indicate success
+    pros::c::controller_rumble(pros::E_CONTROLLER_MASTER, ".");
+}
+
+void lemlib::Chassis::setPose(float x, float y, float theta, bool radians) {
+    lemlib::setPose(lemlib::Pose(x, y, theta), radians);
+}
+
+void lemlib::Chassis::setPose(Pose pose, bool radians) { lemlib::setPose(pose, radians); }
+
+lemlib::Pose lemlib::Chassis::getPose(bool radians, bool standardPos) {
+    Pose pose = lemlib::getPose(true);
+    if (standardPos) pose.theta = M_PI_2 - pose.theta;
+    if (!radians) pose.theta = radToDeg(pose.theta);
+    return pose;
+}
+
+lemlib::Pose lemlib::Chassis::getPredictedPose(bool radians, bool standardPos) {
+    Pose pose = lemlib::predictPose(latency, true);
+    if (standardPos) pose.theta = M_PI_2 - pose.theta;
+    if (!radians) pose.theta = radToDeg(pose.theta);
+    return pose;
+}
+
+void lemlib::Chassis::resetLocalPosition() {
+    float theta = this->getPose().theta;
+    lemlib::setPose(lemlib::Pose(0, 0, theta), false);
+}
+
+void lemlib::Chassis::setBrakeMode(pros::motor_brake_mode_e mode) {
+    drivetrain.leftMotors->set_brake_mode_all(mode);
+    drivetrain.rightMotors->set_brake_mode_all(mode);
+}
+
+void lemlib::Chassis::waitUntil(float dist) {
+    // do while to give the thread time to start
+    do pros::delay(10);
+    while (distTraveled <= dist && distTraveled != -1);
+}
+
+void lemlib::Chassis::waitUntilDone() {
+    do pros::delay(10);
+    while (distTraveled != -1);
+}
+
+void lemlib::Chassis::requestMotionStart() {
+    if (this->isInMotion()) this->motionQueued = true; // indicate a motion is queued
+    else this->motionRunning = true; // indicate a motion is running
+
+    // wait until this motion is at front of "queue"
+    this->mutex.take(TIMEOUT_MAX);
+
+    // this->motionRunning should be true
+    // and this->motionQueued should be false
+    // indicating this motion is running
+}
+
+void lemlib::Chassis::endMotion() {
+    // an async motion's task ends after this
+    lemlib::profiler::stop();
+
+    // move the "queue" forward 1
+    this->motionRunning = this->motionQueued;
+    this->motionQueued = false;
+
+    // permit queued motion to run
+    this->mutex.give();
+}
+
+void lemlib::Chassis::cancelMotion() {
+    this->motionRunning = false;
+    pros::delay(10); // give time for motion to stop
+}
+
+void lemlib::Chassis::cancelAllMotions() {
+    this->motionRunning = false;
+    this->motionQueued = false;
+    pros::delay(10); // give time for motion to stop
+}
+
+bool lemlib::Chassis::isInMotion() const { return this->motionRunning; }
+
+void lemlib::Chassis::setMotionRecorder(std::function<void(const MotionRecord&)> recorder) {
+    this->motionRecorder = std::move(recorder);
+}
+
+void lemlib::Chassis::recordMotion(const char* motion, Timer& timer, const ExitCondition& smallExit,
+                                   const ExitCondition& largeExit, const SettleExit& settleExit) {
+    if (!this->motionRecorder) return;
+    const int elapsed = timer.getTimePassed();
+    const int endTime = pros::millis();
+    // the large range contains the small one, so it's entered first
+    int firstEntry = largeExit.getFirstEntryTime();
+    if (firstEntry == -1) firstEntry = smallExit.getFirstEntryTime();
+    this->motionRecorder({.motion = motion,
+                          .startTime = endTime - elapsed,
+                          .elapsed = elapsed,
+                          .settleTime = firstEntry == -1 ? -1 : endTime - firstEntry,
+                          .smallExitTime = smallExit.getTimeInRange(),
+                          .largeExitTime = largeExit.getTimeInRange(),
+                          .timedOut = timer.isDone(),
+                          .settled = settleExit.getExit()});
+}
+
+void lemlib::Chassis::setProfileSettings(ProfileSettings settings) { profileSettings = settings; }
+
+void lemlib::Chassis::setSettleSettings(SettleSettings lateral, SettleSettings angular) {
+    lateralSettle.setSettings(lateral);
+    angularSettle.setSettings(angular);
+}
+
+void lemlib::Chassis::setMotorModel(MotorModel model) { compensator.setModel(model); }
+
+void lemlib::Chassis::setTractionSettings(TractionSettings settings) { compensator.setTractionSettings(settings); }
+
+void lemlib::Chassis::setLatency(int latency) { this->latency = latency / 1000.0f; }
+
+float lemlib::Chassis::getMaxVelocity() const { return drivetrain.rpm / 60 * M_PI * drivetrain.wheelDiameter; }
+
+lemlib::MotionProfile lemlib::Chassis::planProfile(float distance, bool forwards, float maxSpeed, float minSpeed,
+                                                   float curvature) {
+    // the outer wheels go faster than the center of the robot on a curve
+    const float maxVelocity =
+        getMaxVelocity() * std::fabs(maxSpeed) / 127 / (1 + std::fabs(curvature) * drivetrain.trackWidth / 2);
+    const float startVelocity = (forwards ? 1 : -1) * getLocalSpeed().y;
+    return MotionProfile(distance, maxVelocity, profileSettings.maxAcceleration, profileSettings.maxJerk,
+                         startVelocity, getMaxVelocity() * std::fabs(minSpeed) / 127);
+}
+
+float lemlib::Chassis::profileFeedforward(const ProfileState& state) {
+    const float kV = profileSettings.kV != 0 ? profileSettings.kV : 127 / getMaxVelocity();
+    const float kS = state.velocity == 0 ? 0 : profileSettings.kS * sgn(state.velocity);
+    return kS + kV * state.velocity + profileSettings.kA * state.acceleration;
+}
+
+void lemlib::Chassis::tank(int left, int right, bool disableDriveCurve) {
+    if (disableDriveCurve) {
+        compensator.move(left, right);
+    } else {
+        compensator.move(throttleCurve->curve(left), throttleCurve->curve(right));
+    }
+}
+
+void lemlib::Chassis::arcade(int throttle, int turn, bool disableDriveCurve, float desaturateBias) {
+    if (!disableDriveCurve) {
+        throttle = throttleCurve->curve(throttle);
+        turn = steerCurve->curve(turn);
+    }
+    // desaturate motors based on desaturateBias
+    if (std::abs(throttle) + std::abs(turn) > 127) {
+        const int oldThrottle = throttle;
+        const int oldTurn = turn;
+        throttle *= (1 - desaturateBias * std::abs(oldTurn / 127.0));
+        turn *= (1 - (1 - desaturateBias) * std::abs(oldThrottle / 127.0));
+    }
+    compensator.move(throttle + turn, throttle - turn);
+}
+
+void lemlib::Chassis::curvature(int throttle, int turn, bool disableDriveCurve) {
+    // If we're not moving forwards change to arcade drive
+    if (throttle == 0) {
+        arcade(throttle, turn, disableDriveCurve);
+        return;
+    }
+
+    if (!disableDriveCurve) {
+        throttle = throttleCurve->curve(throttle);
+        turn = steerCurve->curve(turn);
+    }
+
+    float leftPower = throttle + (std::abs(throttle) * turn) / 127.0;
+    float rightPower = throttle - (std::abs(throttle) * turn) / 127.0;
+
+    // ratio the speeds to respect the max speed
+    const float ratio = std::max(std::fabs(leftPower), std::fabs(rightPower)) / 127;
+    if (ratio > 1) {
+        leftPower /= ratio;
+        rightPower /= ratio;
+    }
+
+    compensator.move(leftPower, rightPower);
+}
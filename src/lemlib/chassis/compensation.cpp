@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <cmath>
+#include "pros/error.h"
+#include "pros/misc.hpp"
+#include "pros/rtos.hpp"
+#include "lemlib/devices.hpp"
+#include "lemlib/chassis/compensation.hpp"
+#include "lemlib/chassis/odom.hpp"
+
+namespace lemlib {
+// most voltage a motor accepts, in millivolts
+constexpr float MAX_VOLTAGE = 12000;
+
+DriveCompensator::DriveCompensator(pros::MotorGroup* leftMotors, pros::MotorGroup* rightMotors, float trackWidth,
+                                   float wheelDiameter, float rpm)
+    : trackWidth(trackWidth),
+      wheelDiameter(wheelDiameter),
+      rpm(rpm) {
+    left.motors = leftMotors;
+    right.motors = rightMotors;
+}
+
+void DriveCompensator::setModel(MotorModel model) {
+    this->model = model;
+    if (model.freeSpeed <= 0) return;
+    watch();
+    temperaturesRead = false;
+}
+
+void DriveCompensator::setTractionSettings(TractionSettings settings) {
+    traction = settings;
+    if (settings.slip <= 0) return;
+    watch();
+    // the gearsets don't change, so they're only read once
+    for (Side* side : {&left, &right}) {
+        float total = 0;
+        int count = 0;
+        for (pros::MotorGears gearset : side->motors->get_gearing_all()) {
+            switch (gearset) {
+                case pros::MotorGears::red: total += 100; break;
+                case pros::MotorGears::blue: total += 600; break;
+                default: total += 200; break;
+            }
+            count++;
+        }
+        side->wheelRatio = count == 0 ? 1 : rpm / (total / count);
+        side->slipping = false;
+    }
+}
+
+void DriveCompensator::watch() {
+    for (Side* side : {&left, &right}) {
+        side->count = side->motors->size();
+        if (side->deviceIndex == -1) side->deviceIndex = devices().add(side->motors, DeviceService::VELOCITY);
+    }
+}
+
+void DriveCompensator::updateConditions() {
+    const std::uint32_t now = pros::millis();
+    if (!temperaturesRead || now - lastTemperatureRead >= TEMPERATURE_PERIOD) {
+        temperaturesRead = true;
+        lastTemperatureRead = now;
+        for (Side* side : {&left, &right}) {
+            float total = 0;
+            int count = 0;
+            for (int i = 0; i < side->count; i++) {
+                const double temperature = side->motors->get_temperature(i);
+                // an unplugged motor doesn't count
+                if (temperature == PROS_ERR_F) continue;
+                total += temperature;
+                count++;
+            }
+            const float mean = count == 0 ? 25 : total / count;
+            side->resistance = std::max(1 + model.temperatureCoefficient * (mean - 25), 0.5f);
+        }
+    }
+    const std::int32_t voltage = pros::battery::get_voltage();
+    battery = voltage == PROS_ERR || voltage <= 0 ? MAX_VOLTAGE : voltage;
+}
+
+void DriveCompensator::motorVelocities(float& leftVelocity, float& rightVelocity) const {
+    const bool snapshotReady = left.deviceIndex != -1 && right.deviceIndex != -1 && devices().getVersion() != 0;
+    // copied once for both sides, since it holds every device
+    const DeviceSnapshot snapshot = snapshotReady ? devices().get() : DeviceSnapshot {};
+    auto mean = [&](const Side& side) {
+        float velocity = 0;
+        for (int i = 0; i < side.count; i++) {
+            // before odometry is running, the motors are read directly
+            velocity += snapshotReady ? snapshot.motorVelocities[side.deviceIndex + i]
+                                      : side.motors->get_actual_velocity(i);
+        }
+        velocity /= std::max(side.count, 1);
+        return std::isfinite(velocity) ? velocity : 0;
+    };
+    leftVelocity = mean(left);
+    rightVelocity = mean(right);
+}
+
+bool DriveCompensator::groundSpeeds(float& left, float& right) const {
+    if (devices().getVersion() == 0) return false;
+    const Pose speed = getLocalSpeed(true);
+    // turning clockwise, the left side moves faster than the middle of the robot
+    left = speed.y + speed.theta * trackWidth / 2;
+    right = speed.y - speed.theta * trackWidth / 2;
+    return true;
+}
+
+float DriveCompensator::tractionRatio(Side& side, float& power, float ground, float velocity) {
+    const float wheel = velocity * side.wheelRatio / 60 * M_PI * wheelDiameter;
+    const float slip = wheel - ground;
+    if (std::fabs(slip) > traction.slip && !side.slipping) {
+        side.slipping = true;
+        side.slipDirection = slip > 0 ? 1 : -1;
+    }
+    if (!side.slipping) return 1;
+    // while the wheels are still slipping, only ask for the speed of the ground, so they slow down and grip again.
+    // Once they grip, let them run lead ahead of it, in the direction they slipped
+    const float lead = std::fabs(slip) > traction.slip / 2 ? 0 : traction.lead;
+    const float maxVelocity = rpm / 60 * M_PI * wheelDiameter;
+    const float cap = (ground + side.slipDirection * lead) / maxVelocity * 127;
+    const bool over = (power - cap) * side.slipDirection > 0;
+    // keep limiting until the wheels grip and the command stops asking for more than they can take
+    if (!over) {
+        if (std::fabs(slip) < traction.slip / 2) side.slipping = false;
+        return 1;
+    }
+    if (power == 0) return 1;
+    // the ground is moving against the command, like when the robot is pushed, so the most this side can be asked
+    // for is nothing. Only this side is stopped, so the other side isn't scaled down to nothing with it
+    if (cap * power < 0) {
+        power = 0;
+        return 1;
+    }
+    return std::min(cap / power, 1.0f);
+}
+
+float DriveCompensator::compensate(Side& side, float power, float velocity) {
+    // torque goes with the voltage beyond the back EMF, over the resistance of the windings
+    const float target = power / 127 * model.nominalVoltage;
+    const float backEmf = velocity / model.freeSpeed * model.nominalVoltage;
+    return backEmf + (target - backEmf) * side.resistance;
+}
+
+void DriveCompensator::send(const Side& side, float power, float voltage) {
+    // stopping is left to the brake mode, like it is without compensation
+    if (power == 0) side.motors->move(0);
+    else side.motors->move_voltage(std::round(voltage));
+}
+
+void DriveCompensator::move(float left, float right) {
+    const bool tractionControl = traction.slip > 0;
+    const bool compensation = model.freeSpeed > 0;
+    float leftVelocity = 0, rightVelocity = 0;
+    if (tractionControl || compensation) motorVelocities(leftVelocity, rightVelocity);
+    float leftGround, rightGround;
+    if (tractionControl && groundSpeeds(leftGround, rightGround)) {
+        // scale both sides together, so the robot keeps its curvature while the wheels grip again
+        const float leftRatio = tractionRatio(this->left, left, leftGround, leftVelocity);
+        const float ratio = std::min(leftRatio, tractionRatio(this->right, right, rightGround, rightVelocity));
+        left *= ratio;
+        right *= ratio;
+    }
+    if (!compensation) {
+        this->left.motors->move(left);
+        this->right.motors->move(right);
+        return;
+    }
+    updateConditions();
+    float leftVoltage = compensate(this->left, left, leftVelocity);
+    float rightVoltage = compensate(this->right, right, rightVelocity);
+    // scale both sides together, so what can't be supplied slows the robot down without changing its curvature
+    const float limit = std::min(MAX_VOLTAGE, battery);
+    const float ratio = std::max(std::fabs(leftVoltage), std::fabs(rightVoltage)) / limit;
+    if (ratio > 1) {
+        leftVoltage /= ratio;
+        rightVoltage /= ratio;
+    }
+    send(this->left, left, leftVoltage);
+    send(this->right, right, rightVoltage);
+}
+
+void DriveCompensator::moveSide(Side& side, float power, bool isLeft) {
+    const bool tractionControl = traction.slip > 0;
+    const bool compensation = model.freeSpeed > 0;
+    float leftVelocity = 0, rightVelocity = 0;
+    if (tractionControl || compensation) motorVelocities(leftVelocity, rightVelocity);
+    const float velocity = isLeft ? leftVelocity : rightVelocity;
+    float leftGround, rightGround;
+    if (tractionControl && groundSpeeds(leftGround, rightGround)) {
+        const float ratio = tractionRatio(side, power, isLeft ? leftGround : rightGround, velocity);
+        power *= ratio;
+    }
+    if (!compensation) {
+        side.motors->move(power);
+        return;
+    }
+    updateConditions();
+    const float limit = std::min(MAX_VOLTAGE, battery);
+    send(side, power, std::clamp(compensate(side, power, velocity), -limit, limit));
+}
+
+void DriveCompensator::moveLeft(float power) { moveSide(left, power, true); }
+
+void DriveCompensator::moveRight(float power) { moveSide(right, power, false); }
+} // namespace lemlib
@@ -0,0 +1,242 @@
+#include <cmath>
+#include <algorithm>
+#include "pros/error.h"
+#include "lemlib/util.hpp"
+#include "lemlib/chassis/estimator.hpp"
+
+namespace {
+using Matrix = std::array<std::array<float, 3>, 3>;
+
+constexpr float INCHES_PER_METER = 39.3701;
+// a reading further than this from the pose, in standard deviations squared, is an outlier. The chi-squared values a
+// correct reading of 1, 2 or 3 values stays under 99% of the time
+constexpr std::array<float, 3> GATE = {6.63, 9.21, 11.34};
+
+/**
+ * @brief Invert the top left n by n of a matrix with Gauss-Jordan elimination
+ *
+ * @return false if the matrix is singular
+ */
+bool invert(Matrix matrix, int n, Matrix& inverse) {
+    inverse = {};
+    for (int i = 0; i < n; i++) inverse[i][i] = 1;
+    for (int col = 0; col < n; col++) {
+        int pivot = col;
+        for (int row = col + 1; row < n; row++) {
+            if (std::fabs(matrix[row][col]) > std::fabs(matrix[pivot][col])) pivot = row;
+        }
+        if (std::fabs(matrix[pivot][col]) < 1e-12f) return false;
+        std::swap(matrix[col], matrix[pivot]);
+        std::swap(inverse[col], inverse[pivot]);
+        const float scale = 1 / matrix[col][col];
+        for (int j = 0; j < n; j++) {
+            matrix[col][j] *= scale;
+            inverse[col][j] *= scale;
+        }
+        for (int row = 0; row < n; row++) {
+            if (row == col) continue;
+            const float factor = matrix[row][col];
+            for (int j = 0; j < n; j++) {
+                matrix[row][j] -= factor * matrix[col][j];
+                inverse[row][j] -= factor * inverse[col][j];
+            }
+        }
+    }
+    return true;
+}
+} // namespace
+
+int lemlib::PoseSource::getAccepted() const { return accepted; }
+
+int lemlib::PoseSource::getRejected() const { return rejected; }
+
+lemlib::GpsSource::GpsSource(pros::Gps* gps, Pose origin, float minError, float headingError)
+    : gps(gps),
+      origin(origin),
+      minError(minError),
+      headingError(headingError) {}
+
+bool lemlib::GpsSource::measure(Pose pose, Measurement& measurement) {
+    const pros::gps_status_s_t status = gps->get_position_and_orientation();
+    const double heading = gps->get_heading();
+    const double error = gps->get_error();
+    if (status.x == PROS_ERR_F || heading == PROS_ERR_F || error == PROS_ERR_F) return false;
+    // the GPS only has something new when its position changes
+    if (status.x == lastX && status.y == lastY) return false;
+    lastX = status.x;
+    lastY = status.y;
+
+    // rotate and move the reading into the odometry's coordinates
+    const float rotation = degToRad(origin.theta);
+    const float gpsX = status.x * INCHES_PER_METER;
+    const float gpsY = status.y * INCHES_PER_METER;
+    const float x = origin.x + gpsX * std::cos(rotation) + gpsY * std::sin(rotation);
+    const float y = origin.y - gpsX * std::sin(rotation) + gpsY * std::cos(rotation);
+    const float theta = degToRad(heading) + rotation;
+
+    const float deviation = std::fmax(error * INCHES_PER_METER, minError);
+    measurement.size = 3;
+    measurement.residual = {x - pose.x, y - pose.y, angleError(theta, pose.theta)};
+    measurement.jacobian = {{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}};
+    measurement.variance = {deviation * deviation, deviation * deviation,
+                            degToRad(headingError) * degToRad(headingError)};
+    return true;
+}
+
+lemlib::DistanceSource::DistanceSource(pros::Distance* sensor, Pose offset, FieldBounds field)
+    : sensor(sensor),
+      offset(offset),
+      field(field) {}
+
+float lemlib::DistanceSource::predict(Pose pose) const {
+    // where the sensor is, and which way it faces
+    const float x = pose.x + offset.x * std::cos(pose.theta) + offset.y * std::sin(pose.theta);
+    const float y = pose.y - offset.x * std::sin(pose.theta) + offset.y * std::cos(pose.theta);
+    if (x <= field.minX || x >= field.maxX || y <= field.minY || y >= field.maxY) return -1;
+    const float beam = pose.theta + degToRad(offset.theta);
+    const float dx = std::sin(beam);
+    const float dy = std::cos(beam);
+    // distance along the beam to the nearest wall it's heading towards
+    float distance = INFINITY;
+    if (dx > 0) distance = std::fmin(distance, (field.maxX - x) / dx);
+    if (dx < 0) distance = std::fmin(distance, (field.minX - x) / dx);
+    if (dy > 0) distance = std::fmin(distance, (field.maxY - y) / dy);
+    if (dy < 0) distance = std::fmin(distance, (field.minY - y) / dy);
+    return distance;
+}
+
+bool lemlib::DistanceSource::measure(Pose pose, Measurement& measurement) {
+    const int reading = sensor->get();
+    // 9999 means nothing is in range
+    if (reading == PROS_ERR || reading <= 0 || reading >= 9999 || reading == lastReading) return false;
+    lastReading = reading;
+    // confidence is only reported past 200mm, and low confidence readings are usually off the edge of something
+    if (reading > 200 && sensor->get_confidence() < 32) return false;
+
+    const float expected = predict(pose);
+    if (expected < 0) return false;
+    const float distance = reading / 25.4;
+    // the sensor is accurate to 15mm under 200mm, and 5% past that
+    const float deviation = reading < 200 ? 0.6 : 0.05 * distance;
+    measurement.size = 1;
+    measurement.residual = {distance - expected, 0, 0};
+    // how the reading changes with the pose, by central differences
+    constexpr std::array<float, 3> STEP = {0.01, 0.01, 0.001};
+    for (int i = 0; i < 3; i++) {
+        Pose ahead = pose;
+        Pose behind = pose;
+        (i == 0 ? ahead.x : i == 1 ? ahead.y : ahead.theta) += STEP[i];
+        (i == 0 ? behind.x : i == 1 ? behind.y : behind.theta) -= STEP[i];
+        measurement.jacobian[0][i] = (predict(ahead) - predict(behind)) / (2 * STEP[i]);
+    }
+    measurement.variance = {deviation * deviation, 0, 0};
+    return true;
+}
+
+lemlib::PoseFilter::PoseFilter(float distanceNoise, float headingNoise)
+    : distanceNoise(distanceNoise),
+      headingNoise(headingNoise) {}
+
+void lemlib::PoseFilter::reset(float positionDeviation, float headingDeviation) {
+    covariance = {};
+    covariance[0][0] = positionDeviation * positionDeviation;
+    covariance[1][1] = positionDeviation * positionDeviation;
+    covariance[2][2] = headingDeviation * headingDeviation;
+}
+
+void lemlib::PoseFilter::predict(float localX, float localY, float avgHeading, float deltaHeading) {
+    // jacobian of the odometry update with respect to the pose before it
+    const float sin = std::sin(avgHeading);
+    const float cos = std::cos(avgHeading);
+    const Matrix F = {{{1, 0, localY * cos + localX * sin}, {0, 1, -localY * sin + localX * cos}, {0, 0, 1}}};
+    Matrix next {};
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            for (int k = 0; k < 3; k++) {
+                for (int l = 0; l < 3; l++) next[i][j] += F[i][k] * covariance[k][l] * F[j][l];
+            }
+        }
+    }
+    // the odometry's own error grows with how far it moved and turned
+    const float distance = distanceNoise * std::hypot(localX, localY);
+    const float turn = headingNoise * std::fabs(deltaHeading);
+    next[0][0] += distance * distance;
+    next[1][1] += distance * distance;
+    next[2][2] += turn * turn;
+    covariance = next;
+}
+
+bool lemlib::PoseFilter::correct(Pose& pose, PoseSource& source) {
+    Measurement measurement;
+    if (!source.measure(pose, measurement)) return false;
+    const int n = std::clamp(measurement.size, 1, 3);
+    const auto& H = measurement.jacobian;
+    const auto& y = measurement.residual;
+
+    // covariance of the residual
+    Matrix PHt {};
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < n; j++) {
+            for (int k = 0; k < 3; k++) PHt[i][j] += covariance[i][k] * H[j][k];
+        }
+    }
+    Matrix S {};
+    for (int a = 0; a < n; a++) {
+        for (int b = 0; b < n; b++) {
+            for (int i = 0; i < 3; i++) S[a][b] += H[a][i] * PHt[i][b];
+        }
+        S[a][a] += measurement.variance[a];
+    }
+    Matrix inverse;
+    if (!invert(S, n, inverse)) return false;
+
+    // reject the reading if it's too far from the pose, given how uncertain both are
+    float distance = 0;
+    for (int a = 0; a < n; a++) {
+        for (int b = 0; b < n; b++) distance += y[a] * inverse[a][b] * y[b];
+    }
+    if (distance > GATE[n - 1]) {
+        source.rejected++;
+        return false;
+    }
+
+    // kalman gain, and the corrected pose
+    Matrix K {};
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < n; j++) {
+            for (int k = 0; k < n; k++) K[i][j] += PHt[i][k] * inverse[k][j];
+        }
+    }
+    std::array<float, 3> change {};
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < n; j++) change[i] += K[i][j] * y[j];
+    }
+    pose.x += change[0];
+    pose.y += change[1];
+    pose.theta += change[2];
+
+    // Joseph form, which keeps the covariance symmetric and positive even with rounding
+    Matrix A {};
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            A[i][j] = i == j;
+            for (int k = 0; k < n; k++) A[i][j] -= K[i][k] * H[k][j];
+        }
+    }
+    Matrix next {};
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            for (int k = 0; k < 3; k++) {
+                for (int l = 0; l < 3; l++) next[i][j] += A[i][k] * covariance[k][l] * A[j][l];
+            }
+            for (int k = 0; k < n; k++) next[i][j] += K[i][k] * measurement.variance[k] * K[j][k];
+        }
+    }
+    covariance = next;
+    source.accepted++;
+    return true;
+}
+
+lemlib::Pose lemlib::PoseFilter::getDeviation() const {
+    return {std::sqrt(covariance[0][0]), std::sqrt(covariance[1][1]), std::sqrt(covariance[2][2])};
+}
@@ -0,0 +1,228 @@
+#include <cmath>
+#include <span>
+#include <string>
+#include <vector>
+#include "pros/rtos.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/profiler.hpp"
+#include "lemlib/path.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/pursuit.hpp"
+
+/**
+ * @brief function that returns elements in a file line, separated by a delimiter
+ *
+ * @param input the raw string
+ * @param delimiter string separating the elements in the line
+ * @return std::vector<std::string> array of elements read from the file
+ */
+std::vector<std::string> readElement(const std::string& input, const std::string& delimiter) {
+    std::string token;
+    std::string s = input;
+    std::vector<std::string> output;
+    size_t pos = 0;
+
+    // main loop
+    while ((pos = s.find(delimiter)) != std::string::npos) { // while there are still delimiters in the string
+        token = s.substr(0, pos); // processed substring
+        output.push_back(token);
+        s.erase(0, pos + delimiter.length()); // remove the read substring
+    }
+
+    output.push_back(s); // add the last element to the returned string
+
+    return output;
+}
+
+/**
+ * @brief Convert a string to hex
+ *
+ * @param input the string to convert
+ * @return std::string hexadecimal output
+ */
+std::string stringToHex(const std::string& input) {
+    static const char hexDigits[] = "0123456789ABCDEF";
+
+    std::string output;
+    output.reserve(input.length() * 2);
+    for (unsigned char c : input) {
+        output.push_back('\\');
+        output.push_back('x');
+        output.push_back(hexDigits[c >> 4]);
+        output.push_back(hexDigits[c & 15]);
+    }
+    return output;
+}
+
+/**
+ * @brief Get a path from a text asset
+ *
+ * @param path The file to read from
+ * @return std::vector<lemlib::PathPoint> vector of points on the path
+ */
+std::vector<lemlib::PathPoint> getData(const asset& path) {
+    std::vector<lemlib::PathPoint> robotPath;
+    std::string line;
+    std::vector<std::string> pointInput;
+    lemlib::PathPoint pathPoint {0, 0, 0, 0, 0};
+
+    // format data from the asset
+    const std::string data(reinterpret_cast<char*>(path.buf), path.size);
+    const std::vector<std::string> dataLines = readElement(data, "\n");
+
+    // read the points until 'endData' is read
+    for (std::string line : dataLines) {
+        lemlib::infoSink()->debug("read raw line {}", stringToHex(line));
+        if (line == "endData" || line == "endData\r") break;
+        pointInput = readElement(line, ", "); // parse line
+        // check if the line was read correctly
+        if (pointInput.size() != 3) {
+            lemlib::infoSink()->error("Failed to read path file! Are you using the right format? Raw line: {}",
+                                      stringToHex(line));
+            break;
+        }
+        pathPoint.x = std::stof(pointInput.at(0)); // x position
+        pathPoint.y = std::stof(pointInput.at(1)); // y position
+        pathPoint.speed = std::stof(pointInput.at(2)); // velocity
+        robotPath.push_back(pathPoint); // save data
+        lemlib::infoSink()->debug("read point {}, {}, {}", pathPoint.x, pathPoint.y, pathPoint.speed);
+    }
+
+    lemlib::annotatePath(robotPath);
+    return robotPath;
+}
+
+/**
+ * @brief Get the curvature of a circle that intersects the robot and the lookahead point
+ *
+ * @param pos the position of the robot
+ * @param heading the heading of the robot
+ * @param lookahead the lookahead point
+ * @return float curvature
+ */
+float findLookaheadCurvature(lemlib::Pose pose, float heading, lemlib::Pose lookahead) {
+    // calculate whether the robot is on the left or right side of the circle
+    float side = lemlib::sgn(std::sin(heading) * (lookahead.x - pose.x) - std::cos(heading) * (lookahead.y - pose.y));
+    // calculate center point and radius
+    float a = -std::tan(heading);
+    float c = std::tan(heading) * pose.x - pose.y;
+    float x = std::fabs(a * lookahead.x + lookahead.y + c) / std::sqrt((a * a) + 1);
+    float d = std::hypot(lookahead.x - pose.x, lookahead.y - pose.y);
+
+    // return curvature
+    return side * ((2 * x) / (d * d));
+}
+
+void lemlib::Chassis::follow(const asset& path, float lookahead, int timeout, bool forwards, bool async) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([&]() { follow(path, lookahead, timeout, forwards, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    // binary paths are used straight from the asset, text ones have to be parsed first
+    std::vector<PathPoint> parsedPoints;
+    std::span<const PathPoint> pathPoints;
+    if (isBinaryPath(path)) {
+        pathPoints = binaryPathPoints(path);
+        if (pathPoints.size() == 0) infoSink()->error("Binary path is from another version or isn't aligned!");
+    } else {
+        parsedPoints = getData(path);
+        pathPoints = parsedPoints;
+    }
+    if (pathPoints.size() == 0) {
+        infoSink()->error("No points in path! Do you have the right format? Skipping motion");
+        // set distTraveled to -1 to indicate that the function has finished
+        distTraveled = -1;
+        // give the mutex back
+        this->endMotion();
+        return;
+    }
+    Pose pose = this->getPose(true);
+    Pose lastPose = pose;
+    Pose lookaheadPose(0, 0, 0);
+    Pose lastLookahead(pathPoints[0].x, pathPoints[0].y, 0);
+    float curvature;
+    float targetVel;
+    float prevLeftVel = 0;
+    float prevRightVel = 0;
+    // search the whole path once, after that only points near the last closest point are searched
+    int closestPoint = findClosest(pose, pathPoints, 0, pathPoints.size());
+    float leftInput = 0;
+    float rightInput = 0;
+    float prevVel = 0;
+    distTraveled = 0;
+
+    // loop until the robot is within the end tolerance
+    for (int i = 0; i < timeout / 10 && this->motionRunning; i++) {
+        // get the position of the robot when the motors respond
+        const Pose measured = this->getPose(true);
+        pose = this->getPredictedPose(true);
+        if (!forwards) pose.theta -= M_PI;
+
+        // update completion vars
+        distTraveled += measured.distance(lastPose);
+        lastPose = measured;
+
+        // find the closest point on the path to the robot. It can't move more than the lookahead distance in a tick, so
+        // only points within that distance along the path of the last closest point are searched
+        const float closestDist = pathPoints[closestPoint].distance;
+        closestPoint = findClosest(pose, pathPoints, pathIndexAt(pathPoints, closestDist - lookahead),
+                                   pathIndexAt(pathPoints, closestDist + lookahead) + 1);
+        // if the robot is at the end of the path, then stop
+        if (pathPoints[closestPoint].speed == 0) break;
+
+        // find the lookahead point. The lookahead circle crosses the path within a few lookahead distances of the
+        // closest point, unless the path doubles back inside the circle, so segments past that aren't searched
+        lookaheadPose =
+            lookaheadPoint(lastLookahead, pose, pathPoints, closestPoint, lookahead,
+                           pathIndexAt(pathPoints, pathPoints[closestPoint].distance + 3 * lookahead) + 1);
+        lastLookahead = lookaheadPose; // update last lookahead position
+
+        // get the curvature of the arc between the robot and the lookahead point
+        float curvatureHeading = M_PI / 2 - pose.theta;
+        curvature = findLookaheadCurvature(pose, curvatureHeading, lookaheadPose);
+
+        // get the target velocity of the robot
+        targetVel = pathPoints[closestPoint].speed;
+        targetVel = slew(targetVel, prevVel, lateralSettings.slew);
+        prevVel = targetVel;
+
+        // calculate target left and right velocities
+        float targetLeftVel = targetVel * (2 + curvature * drivetrain.trackWidth) / 2;
+        float targetRightVel = targetVel * (2 - curvature * drivetrain.trackWidth) / 2;
+
+        // ratio the speeds to respect the max speed
+        float ratio = std::max(std::fabs(targetLeftVel), std::fabs(targetRightVel)) / 127;
+        if (ratio > 1) {
+            targetLeftVel /= ratio;
+            targetRightVel /= ratio;
+        }
+
+        // update previous velocities
+        prevLeftVel = targetLeftVel;
+        prevRightVel = targetRightVel;
+
+        // move the drivetrain
+        if (forwards) {
+            compensator.move(targetLeftVel, targetRightVel);
+        } else {
+            compensator.move(-targetRightVel, -targetLeftVel);
+        }
+
+        lemlib::profiler::delay(10);
+    }
+
+    // stop the robot
+    compensator.move(0, 0);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+}
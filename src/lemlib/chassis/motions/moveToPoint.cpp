@@ -0,0 +1,164 @@
+#include <cmath>
+#include <algorithm>
+#include <optional>
+#include "pros/rtos.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/profiler.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/odom.hpp"
+
+void lemlib::Chassis::moveToPoint(float x, float y, int timeout, MoveToPointParams params, bool async) {
+    params.earlyExitRange = std::fabs(params.earlyExitRange);
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([&]() { moveToPoint(x, y, timeout, params, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    distTraveled = 0;
+    runMoveToPoint(x, y, timeout, params);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+}
+
+float lemlib::Chassis::runMoveToPoint(float x, float y, int timeout, MoveToPointParams params, float startOutput,
+                                     bool stop) {
+    // reset PIDs and exit conditions
+    lateralPID.reset();
+    lateralLargeExit.reset();
+    lateralSmallExit.reset();
+    lateralSettle.reset();
+    angularPID.reset();
+
+    // initialize vars used between iterations
+    Pose lastPose = getPose();
+    Timer timer(timeout);
+    bool close = false;
+    float prevLateralOut = startOutput; // previous lateral power
+    float prevAngularOut = 0; // previous angular power
+    std::optional<bool> prevSide = std::nullopt;
+
+    // calculate target pose in standard form
+    Pose target(x, y);
+    target.theta = lastPose.angle(target);
+
+    // plan the motion profile, if profiling is enabled
+    const bool profiled = profileSettings.maxAcceleration > 0;
+    const float profileDistance = lastPose.distance(target);
+    const MotionProfile profile = planProfile(profileDistance, params.forwards, params.maxSpeed, params.minSpeed);
+
+    // main loop
+    while (!timer.isDone() &&
+           ((!lateralSmallExit.getExit() && !lateralLargeExit.getExit() && !lateralSettle.getExit()) || !close) &&
+           this->motionRunning) {
+        // update position. Steer with where the robot will be when the motors respond
+        const Pose measured = getPose(true, true);
+        const Pose pose = getPredictedPose(true, true);
+
+        // update distance traveled
+        distTraveled += measured.distance(lastPose);
+        lastPose = measured;
+
+        // calculate distance to the target point
+        const float distTarget = pose.distance(target);
+
+        // check if the robot is close enough to the target to start settling
+        if (distTarget < 7.5 && close == false) {
+            close = true;
+            params.maxSpeed = std::fmax(std::fabs(prevLateralOut), 60);
+        }
+
+        // motion chaining
+        const bool side = (pose.y - target.y) * -std::sin(target.theta) <=
+                          (pose.x - target.x) * std::cos(target.theta) + params.earlyExitRange;
+        if (prevSide == std::nullopt) prevSide = side;
+        const bool sameSide = side == prevSide;
+        // exit if close
+        if (!sameSide && params.minSpeed != 0) break;
+        prevSide = side;
+
+        // calculate error
+        const float adjustedRobotTheta = params.forwards ? pose.theta : pose.theta + M_PI;
+        const float angularError = angleError(adjustedRobotTheta, pose.angle(target));
+        float lateralError = pose.distance(target) * std::cos(angleError(pose.theta, pose.angle(target)));
+
+        // update exit conditions
+        lateralSmallExit.update(lateralError);
+        lateralLargeExit.update(lateralError);
+        const Pose speed = getSpeed();
+        lateralSettle.update(lateralError, std::hypot(speed.x, speed.y));
+
+        // get output from PIDs
+        // when following a profile, feedforward drives the robot and the PID corrects how far it is from where the
+        // profile says it should be. Once the profile ends this is the same as the lateral error
+        float lateralOut;
+        if (profiled) {
+            const ProfileState reference = profile.sample(timer.getTimePassed() / 1000.0);
+            const float direction = params.forwards ? 1 : -1;
+            lateralOut = lateralPID.update(lateralError - direction * (profileDistance - reference.position)) +
+                         direction * profileFeedforward(reference);
+        } else {
+            lateralOut = lateralPID.update(lateralError);
+        }
+        float angularOut = angularPID.update(radToDeg(angularError));
+        if (close) angularOut = 0;
+
+        // apply restrictions on angular speed
+        angularOut = std::clamp(angularOut, -params.maxSpeed, params.maxSpeed);
+        angularOut = slew(angularOut, prevAngularOut, angularSettings.slew);
+
+        // apply restrictions on lateral speed
+        lateralOut = std::clamp(lateralOut, -params.maxSpeed, params.maxSpeed);
+        // constrain lateral output by max accel
+        // but not for decelerating, since that would interfere with settling
+        // or when following a profile, since the profile already limits acceleration
+        if (!close && !profiled) lateralOut = slew(lateralOut, prevLateralOut, lateralSettings.slew);
+
+        // prevent moving in the wrong direction
+        if (params.forwards && !close) lateralOut = std::fmax(lateralOut, 0);
+        else if (!params.forwards && !close) lateralOut = std::fmin(lateralOut, 0);
+
+        // constrain lateral output by the minimum speed
+        if (params.forwards && lateralOut < std::fabs(params.minSpeed) && lateralOut > 0)
+            lateralOut = std::fabs(params.minSpeed);
+        if (!params.forwards && -lateralOut < std::fabs(params.minSpeed) && lateralOut < 0)
+            lateralOut = -std::fabs(params.minSpeed);
+
+        // update previous output
+        prevAngularOut = angularOut;
+        prevLateralOut = lateralOut;
+
+        infoSink()->debug("Angular Out: {}, Lateral Out: {}", angularOut, lateralOut);
+
+        // ratio the speeds to respect the max speed
+        float leftPower = lateralOut + angularOut;
+        float rightPower = lateralOut - angularOut;
+        const float ratio = std::max(std::fabs(leftPower), std::fabs(rightPower)) / params.maxSpeed;
+        if (ratio > 1) {
+            leftPower /= ratio;
+            rightPower /= ratio;
+        }
+
+        // move the drivetrain
+        compensator.move(leftPower, rightPower);
+
+        // delay to save resources
+        lemlib::profiler::delay(10);
+    }
+
+    // stop the drivetrain, unless the next motion in a chain carries on from here
+    if (stop) {
+        compensator.move(0, 0);
+    }
+    // report the timing of the motion
+    recordMotion("moveToPoint", timer, lateralSmallExit, lateralLargeExit, lateralSettle);
+    return prevLateralOut;
+}
@@ -0,0 +1,219 @@
+#include <cmath>
+#include <algorithm>
+#include "pros/rtos.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/profiler.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/odom.hpp"
+
+/**
+ * @brief Estimate how far the robot has to travel to reach the target, following the carrot point
+ *
+ * The boomerang path lies between the straight line to the target and the path through the carrot point, so this
+ * takes the average of the two.
+ *
+ * @param pose the current pose of the robot
+ * @param target the target pose
+ * @param carrot the carrot point
+ * @return float distance, in inches
+ */
+float boomerangDistance(lemlib::Pose pose, lemlib::Pose target, lemlib::Pose carrot) {
+    return (pose.distance(target) + pose.distance(carrot) + carrot.distance(target)) / 2;
+}
+
+void lemlib::Chassis::moveToPose(float x, float y, float theta, int timeout, MoveToPoseParams params, bool async) {
+    // take the mutex
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([&]() { moveToPose(x, y, theta, timeout, params, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    distTraveled = 0;
+    runMoveToPose(x, y, theta, timeout, params);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+}
+
+float lemlib::Chassis::runMoveToPose(float x, float y, float theta, int timeout, MoveToPoseParams params,
+                                    float startOutput, bool stop) {
+    // reset PIDs and exit conditions
+    lateralPID.reset();
+    lateralLargeExit.reset();
+    lateralSmallExit.reset();
+    angularPID.reset();
+    angularLargeExit.reset();
+    angularSmallExit.reset();
+    lateralSettle.reset();
+    angularSettle.reset();
+
+    // calculate target pose in standard form
+    Pose target(x, y, M_PI_2 - degToRad(theta));
+    if (!params.forwards) target.theta = std::fmod(target.theta + M_PI, 2 * M_PI); // backwards movement
+
+    // use global horizontalDrift is horizontalDrift is 0
+    if (params.horizontalDrift == 0) params.horizontalDrift = drivetrain.horizontalDrift;
+
+    // initialize vars used between iterations
+    Pose lastPose = getPose();
+    Timer timer(timeout);
+    bool close = false;
+    bool lateralSettled = false;
+    bool prevSameSide = false;
+    float prevLateralOut = startOutput; // previous lateral power
+    float prevAngularOut = 0; // previous angular power
+
+    // plan the motion profile, if profiling is enabled. The profile is slowed down for the curve towards the first
+    // carrot point
+    const bool profiled = profileSettings.maxAcceleration > 0;
+    const Pose startPose = getPose(true, true);
+    const Pose startCarrot =
+        target - Pose(std::cos(target.theta), std::sin(target.theta)) * params.lead * startPose.distance(target);
+    const float profileDistance = boomerangDistance(startPose, target, startCarrot);
+    const MotionProfile profile = planProfile(profileDistance, params.forwards, params.maxSpeed, params.minSpeed,
+                                              getCurvature(startPose, startCarrot));
+
+    // main loop
+    while (!timer.isDone() &&
+           ((!lateralSettled ||
+             (!angularLargeExit.getExit() && !angularSmallExit.getExit() && !angularSettle.getExit())) ||
+            !close) &&
+           this->motionRunning) {
+        // update position. Steer with where the robot will be when the motors respond
+        const Pose measured = getPose(true, true);
+        const Pose pose = getPredictedPose(true, true);
+
+        // update distance traveled
+        distTraveled += measured.distance(lastPose);
+        lastPose = measured;
+
+        // calculate distance to the target point
+        const float distTarget = pose.distance(target);
+
+        // check if the robot is close enough to the target to start settling
+        if (distTarget < 7.5 && close == false) {
+            close = true;
+            params.maxSpeed = std::fmax(std::fabs(prevLateralOut), 60);
+            // the PID goes back to correcting the lateral error, so don't let the profile's error carry over
+            if (profiled) lateralPID.reset();
+        }
+
+        // check if the lateral controller has settled
+        if ((lateralLargeExit.getExit() && lateralSmallExit.getExit()) || lateralSettle.getExit())
+            lateralSettled = true;
+
+        // calculate the carrot point
+        Pose carrot = target - Pose(std::cos(target.theta), std::sin(target.theta)) * params.lead * distTarget;
+        if (close) carrot = target; // settling behavior
+
+        // calculate if the robot is on the same side as the carrot point
+        const bool robotSide = (pose.y - target.y) * -std::sin(target.theta) <=
+                               (pose.x - target.x) * std::cos(target.theta) + params.earlyExitRange;
+        const bool carrotSide = (carrot.y - target.y) * -std::sin(target.theta) <=
+                                (carrot.x - target.x) * std::cos(target.theta) + params.earlyExitRange;
+        const bool sameSide = robotSide == carrotSide;
+        // exit if close
+        if (!sameSide && prevSameSide && close && params.minSpeed != 0) break;
+        prevSameSide = sameSide;
+
+        // calculate error
+        const float adjustedRobotTheta = params.forwards ? pose.theta : pose.theta + M_PI;
+        const float angularError =
+            close ? angleError(adjustedRobotTheta, target.theta) : angleError(adjustedRobotTheta, pose.angle(carrot));
+        float lateralError = pose.distance(carrot);
+        // only use cos when settling
+        // otherwise just multiply by the sign of cos
+        // maxSlipSpeed takes care of lateralOut
+        if (close) lateralError *= std::cos(angleError(pose.theta, pose.angle(carrot)));
+        else lateralError *= sgn(std::cos(angleError(pose.theta, pose.angle(carrot))));
+
+        // update exit conditions
+        lateralSmallExit.update(lateralError);
+        lateralLargeExit.update(lateralError);
+        angularSmallExit.update(radToDeg(angularError));
+        angularLargeExit.update(radToDeg(angularError));
+        const Pose speed = getSpeed();
+        lateralSettle.update(lateralError, std::hypot(speed.x, speed.y));
+        angularSettle.update(radToDeg(angularError), speed.theta);
+
+        // get output from PIDs
+        // when following a profile, feedforward drives the robot and the PID corrects how far it is from where the
+        // profile says it should be, until it's close enough to settle
+        float lateralOut;
+        if (profiled && !close) {
+            const ProfileState reference = profile.sample(timer.getTimePassed() / 1000.0);
+            const float direction = params.forwards ? 1 : -1;
+            const float profileError =
+                boomerangDistance(pose, target, carrot) - (profileDistance - reference.position);
+            lateralOut = direction * (lateralPID.update(profileError) + profileFeedforward(reference));
+        } else {
+            lateralOut = lateralPID.update(lateralError);
+        }
+        float angularOut = angularPID.update(radToDeg(angularError));
+
+        // apply restrictions on angular speed
+        angularOut = std::clamp(angularOut, -params.maxSpeed, params.maxSpeed);
+
+        // apply restrictions on lateral speed
+        lateralOut = std::clamp(lateralOut, -params.maxSpeed, params.maxSpeed);
+
+        // constrain lateral output by max accel, which the profile already does if there is one
+        if (!close && !profiled) lateralOut = slew(lateralOut, prevLateralOut, lateralSettings.slew);
+
+        // constrain lateral output by the max speed it can travel at without
+        // slipping
+        const float radius = 1 / std::fabs(getCurvature(pose, carrot));
+        const float maxSlipSpeed(std::sqrt(params.horizontalDrift * radius * 9.8));
+        lateralOut = std::clamp(lateralOut, -maxSlipSpeed, maxSlipSpeed);
+        // prioritize angular movement over lateral movement
+        const float overturn = std::fabs(angularOut) + std::fabs(lateralOut) - params.maxSpeed;
+        if (overturn > 0) lateralOut -= lateralOut > 0 ? overturn : -overturn;
+
+        // prevent moving in the wrong direction
+        if (params.forwards && !close) lateralOut = std::fmax(lateralOut, 0);
+        else if (!params.forwards && !close) lateralOut = std::fmin(lateralOut, 0);
+
+        // constrain lateral output by the minimum speed
+        if (params.forwards && lateralOut < std::fabs(params.minSpeed) && lateralOut > 0)
+            lateralOut = std::fabs(params.minSpeed);
+        if (!params.forwards && -lateralOut < std::fabs(params.minSpeed) && lateralOut < 0)
+            lateralOut = -std::fabs(params.minSpeed);
+
+        // update previous output
+        prevAngularOut = angularOut;
+        prevLateralOut = lateralOut;
+
+        infoSink()->debug("lateralOut: {} angularOut: {}", lateralOut, angularOut);
+
+        // ratio the speeds to respect the max speed
+        float leftPower = lateralOut + angularOut;
+        float rightPower = lateralOut - angularOut;
+        const float ratio = std::max(std::fabs(leftPower), std::fabs(rightPower)) / params.maxSpeed;
+        if (ratio > 1) {
+            leftPower /= ratio;
+            rightPower /= ratio;
+        }
+
+        // move the drivetrain
+        compensator.move(leftPower, rightPower);
+
+        // delay to save resources
+        lemlib::profiler::delay(10);
+    }
+
+    // stop the drivetrain, unless the next motion in a chain carries on from here
+    if (stop) {
+        compensator.move(0, 0);
+    }
+    // report the timing of the motion
+    recordMotion("moveToPose", timer, lateralSmallExit, lateralLargeExit, lateralSettle);
+    return prevLateralOut;
+}
@@ -0,0 +1,130 @@
+#include <cmath>
+#include <algorithm>
+#include <variant>
+#include <vector>
+#include "pros/rtos.hpp"
+#include "lemlib/util.hpp"
+#include "lemlib/chassis/chassis.hpp"
+
+namespace {
+/**
+ * @brief The parts of a queued motion's parameters that chaining cares about, whichever motion it is
+ */
+struct Segment {
+        lemlib::Pose target; // with the direction the robot travels in as it arrives, for a pose
+        bool pose;
+        bool forwards;
+        float maxSpeed;
+        float lead;
+};
+
+Segment toSegment(const lemlib::QueuedMotion& motion) {
+    Segment segment {lemlib::Pose(motion.x, motion.y), false, true, 127, 0};
+    if (const auto* pose = std::get_if<lemlib::MoveToPoseParams>(&motion.params)) {
+        segment.pose = true;
+        segment.forwards = pose->forwards;
+        segment.maxSpeed = pose->maxSpeed;
+        segment.lead = pose->lead;
+        segment.target.theta = M_PI_2 - lemlib::degToRad(motion.theta);
+        if (!pose->forwards) segment.target.theta += M_PI;
+    } else {
+        const auto& point = std::get<lemlib::MoveToPointParams>(motion.params);
+        segment.forwards = point.forwards;
+        segment.maxSpeed = point.maxSpeed;
+    }
+    return segment;
+}
+
+/**
+ * @brief Plan the speed the robot passes through each target of a chain at
+ *
+ * The speed is the slower of the max speeds on either side, scaled by the cosine of how much the path turns at the
+ * target, so the robot only slows down for corners. The path turns from the direction the robot arrives in, to the
+ * direction of the next target's first carrot point. The last target, and targets where the path reverses or turns by
+ * 90 degrees or more, get a speed of 0.
+ *
+ * @param motions the queued motions
+ * @param start where the robot starts the chain
+ * @return std::vector<float> the speed at each target, out of 127
+ */
+std::vector<float> planJunctions(const std::vector<lemlib::QueuedMotion>& motions, lemlib::Pose start) {
+    std::vector<Segment> segments;
+    for (const lemlib::QueuedMotion& motion : motions) segments.push_back(toSegment(motion));
+    std::vector<float> speeds(motions.size(), 0);
+    lemlib::Pose from = start;
+    for (size_t i = 0; i + 1 < segments.size(); i++) {
+        const Segment& current = segments[i];
+        const Segment& next = segments[i + 1];
+        // a point is arrived at from the last target
+        const float arrive = current.pose ? current.target.theta : from.angle(current.target);
+        from = current.target;
+        if (current.forwards != next.forwards) continue;
+        lemlib::Pose aim = next.target;
+        if (next.pose) {
+            const float distance = current.target.distance(next.target);
+            aim = next.target - lemlib::Pose(std::cos(next.target.theta), std::sin(next.target.theta)) * next.lead *
+                                    distance;
+        }
+        const float turn = std::fabs(lemlib::angleError(current.target.angle(aim), arrive));
+        if (turn >= M_PI_2) continue;
+        speeds[i] = std::min(current.maxSpeed, next.maxSpeed) * std::cos(turn);
+    }
+    return speeds;
+}
+} // namespace
+
+void lemlib::Chassis::queuePose(float x, float y, float theta, int timeout, MoveToPoseParams params) {
+    motionQueue.push_back({x, y, theta, timeout, params});
+}
+
+void lemlib::Chassis::queuePoint(float x, float y, int timeout, MoveToPointParams params) {
+    params.earlyExitRange = std::fabs(params.earlyExitRange);
+    motionQueue.push_back({x, y, 0, timeout, params});
+}
+
+void lemlib::Chassis::runQueue(bool async) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) {
+        motionQueue.clear();
+        return;
+    }
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([&]() { runQueue(false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    // take the queue, so motions queued from now on go in the next chain
+    const std::vector<QueuedMotion> motions = std::move(motionQueue);
+    motionQueue.clear();
+    // plan the whole chain up front, so each motion knows what speed to hand over at before it starts
+    const std::vector<float> junctions = planJunctions(motions, getPose(true, true));
+
+    distTraveled = 0;
+    float output = 0; // the lateral power the last motion ended with
+    for (size_t i = 0; i < motions.size() && this->motionRunning; i++) {
+        const QueuedMotion& motion = motions[i];
+        const float junction = junctions[i];
+        // carry on from the last motion only if it didn't stop
+        const float startOutput = i > 0 && junctions[i - 1] > 0 ? output : 0;
+        if (auto* params = std::get_if<MoveToPoseParams>(&motion.params)) {
+            MoveToPoseParams chained = *params;
+            chained.minSpeed = std::fmax(chained.minSpeed, junction);
+            output =
+                runMoveToPose(motion.x, motion.y, motion.theta, motion.timeout, chained, startOutput, junction == 0);
+        } else {
+            MoveToPointParams chained = std::get<MoveToPointParams>(motion.params);
+            chained.minSpeed = std::fmax(chained.minSpeed, junction);
+            output = runMoveToPoint(motion.x, motion.y, motion.timeout, chained, startOutput, junction == 0);
+        }
+    }
+
+    // make sure the drivetrain stops if the chain was cancelled part way through a handover
+    compensator.move(0, 0);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+}
@@ -0,0 +1,110 @@
+#include <cmath>
+#include <optional>
+#include "pros/motor_group.hpp"
+#include "pros/rtos.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/profiler.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/odom.hpp"
+
+void lemlib::Chassis::swingToHeading(float theta, DriveSide lockedSide, int timeout, SwingToHeadingParams params,
+                                     bool async) {
+    params.minSpeed = std::fabs(params.minSpeed);
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([&]() { swingToHeading(theta, lockedSide, timeout, params, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+    float targetTheta;
+    float deltaTheta;
+    float motorPower;
+    float prevMotorPower = 0;
+    float startTheta = getPose().theta;
+    std::optional<float> prevRawDeltaTheta = std::nullopt;
+    std::optional<float> prevDeltaTheta = std::nullopt;
+    bool settling = false;
+    distTraveled = 0;
+    Timer timer(timeout);
+    angularLargeExit.reset();
+    angularSmallExit.reset();
+    angularSettle.reset();
+    angularPID.reset();
+    // get original braking mode of the locked side, then set it to hold
+    pros::MotorGroup* const lockedMotors =
+        lockedSide == DriveSide::LEFT ? drivetrain.leftMotors : drivetrain.rightMotors;
+    const pros::MotorBrake brakeMode = lockedMotors->get_brake_mode();
+    lockedMotors->set_brake_mode_all(pros::E_MOTOR_BRAKE_HOLD);
+
+    // main loop
+    while (!timer.isDone() && !angularLargeExit.getExit() && !angularSmallExit.getExit() && !angularSettle.getExit() &&
+           this->motionRunning) {
+        // update variables
+        Pose pose = getPose();
+        pose.theta = std::fmod(pose.theta, 360);
+
+        // update completion vars
+        distTraveled = std::fabs(angleError(pose.theta, startTheta, false));
+
+        targetTheta = theta;
+
+        // check if settling
+        const float rawDeltaTheta = angleError(targetTheta, pose.theta, false);
+        if (prevRawDeltaTheta == std::nullopt) prevRawDeltaTheta = rawDeltaTheta;
+        if (sgn(rawDeltaTheta) != sgn(prevRawDeltaTheta.value())) settling = true;
+        prevRawDeltaTheta = rawDeltaTheta;
+
+        // calculate deltaTheta
+        if (settling) deltaTheta = angleError(targetTheta, pose.theta, false);
+        else deltaTheta = angleError(targetTheta, pose.theta, false, params.direction);
+        if (prevDeltaTheta == std::nullopt) prevDeltaTheta = deltaTheta;
+
+        // motion chaining
+        if (params.minSpeed != 0 && std::fabs(deltaTheta) < params.earlyExitRange) break;
+        if (params.minSpeed != 0 && sgn(deltaTheta) != sgn(prevDeltaTheta.value())) break;
+        prevDeltaTheta = deltaTheta;
+
+        // calculate the speed
+        motorPower = angularPID.update(deltaTheta);
+        angularLargeExit.update(deltaTheta);
+        angularSmallExit.update(deltaTheta);
+        angularSettle.update(deltaTheta, getSpeed().theta);
+
+        // cap the speed
+        if (motorPower > params.maxSpeed) motorPower = params.maxSpeed;
+        else if (motorPower < -params.maxSpeed) motorPower = -params.maxSpeed;
+        if (std::fabs(deltaTheta) > 20) motorPower = slew(motorPower, prevMotorPower, angularSettings.slew);
+        if (motorPower < 0 && motorPower > -params.minSpeed) motorPower = -params.minSpeed;
+        else if (motorPower > 0 && motorPower < params.minSpeed) motorPower = params.minSpeed;
+        prevMotorPower = motorPower;
+
+        infoSink()->debug("Swing Motor Power: {} ", motorPower);
+
+        // move the drivetrain
+        if (lockedSide == DriveSide::LEFT) {
+            compensator.moveRight(-motorPower);
+            drivetrain.leftMotors->brake();
+        } else {
+            compensator.moveLeft(motorPower);
+            drivetrain.rightMotors->brake();
+        }
+
+        lemlib::profiler::delay(10);
+    }
+
+    // stop the drivetrain
+    compensator.move(0, 0);
+    // restore the brake mode of the locked side
+    lockedMotors->set_brake_mode_all(brakeMode);
+    // report the timing of the motion
+    recordMotion("swingToHeading", timer, angularSmallExit, angularLargeExit, angularSettle);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+}
@@ -0,0 +1,347 @@
+// The implementation below is mostly based off of
+// the document written by 5225A (Pilons)
+// Here is a link to the original document
+// http://thepilons.ca/wp-content/uploads/2018/10/Tracking.pdf
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include "pros/rtos.hpp"
+#include "lemlib/devices.hpp"
+#include "lemlib/profiler.hpp"
+#include "lemlib/seqlock.hpp"
+#include "lemlib/util.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/trackingWheel.hpp"
+
+// tracking thread
+pros::Task* trackingTask = nullptr;
+// longest setPose waits for odometry to apply the pose, in milliseconds
+constexpr std::uint32_t SET_POSE_TIMEOUT = 4 * lemlib::ODOM_PERIOD;
+
+/**
+ * @brief Everything odometry publishes, read all at once so it comes from the same update
+ */
+struct OdomState {
+        lemlib::Pose pose;
+        lemlib::Pose speed;
+        lemlib::Pose localSpeed;
+        lemlib::Pose deviation;
+        std::uint64_t time;
+        std::uint32_t poseRequest; // the last call to setPose the pose includes
+};
+
+/**
+ * @brief A pose setPose hands to the odometry task
+ */
+struct PoseRequest {
+        lemlib::Pose pose;
+        std::uint32_t request; // counts calls to setPose
+};
+
+// global variables
+lemlib::OdomSensors odomSensors(nullptr, nullptr, nullptr, nullptr, nullptr); // the sensors to be used for odometry
+lemlib::Drivetrain drive(nullptr, nullptr, 0, 0, 0, 0); // the drivetrain to be used for odometry
+int imuIndex = -1; // where the inertial sensor is in device snapshots
+// the state odometry works on. Only update() touches it, other tasks read what it publishes
+lemlib::Pose odomPose(0, 0, 0); // the pose of the robot
+lemlib::Pose odomSpeed(0, 0, 0); // the speed of the robot
+lemlib::Pose odomLocalSpeed(0, 0, 0); // the local speed of the robot
+std::uint64_t odomTime = 0; // when the sensors were last read, in microseconds
+lemlib::PoseFilter poseFilter; // corrects the pose from the pose sources
+std::uint32_t appliedRequest = 0; // the last call to setPose applied to the pose
+// the state published at the end of every update, which any task can read without blocking the update
+lemlib::Seqlock<OdomState> odomState({odomPose, odomSpeed, odomLocalSpeed, odomPose, 0, 0});
+// setPose leaves the pose here for the next update to apply. The mutex lets one caller write it at a time
+lemlib::Seqlock<PoseRequest> pendingPose({lemlib::Pose(0, 0, 0), 0});
+pros::Mutex poseRequestMutex;
+std::array<lemlib::PoseSource*, lemlib::MAX_POSE_SOURCES> poseSources {}; // sensors that measure the pose
+int poseSourceCount = 0;
+
+float prevVertical = 0;
+float prevVertical1 = 0;
+float prevVertical2 = 0;
+float prevHorizontal = 0;
+float prevHorizontal1 = 0;
+float prevHorizontal2 = 0;
+float prevImu = 0;
+
+void lemlib::setSensors(lemlib::OdomSensors sensors, lemlib::Drivetrain drivetrain) {
+    odomSensors = sensors;
+    drive = drivetrain;
+    imuIndex = sensors.imu != nullptr ? devices().add(sensors.imu) : -1;
+}
+
+/**
+ * @brief Apply the pose from the last call to setPose, if it hasn't been already
+ */
+void applyPoseRequest() {
+    // the odometry task outranks every caller of setPose, so it can't wait for one to finish writing. A pose caught
+    // part way through is applied next update instead
+    PoseRequest request({lemlib::Pose(0, 0, 0), appliedRequest});
+    if (!pendingPose.tryRead(request) || request.request == appliedRequest) return;
+    odomPose = request.pose;
+    // a pose that's set is known to about where the robot can be placed by hand
+    poseFilter.reset(0.5, lemlib::degToRad(1));
+    appliedRequest = request.request;
+}
+
+/**
+ * @brief Publish the state of odometry to other tasks
+ */
+void publishState() {
+    odomState.write({odomPose, odomSpeed, odomLocalSpeed, poseFilter.getDeviation(), odomTime, appliedRequest});
+}
+
+lemlib::Pose lemlib::getPose(bool radians) {
+    const Pose pose = odomState.read().pose;
+    if (radians) return pose;
+    else return lemlib::Pose(pose.x, pose.y, radToDeg(pose.theta));
+}
+
+lemlib::TimedPose lemlib::getTimedPose(bool radians) {
+    std::uint32_t sequence;
+    const OdomState state = odomState.read(&sequence);
+    Pose pose = state.pose;
+    if (!radians) pose.theta = radToDeg(pose.theta);
+    return {pose, state.time, sequence};
+}
+
+void lemlib::setPose(lemlib::Pose pose, bool radians) {
+    if (!radians) pose.theta = degToRad(pose.theta);
+    // the odometry task is the only writer of the pose, so it's handed the new one
+    poseRequestMutex.take();
+    const std::uint32_t request = pendingPose.read().request + 1;
+    pendingPose.write({pose, request});
+    poseRequestMutex.give();
+    if (trackingTask == nullptr) {
+        applyPoseRequest();
+        publishState();
+        return;
+    }
+    // wait for the next update to apply it, so the pose read after this is the one that was set. Give up after a few
+    // periods, in case odometry was suspended, and it's applied whenever it runs again
+    const std::uint32_t start = pros::millis();
+    while (static_cast<std::int32_t>(odomState.read().poseRequest - request) < 0 &&
+           pros::millis() - start < SET_POSE_TIMEOUT)
+        pros::delay(1);
+}
+
+bool lemlib::addPoseSource(PoseSource* source) {
+    if (poseSourceCount == MAX_POSE_SOURCES) return false;
+    poseSources[poseSourceCount++] = source;
+    return true;
+}
+
+lemlib::Pose lemlib::getPoseDeviation(bool radians) {
+    const Pose deviation = odomState.read().deviation;
+    if (radians) return deviation;
+    else return lemlib::Pose(deviation.x, deviation.y, radToDeg(deviation.theta));
+}
+
+lemlib::Pose lemlib::getSpeed(bool radians) {
+    const Pose speed = odomState.read().speed;
+    if (radians) return speed;
+    else return lemlib::Pose(speed.x, speed.y, radToDeg(speed.theta));
+}
+
+lemlib::Pose lemlib::getLocalSpeed(bool radians) {
+    const Pose localSpeed = odomState.read().localSpeed;
+    if (radians) return localSpeed;
+    else return lemlib::Pose(localSpeed.x, localSpeed.y, radToDeg(localSpeed.theta));
+}
+
+/**
+ * @brief Project a pose forward in time at a constant local speed
+ *
+ * The robot moves along an arc, so the distance covered is the chord of the arc, like in the odometry update.
+ */
+lemlib::Pose projectPose(lemlib::Pose pose, lemlib::Pose localSpeed, float time) {
+    // calculate the change in local position. Pose * float doesn't scale theta, so it's done by hand
+    lemlib::Pose deltaLocalPose(localSpeed.x * time, localSpeed.y * time, localSpeed.theta * time);
+    if (deltaLocalPose.theta != 0) {
+        const float chord = 2 * std::sin(deltaLocalPose.theta / 2) / deltaLocalPose.theta;
+        deltaLocalPose.x *= chord;
+        deltaLocalPose.y *= chord;
+    }
+
+    // calculate the future pose
+    float avgHeading = pose.theta + deltaLocalPose.theta / 2;
+    lemlib::Pose futurePose = pose;
+    futurePose.x += deltaLocalPose.y * std::sin(avgHeading);
+    futurePose.y += deltaLocalPose.y * std::cos(avgHeading);
+    futurePose.x += deltaLocalPose.x * -std::cos(avgHeading);
+    futurePose.y += deltaLocalPose.x * std::sin(avgHeading);
+    futurePose.theta += deltaLocalPose.theta;
+    return futurePose;
+}
+
+lemlib::Pose lemlib::estimatePose(float time, bool radians) {
+    const OdomState state = odomState.read();
+    Pose futurePose = projectPose(state.pose, state.localSpeed, time);
+    if (!radians) futurePose.theta = radToDeg(futurePose.theta);
+    return futurePose;
+}
+
+lemlib::Pose lemlib::predictPose(float latency, bool radians) {
+    const OdomState state = odomState.read();
+    // the pose is already as old as the time since its sensors were read
+    const float age = state.time == 0 ? 0 : (pros::micros() - state.time) / 1e6f;
+    Pose futurePose = projectPose(state.pose, state.localSpeed, age + latency);
+    if (!radians) futurePose.theta = radToDeg(futurePose.theta);
+    return futurePose;
+}
+
+void lemlib::update() {
+    applyPoseRequest();
+
+    // read every device once, so all of this update's readings were taken together
+    const DeviceSnapshot& snapshot = devices().update();
+
+    // get the time since the last update. Use the period for the first update
+    const std::uint64_t now = snapshot.time;
+    const float dt = odomTime == 0 ? ODOM_PERIOD / 1000.0f : (now - odomTime) / 1e6f;
+    odomTime = now;
+
+    // get the current sensor values
+    float vertical1Raw = 0;
+    float vertical2Raw = 0;
+    float horizontal1Raw = 0;
+    float horizontal2Raw = 0;
+    float imuRaw = 0;
+    if (odomSensors.vertical1 != nullptr) vertical1Raw = odomSensors.vertical1->getDistanceTraveled(snapshot);
+    if (odomSensors.vertical2 != nullptr) vertical2Raw = odomSensors.vertical2->getDistanceTraveled(snapshot);
+    if (odomSensors.horizontal1 != nullptr) horizontal1Raw = odomSensors.horizontal1->getDistanceTraveled(snapshot);
+    if (odomSensors.horizontal2 != nullptr) horizontal2Raw = odomSensors.horizontal2->getDistanceTraveled(snapshot);
+    if (odomSensors.imu != nullptr)
+        imuRaw = degToRad(imuIndex != -1 ? snapshot.imuRotations[imuIndex] : odomSensors.imu->get_rotation());
+
+    // calculate the change in sensor values
+    float deltaVertical1 = vertical1Raw - prevVertical1;
+    float deltaVertical2 = vertical2Raw - prevVertical2;
+    float deltaHorizontal1 = horizontal1Raw - prevHorizontal1;
+    float deltaHorizontal2 = horizontal2Raw - prevHorizontal2;
+    float deltaImu = imuRaw - prevImu;
+
+    // update the previous sensor values
+    prevVertical1 = vertical1Raw;
+    prevVertical2 = vertical2Raw;
+    prevHorizontal1 = horizontal1Raw;
+    prevHorizontal2 = horizontal2Raw;
+    prevImu = imuRaw;
+
+    // calculate the heading of the robot
+    // Priority:
+    // 1. Horizontal tracking wheels
+    // 2. Vertical tracking wheels
+    // 3. Inertial Sensor
+    // 4. Drivetrain
+    float heading = odomPose.theta;
+    // calculate the heading using the horizontal tracking wheels
+    if (odomSensors.horizontal1 != nullptr && odomSensors.horizontal2 != nullptr)
+        heading -= (deltaHorizontal1 - deltaHorizontal2) /
+                   (odomSensors.horizontal1->getOffset() - odomSensors.horizontal2->getOffset());
+    // else, if both vertical tracking wheels aren't substituted by the drivetrain, use them
+    else if (!odomSensors.vertical1->getType() && !odomSensors.vertical2->getType())
+        heading -= (deltaVertical1 - deltaVertical2) /
+                   (odomSensors.vertical1->getOffset() - odomSensors.vertical2->getOffset());
+    // else, if the inertial sensor exists, use it
+    else if (odomSensors.imu != nullptr) heading += deltaImu;
+    // else, use the the substituted tracking wheels
+    else
+        heading -= (deltaVertical1 - deltaVertical2) /
+                   (odomSensors.vertical1->getOffset() - odomSensors.vertical2->getOffset());
+    float deltaHeading = heading - odomPose.theta;
+    float avgHeading = odomPose.theta + deltaHeading / 2;
+
+    // choose tracking wheels to use
+    // Prioritize non-powered tracking wheels
+    lemlib::TrackingWheel* verticalWheel = nullptr;
+    lemlib::TrackingWheel* horizontalWheel = nullptr;
+    if (!odomSensors.vertical1->getType()) verticalWheel = odomSensors.vertical1;
+    else if (!odomSensors.vertical2->getType()) verticalWheel = odomSensors.vertical2;
+    else verticalWheel = odomSensors.vertical1;
+    if (odomSensors.horizontal1 != nullptr) horizontalWheel = odomSensors.horizontal1;
+    else if (odomSensors.horizontal2 != nullptr) horizontalWheel = odomSensors.horizontal2;
+    float rawVertical = 0;
+    float rawHorizontal = 0;
+    if (verticalWheel != nullptr) rawVertical = verticalWheel->getDistanceTraveled(snapshot);
+    if (horizontalWheel != nullptr) rawHorizontal = horizontalWheel->getDistanceTraveled(snapshot);
+    float horizontalOffset = 0;
+    float verticalOffset = 0;
+    if (verticalWheel != nullptr) verticalOffset = verticalWheel->getOffset();
+    if (horizontalWheel != nullptr) horizontalOffset = horizontalWheel->getOffset();
+
+    // calculate change in x and y
+    float deltaX = 0;
+    float deltaY = 0;
+    if (verticalWheel != nullptr) deltaY = rawVertical - prevVertical;
+    if (horizontalWheel != nullptr) deltaX = rawHorizontal - prevHorizontal;
+    prevVertical = rawVertical;
+    prevHorizontal = rawHorizontal;
+
+    // calculate local x and y
+    float localX = 0;
+    float localY = 0;
+    if (deltaHeading == 0) { // prevent divide by 0
+        localX = deltaX;
+        localY = deltaY;
+    } else {
+        localX = 2 * std::sin(deltaHeading / 2) * (deltaX / deltaHeading + horizontalOffset);
+        localY = 2 * std::sin(deltaHeading / 2) * (deltaY / deltaHeading + verticalOffset);
+    }
+
+    // save previous pose
+    lemlib::Pose prevPose = odomPose;
+
+    // calculate global x and y
+    odomPose.x += localY * std::sin(avgHeading);
+    odomPose.y += localY * std::cos(avgHeading);
+    odomPose.x += localX * -std::cos(avgHeading);
+    odomPose.y += localX * std::sin(avgHeading);
+    odomPose.theta = heading;
+
+    // calculate speed
+    // the smoothing was tuned for updates every 10ms, so scale it to keep the same time constant
+    if (dt > 0) {
+        const float smooth = 1 - std::pow(1 - 0.95f, dt / 0.01f);
+        odomSpeed.x = ema((odomPose.x - prevPose.x) / dt, odomSpeed.x, smooth);
+        odomSpeed.y = ema((odomPose.y - prevPose.y) / dt, odomSpeed.y, smooth);
+        odomSpeed.theta = ema((odomPose.theta - prevPose.theta) / dt, odomSpeed.theta, smooth);
+
+        // calculate local speed
+        odomLocalSpeed.x = ema(localX / dt, odomLocalSpeed.x, smooth);
+        odomLocalSpeed.y = ema(localY / dt, odomLocalSpeed.y, smooth);
+        odomLocalSpeed.theta = ema(deltaHeading / dt, odomLocalSpeed.theta, smooth);
+    }
+
+    // correct the pose from the pose sources. This comes after the speed, so corrections don't look like movement
+    if (poseSourceCount > 0) {
+        poseFilter.predict(localX, localY, avgHeading, deltaHeading);
+        for (int i = 0; i < poseSourceCount; i++) poseFilter.correct(odomPose, *poseSources[i]);
+    }
+
+    publishState();
+}
+
+void lemlib::init() {
+    if (trackingTask == nullptr) {
+        // read every sensor as fast as it can send data
+        for (lemlib::TrackingWheel* wheel :
+             {odomSensors.vertical1, odomSensors.vertical2, odomSensors.horizontal1, odomSensors.horizontal2}) {
+            if (wheel != nullptr) wheel->setDataRate(ODOM_PERIOD);
+        }
+        if (odomSensors.imu != nullptr) odomSensors.imu->set_data_rate(ODOM_PERIOD);
+        // one below the highest priority, which PROS warns can deadlock. delay_until keeps the period fixed however
+        // long the update takes
+        trackingTask = new pros::Task {[=] {
+                                           std::uint32_t time = pros::millis();
+                                           while (true) {
+                                               update();
+                                               lemlib::profiler::delayUntil(&time, ODOM_PERIOD);
+                                           }
+                                       },
+                                       TASK_PRIORITY_MAX - 1, TASK_STACK_DEPTH_DEFAULT, "LemLib Odometry"};
+    }
+}
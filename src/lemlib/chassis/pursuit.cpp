@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <cmath>
+#include "lemlib/chassis/pursuit.hpp"
+
+int lemlib::pathIndexAt(std::span<const PathPoint> path, float distance) {
+    const auto point = std::lower_bound(path.begin(), path.end(), distance,
+                                        [](const PathPoint& point, float distance) { return point.distance < distance; });
+    return std::min<int>(point - path.begin(), path.size() - 1);
+}
+
+int lemlib::findClosest(Pose pose, std::span<const PathPoint> path, int first, int last) {
+    int closestPoint = first;
+    float closestDist = INFINITY;
+    // loop through the path points in range
+    for (int i = first; i < last; i++) {
+        const float dist = std::hypot(pose.x - path[i].x, pose.y - path[i].y);
+        if (dist < closestDist) { // new closest point
+            closestDist = dist;
+            closestPoint = i;
+        }
+    }
+    return closestPoint;
+}
+
+float lemlib::circleIntersect(Pose p1, Pose p2, Pose pose, float lookaheadDist) {
+    // calculations
+    // uses the quadratic formula to calculate intersection points
+    Pose d = p2 - p1;
+    Pose f = p1 - pose;
+    float a = d * d;
+    float b = 2 * (f * d);
+    float c = (f * f) - lookaheadDist * lookaheadDist;
+    float discriminant = b * b - 4 * a * c;
+
+    // if a possible intersection was found
+    if (discriminant >= 0) {
+        discriminant = sqrt(discriminant);
+        float t1 = (-b - discriminant) / (2 * a);
+        float t2 = (-b + discriminant) / (2 * a);
+
+        // prioritize further down the path
+        if (t2 >= 0 && t2 <= 1) return t2;
+        else if (t1 >= 0 && t1 <= 1) return t1;
+    }
+
+    // no intersection found
+    return -1;
+}
+
+lemlib::Pose lemlib::lookaheadPoint(Pose lastLookahead, Pose pose, std::span<const PathPoint> path, int closest,
+                                    float lookaheadDist, int last) {
+    // optimizations applied:
+    // only consider intersections that have an index greater than or equal to the point closest
+    // to the robot
+    // and intersections that have an index greater than or equal to the index of the last
+    // lookahead point
+    // and intersections on segments that start before the given last index
+    const int start = std::max(closest, int(lastLookahead.theta));
+    const int end = std::min<int>(last, path.size() - 1);
+    for (int i = start; i < end; i++) {
+        Pose lastPathPose(path[i].x, path[i].y);
+        Pose currentPathPose(path[i + 1].x, path[i + 1].y);
+
+        float t = circleIntersect(lastPathPose, currentPathPose, pose, lookaheadDist);
+
+        if (t != -1) {
+            Pose lookahead = lastPathPose.lerp(currentPathPose, t);
+            lookahead.theta = i;
+            return lookahead;
+        }
+    }
+
+    // robot deviated from path, use last lookahead point
+    return lastLookahead;
+}
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <cmath>
+#include "lemlib/util.hpp"
+#include "lemlib/chassis/trackingWheel.hpp"
+
+lemlib::TrackingWheel::TrackingWheel(pros::adi::Encoder* encoder, float wheelDiameter, float distance,
+                                     float gearRatio) {
+    this->encoder = encoder;
+    this->diameter = wheelDiameter;
+    this->distance = distance;
+    this->gearRatio = gearRatio;
+}
+
+lemlib::TrackingWheel::TrackingWheel(pros::Rotation* encoder, float wheelDiameter, float distance, float gearRatio) {
+    this->rotation = encoder;
+    this->diameter = wheelDiameter;
+    this->distance = distance;
+    this->gearRatio = gearRatio;
+    this->deviceIndex = devices().add(encoder);
+}
+
+lemlib::TrackingWheel::TrackingWheel(pros::MotorGroup* motors, float wheelDiameter, float distance, float rpm) {
+    this->motors = motors;
+    this->motors->set_encoder_units_all(pros::E_MOTOR_ENCODER_ROTATIONS);
+    this->diameter = wheelDiameter;
+    this->distance = distance;
+    this->rpm = rpm;
+    this->deviceIndex = devices().add(motors, DeviceService::POSITION);
+    // the gearsets don't change, so they're only read once
+    for (pros::MotorGears gearset : this->motors->get_gearing_all()) {
+        float in;
+        switch (gearset) {
+            case pros::MotorGears::red: in = 100; break;
+            case pros::MotorGears::green: in = 200; break;
+            case pros::MotorGears::blue: in = 600; break;
+            default: in = 200; break;
+        }
+        motorRatios.push_back(rpm / in);
+    }
+}
+
+void lemlib::TrackingWheel::reset() {
+    if (this->encoder != nullptr) this->encoder->reset();
+    if (this->rotation != nullptr) this->rotation->reset_position();
+    if (this->motors != nullptr) this->motors->tare_position_all();
+}
+
+float lemlib::TrackingWheel::getDistanceTraveled() {
+    if (devices().getVersion() == 0) return distanceTraveled(nullptr);
+    const DeviceSnapshot snapshot = devices().get();
+    return distanceTraveled(&snapshot);
+}
+
+float lemlib::TrackingWheel::getDistanceTraveled(const DeviceSnapshot& snapshot) { return distanceTraveled(&snapshot); }
+
+float lemlib::TrackingWheel::distanceTraveled(const DeviceSnapshot* snapshot) {
+    if (deviceIndex == -1) snapshot = nullptr;
+    if (this->encoder != nullptr) {
+        return (float(this->encoder->get_value()) * this->diameter * M_PI / 360) / this->gearRatio;
+    } else if (this->rotation != nullptr) {
+        const float position = snapshot != nullptr ? snapshot->rotations[deviceIndex] : this->rotation->get_position();
+        return (position * this->diameter * M_PI / 36000) / this->gearRatio;
+    } else if (this->motors != nullptr) {
+        // get distance traveled by each motor
+        std::vector<double> positions;
+        if (snapshot == nullptr) positions = this->motors->get_position_all();
+        const int count = std::min(motorRatios.size(), snapshot != nullptr ? motorRatios.size() : positions.size());
+        if (count == 0) return 0;
+        float total = 0;
+        for (int i = 0; i < count; i++) {
+            const float position = snapshot != nullptr ? snapshot->motorPositions[deviceIndex + i] : positions[i];
+            total += position * (diameter * M_PI) * motorRatios[i];
+        }
+        return total / count;
+    } else {
+        return 0;
+    }
+}
+
+float lemlib::TrackingWheel::getOffset() { return this->distance; }
+
+int lemlib::TrackingWheel::getType() {
+    if (this->motors != nullptr) return 1;
+    return 0;
+}
+
+void lemlib::TrackingWheel::setDataRate(int rate) {
+    if (this->rotation != nullptr) this->rotation->set_data_rate(rate);
+}
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <vector>
+#include "pros/rtos.hpp"
+#include "lemlib/devices.hpp"
+
+namespace lemlib {
+template <typename T> bool DeviceService::due(Entry<T>& entry, std::uint32_t now) {
+    if (entry.read && now - entry.lastRead < entry.interval.load(std::memory_order_relaxed)) return false;
+    entry.read = true;
+    entry.lastRead = now;
+    return true;
+}
+
+template <typename T, std::size_t N>
+int DeviceService::addSensor(std::array<Entry<T>, N>& entries, std::atomic<int>& count, T* sensor,
+                             std::uint32_t interval) {
+    const int registered = count.load(std::memory_order_relaxed);
+    // a sensor several consumers watch is only read once
+    for (int i = 0; i < registered; i++) {
+        if (entries[i].device->get_port() != sensor->get_port()) continue;
+        if (interval < entries[i].interval) entries[i].interval = interval;
+        return i;
+    }
+    if (registered == int(N)) return -1;
+    entries[registered].device = sensor;
+    entries[registered].interval = interval;
+    count.store(registered + 1, std::memory_order_release);
+    return registered;
+}
+
+int DeviceService::add(pros::AbstractMotor* motors, int data, std::uint32_t interval) {
+    const std::vector<std::int8_t> ports = motors->get_port_all();
+    const int registered = motorEntries.load(std::memory_order_relaxed);
+    for (int i = 0; i < registered; i++) {
+        MotorEntry& entry = this->motors[i];
+        if (entry.device->get_port_all() != ports) continue;
+        entry.data |= data;
+        if (interval < entry.interval) entry.interval = interval;
+        return entry.first;
+    }
+    const int count = ports.size();
+    if (registered == int(this->motors.size()) || motorCount + count > DeviceSnapshot::MAX_MOTORS) return -1;
+    MotorEntry& entry = this->motors[registered];
+    entry.device = motors;
+    entry.interval = interval;
+    entry.first = motorCount;
+    entry.count = count;
+    entry.data = data;
+    motorCount += count;
+    motorEntries.store(registered + 1, std::memory_order_release);
+    return entry.first;
+}
+
+int DeviceService::add(pros::Rotation* sensor, std::uint32_t interval) {
+    return addSensor(rotations, rotationCount, sensor, interval);
+}
+
+int DeviceService::add(pros::Imu* sensor, std::uint32_t interval) {
+    return addSensor(imus, imuCount, sensor, interval);
+}
+
+int DeviceService::add(pros::Optical* sensor, std::uint32_t interval) {
+    return addSensor(opticals, opticalCount, sensor, interval);
+}
+
+const DeviceSnapshot& DeviceService::update() {
+    const std::uint32_t now = pros::millis();
+    snapshot.time = pros::micros();
+
+    const int motorEntryCount = motorEntries.load(std::memory_order_acquire);
+    for (int i = 0; i < motorEntryCount; i++) {
+        MotorEntry& entry = motors[i];
+        if (!due(entry, now)) continue;
+        // one call for the whole group, rather than one for each motor
+        const int data = entry.data.load(std::memory_order_relaxed);
+        if (data & POSITION) {
+            const std::vector<double> positions = entry.device->get_position_all();
+            const int count = std::min<int>(entry.count, positions.size());
+            std::copy_n(positions.begin(), count, snapshot.motorPositions.begin() + entry.first);
+        }
+        if (data & VELOCITY) {
+            const std::vector<double> velocities = entry.device->get_actual_velocity_all();
+            const int count = std::min<int>(entry.count, velocities.size());
+            std::copy_n(velocities.begin(), count, snapshot.motorVelocities.begin() + entry.first);
+        }
+        if (data & CURRENT) {
+            const std::vector<std::int32_t> currents = entry.device->get_current_draw_all();
+            const int count = std::min<int>(entry.count, currents.size());
+            std::copy_n(currents.begin(), count, snapshot.motorCurrents.begin() + entry.first);
+        }
+        if (data & TORQUE) {
+            const std::vector<double> torques = entry.device->get_torque_all();
+            const int count = std::min<int>(entry.count, torques.size());
+            std::copy_n(torques.begin(), count, snapshot.motorTorques.begin() + entry.first);
+        }
+    }
+    const int rotationEntries = rotationCount.load(std::memory_order_acquire);
+    for (int i = 0; i < rotationEntries; i++) {
+        if (due(rotations[i], now)) snapshot.rotations[i] = rotations[i].device->get_position();
+    }
+    const int imuEntries = imuCount.load(std::memory_order_acquire);
+    for (int i = 0; i < imuEntries; i++) {
+        if (due(imus[i], now)) snapshot.imuRotations[i] = imus[i].device->get_rotation();
+    }
+    const int opticalEntries = opticalCount.load(std::memory_order_acquire);
+    for (int i = 0; i < opticalEntries; i++) {
+        if (!due(opticals[i], now)) continue;
+        snapshot.hues[i] = opticals[i].device->get_hue();
+        snapshot.proximities[i] = opticals[i].device->get_proximity();
+    }
+
+    published.write(snapshot);
+    return snapshot;
+}
+
+DeviceSnapshot DeviceService::get() const { return published.read(); }
+
+std::uint32_t DeviceService::getVersion() const { return published.getVersion(); }
+
+DeviceService& devices() {
+    static DeviceService service;
+    return service;
+}
+} // namespace lemlib
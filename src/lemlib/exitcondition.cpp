@@ -0,0 +1,72 @@
+#include <cmath>
+#include "pros/rtos.hpp"
+#include "lemlib/exitcondition.hpp"
+
+namespace lemlib {
+ExitCondition::ExitCondition(const float range, const int time)
+    : range(range),
+      time(time) {}
+
+bool ExitCondition::getExit() { return done; }
+
+bool ExitCondition::update(const float input) {
+    const int curTime = pros::millis();
+    // the input is assumed to have stayed where it was since the last update
+    if (startTime != -1) timeInRange += curTime - lastUpdateTime;
+    lastUpdateTime = curTime;
+    if (std::fabs(input) > range) startTime = -1;
+    else if (startTime == -1) startTime = curTime;
+    else if (curTime >= startTime + time) done = true;
+    if (startTime != -1 && firstEntryTime == -1) firstEntryTime = curTime;
+    return done;
+}
+
+void ExitCondition::reset() {
+    startTime = -1;
+    done = false;
+    lastUpdateTime = -1;
+    timeInRange = 0;
+    firstEntryTime = -1;
+}
+
+int ExitCondition::getTimeInRange() const { return timeInRange; }
+
+int ExitCondition::getFirstEntryTime() const { return firstEntryTime; }
+
+SettleExit::SettleExit(SettleSettings settings)
+    : settings(settings),
+      pending(settings) {}
+
+bool SettleExit::getExit() const { return done; }
+
+bool SettleExit::update(float error, float speed) {
+    const int curTime = pros::millis();
+    if (settings.speed <= 0) return false;
+    // the first update has nothing to measure the rate against
+    if (lastUpdateTime == -1 || curTime == lastUpdateTime) {
+        prevError = error;
+        lastUpdateTime = curTime;
+        return done;
+    }
+    const float rate = (error - prevError) * 1000 / (curTime - lastUpdateTime);
+    prevError = error;
+    lastUpdateTime = curTime;
+    const float predicted = error + rate * settings.time / 1000;
+    const bool settled = std::fabs(speed) <= settings.speed && std::fabs(rate) <= settings.speed &&
+                         std::fabs(predicted) <= settings.range;
+    if (!settled) startTime = -1;
+    else if (startTime == -1) startTime = curTime;
+    else if (curTime >= startTime + settings.time) done = true;
+    return done;
+}
+
+void SettleExit::reset() {
+    settings = pending;
+    prevError = 0;
+    lastUpdateTime = -1;
+    startTime = -1;
+    done = false;
+}
+
+void SettleExit::setSettings(SettleSettings settings) { pending = settings; }
+} // namespace lemlib
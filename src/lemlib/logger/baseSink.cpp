@@ -0,0 +1,93 @@
+#include "lemlib/logger/baseSink.hpp"
+
+namespace lemlib {
+BaseSink::BaseSink(std::initializer_list<std::shared_ptr<BaseSink>> sinks)
+    : sinks(sinks) {}
+
+void BaseSink::setLowestLevel(Level level) {
+    if (!sinks.empty()) {
+        for (std::shared_ptr<BaseSink> sink : sinks) { sink->setLowestLevel(level); }
+        return;
+    }
+
+    lowestLevel = level;
+}
+
+void BaseSink::setFormat(const std::string& format) {
+    if (!sinks.empty()) {
+        for (std::shared_ptr<BaseSink> sink : sinks) { sink->setFormat(format); }
+        return;
+    }
+
+    logFormat = format;
+    compiledFormat.clear();
+    formatCompiled = true;
+    std::string text;
+    const auto flush = [&] {
+        if (!text.empty()) compiledFormat.push_back({FormatOp::Field::NONE, std::move(text)});
+        text.clear();
+    };
+    for (std::size_t i = 0; i < format.size(); i++) {
+        // escaped braces
+        if ((format[i] == '{' || format[i] == '}') && i + 1 < format.size() && format[i + 1] == format[i]) {
+            text += format[i++];
+            continue;
+        }
+        if (format[i] != '{') {
+            text += format[i];
+            continue;
+        }
+        const std::size_t end = format.find('}', i);
+        const std::string field = end == std::string::npos ? "" : format.substr(i + 1, end - i - 1);
+        const std::size_t colon = field.find(':');
+        const std::string name = field.substr(0, colon);
+        const std::string spec = colon == std::string::npos ? "" : field.substr(colon + 1);
+        FormatOp::Field kind = FormatOp::Field::NONE;
+        if (name == "time") kind = FormatOp::Field::TIME;
+        else if (name == "level") kind = FormatOp::Field::LEVEL;
+        else if (name == "message") kind = FormatOp::Field::MESSAGE;
+        // anything else, like the extra formatting arguments, is left to fmt
+        if (kind == FormatOp::Field::NONE || spec.find('{') != std::string::npos) {
+            compiledFormat.clear();
+            formatCompiled = false;
+            return;
+        }
+        flush();
+        compiledFormat.push_back({kind, spec.empty() ? "" : "{:" + spec + "}"});
+        i = end;
+    }
+    flush();
+}
+
+void BaseSink::appendField(fmt::memory_buffer& out, const FormatOp& op, const Message& message) {
+    switch (op.field) {
+        case FormatOp::Field::NONE: out.append(op.text); break;
+        case FormatOp::Field::TIME:
+            if (op.text.empty()) fmt::format_to(std::back_inserter(out), "{}", message.time);
+            else fmt::format_to(std::back_inserter(out), fmt::runtime(op.text), message.time);
+            break;
+        case FormatOp::Field::LEVEL:
+            if (op.text.empty()) out.append(std::string_view(levelName(message.level)));
+            else fmt::format_to(std::back_inserter(out), fmt::runtime(op.text), levelName(message.level));
+            break;
+        case FormatOp::Field::MESSAGE: break;
+    }
+}
+
+std::string BaseSink::formatDynamic(const Message& message, std::string messageString) {
+    // get the arguments
+    fmt::dynamic_format_arg_store<fmt::format_context> formattingArgs = getExtraFormattingArgs(message);
+
+    formattingArgs.push_back(fmt::arg("time", message.time));
+    formattingArgs.push_back(fmt::arg("level", message.level));
+    formattingArgs.push_back(fmt::arg("message", std::move(messageString)));
+
+    return fmt::vformat(logFormat, std::move(formattingArgs));
+}
+
+fmt::dynamic_format_arg_store<fmt::format_context> BaseSink::getExtraFormattingArgs(const Message& messageInfo) {
+    return {};
+}
+
+void BaseSink::sendMessage(const Message& message) {}
+} // namespace lemlib
@@ -0,0 +1,94 @@
+#include "pros/rtos.hpp"
+
+#include "lemlib/logger/buffer.hpp"
+
+namespace lemlib {
+Buffer::Buffer(std::function<void(const std::string&)> bufferFunc)
+    : bufferFunc(bufferFunc) {}
+
+Buffer::~Buffer() {
+    if (task == nullptr) return;
+    task->remove();
+    delete task;
+}
+
+void Buffer::start() {
+    if (task == nullptr) task = new pros::Task([this] { taskLoop(); });
+}
+
+void Buffer::pushToBuffer(std::string_view bufferData) {
+    if (bufferData.size() > SLOT_SIZE) {
+        truncated.fetch_add(1, std::memory_order_relaxed);
+        bufferData = bufferData.substr(0, SLOT_SIZE);
+    }
+    if (push(bufferData)) return;
+    // make room by throwing away the oldest message. Another task can take the room first, so only try once more
+    if (policy.load(std::memory_order_relaxed) == OverflowPolicy::DROP_OLDEST && pop(nullptr) && push(bufferData))
+        return;
+    dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool Buffer::push(std::string_view message) {
+    const std::uint32_t count = ring.push(reinterpret_cast<const std::uint8_t*>(message.data()), message.size());
+    if (count == 0) return false;
+    std::uint32_t mark = highWaterMark.load(std::memory_order_relaxed);
+    while (count > mark && !highWaterMark.compare_exchange_weak(mark, count)) {}
+    return true;
+}
+
+bool Buffer::pop(std::string* out) {
+    if (out == nullptr) {
+        if (!ring.pop(nullptr)) return false;
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return ring.pop([out](const std::uint8_t* data, std::size_t size) {
+        out->assign(reinterpret_cast<const char*>(data), size);
+    });
+}
+
+void Buffer::taskLoop() {
+    std::string message;
+    std::string batch;
+    std::string next; // a message that didn't fit in the last batch
+    while (true) {
+        processing = true;
+        const std::size_t limit = batchSize;
+        if (limit == 0) {
+            if (!next.empty()) bufferFunc(next);
+            else if (pop(&message)) bufferFunc(message);
+            next.clear();
+        } else {
+            batch.swap(next);
+            next.clear();
+            while (batch.size() < limit && pop(&message)) {
+                if (!batch.empty() && batch.size() + message.size() > limit) {
+                    next.swap(message);
+                    break;
+                }
+                batch += message;
+            }
+            if (!batch.empty()) bufferFunc(batch);
+            batch.clear();
+        }
+        processing = !next.empty();
+        pros::delay(rate);
+    }
+}
+
+bool Buffer::buffersEmpty() { return ring.empty() && !processing; }
+
+void Buffer::setRate(uint32_t rate) { this->rate = rate; }
+
+uint32_t Buffer::getRate() const { return rate; }
+
+void Buffer::setBatchSize(std::size_t size) { batchSize = size; }
+
+void Buffer::setOverflowPolicy(OverflowPolicy policy) { this->policy = policy; }
+
+std::uint32_t Buffer::getDropped() const { return dropped; }
+
+std::uint32_t Buffer::getTruncated() const { return truncated; }
+
+std::uint32_t Buffer::getHighWaterMark() const { return highWaterMark; }
+} // namespace lemlib
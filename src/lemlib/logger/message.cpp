@@ -0,0 +1,16 @@
+#include "lemlib/logger/message.hpp"
+
+namespace lemlib {
+const char* levelName(Level level) {
+    switch (level) {
+        case Level::DEBUG: return "DEBUG";
+        case Level::INFO: return "INFO";
+        case Level::WARN: return "WARN";
+        case Level::ERROR: return "ERROR";
+        case Level::FATAL: return "FATAL";
+        default: return "UNKNOWN";
+    }
+}
+
+std::string format_as(Level level) { return levelName(level); }
+} // namespace lemlib
@@ -0,0 +1,31 @@
+#include <iostream>
+
+#include "lemlib/logger/stdout.hpp"
+
+namespace lemlib {
+BufferedStdout::BufferedStdout()
+    : Buffer([this](const std::string& text) {
+          Transport* transport = this->transport;
+          if (transport == nullptr) {
+              std::cout << text << std::flush;
+              return;
+          }
+          transport->send(text);
+          // keep up with the link, as compression learns how much it saves
+          setBatchSize(transport->getBatchSize(getRate()));
+      }) {
+    setRate(50);
+    // the task reads transport, which isn't initialized until the base class is
+    start();
+}
+
+void BufferedStdout::setTransport(Transport* transport) {
+    this->transport = transport;
+    setBatchSize(transport != nullptr ? transport->getBatchSize(getRate()) : 0);
+}
+
+BufferedStdout& bufferedStdout() {
+    static BufferedStdout bufferedStdout;
+    return bufferedStdout;
+}
+} // namespace lemlib
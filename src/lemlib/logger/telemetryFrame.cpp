@@ -0,0 +1,47 @@
+#include <cstring>
+#include "lemlib/logger/telemetryFrame.hpp"
+
+namespace lemlib::telemetry {
+namespace {
+std::uint8_t checksum(const std::uint8_t* data, std::size_t size) {
+    std::uint8_t sum = 0;
+    for (std::size_t i = 0; i < size; i++) sum += data[i];
+    return ~sum;
+}
+} // namespace
+
+std::size_t encode(std::uint8_t* out, std::uint8_t type, std::uint32_t time, const void* payload, std::size_t size) {
+    out[0] = SYNC;
+    out[1] = type;
+    out[2] = size;
+    for (int i = 0; i < 4; i++) out[3 + i] = time >> (8 * i);
+    std::memcpy(out + HEADER_SIZE, payload, size);
+    out[HEADER_SIZE + size] = checksum(out + 1, HEADER_SIZE - 1 + size);
+    return HEADER_SIZE + size + 1;
+}
+
+int decode(const std::uint8_t* data, std::size_t size, Frame& frame) {
+    if (size == 0) return 0;
+    if (data[0] != SYNC) return -1;
+    if (size < HEADER_SIZE) return 0;
+    const std::size_t payloadSize = data[2];
+    const std::size_t frameSize = HEADER_SIZE + payloadSize + 1;
+    if (size < frameSize) return 0;
+    if (checksum(data + 1, HEADER_SIZE - 1 + payloadSize) != data[frameSize - 1]) return -1;
+    frame.type = data[1];
+    frame.time = 0;
+    for (int i = 0; i < 4; i++) frame.time |= std::uint32_t(data[3 + i]) << (8 * i);
+    frame.size = payloadSize;
+    frame.payload = data + HEADER_SIZE;
+    return frameSize;
+}
+
+const char* typeName(std::uint8_t type) {
+    switch (type) {
+        case TEXT: return "text";
+        case POSE: return "pose";
+        case SPEED: return "speed";
+        default: return nullptr;
+    }
+}
+} // namespace lemlib::telemetry
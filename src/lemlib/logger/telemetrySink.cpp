@@ -0,0 +1,69 @@
+#include <algorithm>
+#include <cstdio>
+#include "lemlib/logger/telemetrySink.hpp"
+#include "lemlib/logger/stdout.hpp"
+
+namespace lemlib {
+TelemetrySink::TelemetrySink()
+    : output([](const std::uint8_t* data, std::size_t size) {
+          std::fwrite(data, 1, size, stdout);
+          std::fflush(stdout);
+      }) {
+    setFormat("{message}");
+}
+
+void TelemetrySink::setMode(Mode mode) {
+    if (mode == Mode::BINARY && task == nullptr) task = new pros::Task([this] { drain(); }, "LemLib Telemetry");
+    this->mode = mode;
+}
+
+void TelemetrySink::setOutput(std::function<void(const std::uint8_t* data, std::size_t size)> output) {
+    this->output = std::move(output);
+}
+
+void TelemetrySink::send(std::uint8_t type, const float* values, int count) {
+    count = std::clamp(count, 0, telemetry::MAX_VALUES);
+    if (mode == Mode::BINARY) {
+        push(type, pros::millis(), values, count * sizeof(float));
+        return;
+    }
+    std::string text = fmt::format("{}", type);
+    for (int i = 0; i < count; i++) fmt::format_to(std::back_inserter(text), ",{}", values[i]);
+    sendMessage(Message {.message = std::move(text), .level = Level::INFO, .time = pros::millis()});
+}
+
+std::uint32_t TelemetrySink::getDropped() const { return dropped; }
+
+void TelemetrySink::sendMessage(const Message& message) {
+    if (mode == Mode::BINARY) {
+        push(telemetry::TEXT, message.time, message.message.data(),
+             std::min(message.message.size(), telemetry::MAX_PAYLOAD));
+        return;
+    }
+    bufferedStdout().print("\033[s{}\033[u\033[0J", message.message);
+}
+
+void TelemetrySink::push(std::uint8_t type, std::uint32_t time, const void* payload, std::size_t size) {
+    std::array<std::uint8_t, telemetry::MAX_FRAME> frame;
+    const std::size_t frameSize = telemetry::encode(frame.data(), type, time, payload, size);
+    // frames go in whole or not at all, so the stream stays readable
+    if (ring.push(frame.data(), frameSize) == 0) dropped++;
+}
+
+void TelemetrySink::drain() {
+    std::array<std::uint8_t, 512> chunk;
+    std::size_t size = 0;
+    auto append = [&](const std::uint8_t* data, std::size_t frameSize) {
+        std::copy_n(data, frameSize, chunk.begin() + size);
+        size += frameSize;
+    };
+    while (true) {
+        // gather whole frames while there's room for the biggest one, then write them together
+        while (chunk.size() - size >= telemetry::MAX_FRAME && ring.pop(append)) {}
+        if (size > 0 && output) output(chunk.data(), size);
+        const bool more = size > 0 && !ring.empty();
+        size = 0;
+        if (!more) pros::delay(10);
+    }
+}
+} // namespace lemlib
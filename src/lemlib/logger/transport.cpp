@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <cstdio>
+#include "pros/rtos.hpp"
+#include "lemlib/logger/transport.hpp"
+
+namespace lemlib {
+Transport::Transport(std::uint32_t bytesPerSecond)
+    : bytesPerSecond(bytesPerSecond) {}
+
+Transport::Transport(pros::Serial* serial, std::uint32_t baudrate)
+    : serial(serial),
+      bytesPerSecond(baudrate / 10) {} // a start bit, 8 data bits and a stop bit per byte
+
+void Transport::setCompression(bool enabled) { compression = enabled; }
+
+std::size_t Transport::getBatchSize(std::uint32_t interval) const {
+    const std::uint64_t link = std::uint64_t(bytesPerSecond) * interval / 1000;
+    const std::uint32_t text = textBytes;
+    const std::uint32_t sent = linkBytes;
+    // each byte of the link has been carrying text / sent bytes of text. The framing is in sent as well
+    const std::uint64_t batch = sent > 0 ? link * text / sent : link;
+    return std::clamp<std::uint64_t>(batch, 1, transport::MAX_PAYLOAD);
+}
+
+void Transport::send(std::string_view text) {
+    while (!text.empty()) {
+        const std::size_t size = std::min(text.size(), transport::MAX_PAYLOAD);
+        const std::size_t frameSize = transport::encode(frame.data(), sequence++, text.data(), size, compression);
+        write(frame.data(), frameSize);
+        textBytes += size;
+        linkBytes += frameSize;
+        text.remove_prefix(size);
+    }
+}
+
+void Transport::write(std::uint8_t* data, std::size_t size) {
+    if (serial == nullptr) {
+        std::fwrite(data, 1, size, stdout);
+        std::fflush(stdout);
+        return;
+    }
+    while (size > 0) {
+        // write as much as the port has room for, and wait for the rest. Give up if it's unplugged
+        const std::int32_t free = serial->get_write_free();
+        if (free < 0) return;
+        if (free == 0) {
+            pros::delay(1);
+            continue;
+        }
+        const std::int32_t written = serial->write(data, std::min<std::size_t>(free, size));
+        if (written < 0) return;
+        data += written;
+        size -= written;
+    }
+}
+
+std::uint16_t Transport::getSequence() const { return sequence; }
+
+std::uint32_t Transport::getTextBytes() const { return textBytes; }
+
+std::uint32_t Transport::getLinkBytes() const { return linkBytes; }
+} // namespace lemlib
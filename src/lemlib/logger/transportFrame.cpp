@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include "lemlib/logger/transportFrame.hpp"
+
+namespace lemlib::transport {
+namespace {
+// a match is a 10 bit offset back into the window and a 6 bit length
+constexpr std::size_t WINDOW = 1024;
+constexpr std::size_t MIN_MATCH = 3;
+constexpr std::size_t MAX_MATCH = MIN_MATCH + 63;
+constexpr std::size_t HASH_SIZE = 1024;
+
+/**
+ * @brief CRC-16/CCITT-FALSE
+ */
+std::uint16_t crc16(const std::uint8_t* data, std::size_t size) {
+    std::uint16_t crc = 0xFFFF;
+    for (std::size_t i = 0; i < size; i++) {
+        crc ^= data[i] << 8;
+        for (int bit = 0; bit < 8; bit++) crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+std::size_t hash(const std::uint8_t* data) { return ((data[0] << 6) ^ (data[1] << 3) ^ data[2]) % HASH_SIZE; }
+} // namespace
+
+std::size_t compress(const std::uint8_t* in, std::size_t size, std::uint8_t* out, std::size_t capacity) {
+    // where each hash of 3 bytes was last seen, plus one so 0 means never
+    std::array<std::uint16_t, HASH_SIZE> seen {};
+    std::size_t o = 0;
+    std::size_t i = 0;
+    while (i < size) {
+        // a flags byte says which of the next 8 items are matches
+        if (o == capacity) return 0;
+        const std::size_t flags = o++;
+        out[flags] = 0;
+        for (int item = 0; item < 8 && i < size; item++) {
+            std::size_t length = 0;
+            std::size_t offset = 0;
+            if (i + MIN_MATCH <= size) {
+                std::uint16_t& last = seen[hash(in + i)];
+                if (last != 0 && i - (last - 1) <= WINDOW) {
+                    offset = i - (last - 1);
+                    const std::size_t limit = std::min(MAX_MATCH, size - i);
+                    while (length < limit && in[i + length] == in[i + length - offset]) length++;
+                }
+                last = i + 1;
+            }
+            if (length >= MIN_MATCH) {
+                if (o + 2 > capacity) return 0;
+                out[flags] |= 1 << item;
+                out[o++] = (offset - 1) & 0xFF;
+                out[o++] = ((offset - 1) >> 8) << 6 | (length - MIN_MATCH);
+                i += length;
+            } else {
+                if (o == capacity) return 0;
+                out[o++] = in[i++];
+            }
+        }
+    }
+    return o;
+}
+
+int decompress(const std::uint8_t* in, std::size_t size, std::uint8_t* out, std::size_t capacity) {
+    std::size_t o = 0;
+    std::size_t i = 0;
+    while (i < size) {
+        const std::uint8_t flags = in[i++];
+        for (int item = 0; item < 8 && i < size; item++) {
+            if ((flags & 1 << item) == 0) {
+                if (o == capacity) return -1;
+                out[o++] = in[i++];
+                continue;
+            }
+            if (i + 2 > size) return -1;
+            const std::size_t offset = (in[i] | (in[i + 1] >> 6) << 8) + 1;
+            const std::size_t length = (in[i + 1] & 63) + MIN_MATCH;
+            i += 2;
+            if (offset > o || o + length > capacity) return -1;
+            // byte by byte, since a match can overlap what it copies
+            for (std::size_t j = 0; j < length; j++, o++) out[o] = out[o - offset];
+        }
+    }
+    return o;
+}
+
+std::size_t encode(std::uint8_t* out, std::uint16_t sequence, const void* data, std::size_t size, bool compress) {
+    std::uint8_t flags = 0;
+    std::size_t payloadSize = 0;
+    // only keep the compressed payload if it's smaller
+    if (compress) payloadSize = transport::compress(static_cast<const std::uint8_t*>(data), size,
+                                                     out + HEADER_SIZE, size > 0 ? size - 1 : 0);
+    if (payloadSize > 0) {
+        flags |= COMPRESSED;
+    } else {
+        payloadSize = size;
+        std::memcpy(out + HEADER_SIZE, data, size);
+    }
+    out[0] = MAGIC[0];
+    out[1] = MAGIC[1];
+    out[2] = flags;
+    out[3] = sequence;
+    out[4] = sequence >> 8;
+    out[5] = payloadSize;
+    out[6] = payloadSize >> 8;
+    const std::uint16_t crc = crc16(out + 2, HEADER_SIZE - 2 + payloadSize);
+    out[HEADER_SIZE + payloadSize] = crc;
+    out[HEADER_SIZE + payloadSize + 1] = crc >> 8;
+    return HEADER_SIZE + payloadSize + TRAILER_SIZE;
+}
+
+int decode(const std::uint8_t* data, std::size_t size, Frame& frame) {
+    if (size == 0) return 0;
+    if (data[0] != MAGIC[0] || (size > 1 && data[1] != MAGIC[1])) return -1;
+    if (size < HEADER_SIZE) return 0;
+    const std::size_t payloadSize = data[5] | data[6] << 8;
+    if (payloadSize > MAX_PAYLOAD) return -1;
+    const std::size_t frameSize = HEADER_SIZE + payloadSize + TRAILER_SIZE;
+    if (size < frameSize) return 0;
+    const std::uint16_t crc = data[frameSize - 2] | data[frameSize - 1] << 8;
+    if (crc16(data + 2, HEADER_SIZE - 2 + payloadSize) != crc) return -1;
+    frame.flags = data[2];
+    frame.sequence = data[3] | data[4] << 8;
+    frame.size = payloadSize;
+    frame.payload = data + HEADER_SIZE;
+    return frameSize;
+}
+
+int unpack(const Frame& frame, std::uint8_t* out) {
+    if (frame.flags & COMPRESSED) return decompress(frame.payload, frame.size, out, MAX_PAYLOAD);
+    std::memcpy(out, frame.payload, frame.size);
+    return frame.size;
+}
+} // namespace lemlib::transport
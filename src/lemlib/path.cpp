@@ -0,0 +1,40 @@
+#include <cmath>
+#include <cstring>
+#include "lemlib/path.hpp"
+
+bool lemlib::isBinaryPath(const asset& path) {
+    return path.size >= sizeof(PathHeader) && std::memcmp(path.buf, PATH_MAGIC, sizeof(PATH_MAGIC)) == 0;
+}
+
+std::span<const lemlib::PathPoint> lemlib::binaryPathPoints(const asset& path) {
+    if (!isBinaryPath(path)) return {};
+    // the points are used in place, so they have to be aligned. The header's size keeps them aligned with it
+    if (reinterpret_cast<std::uintptr_t>(path.buf) % alignof(PathPoint) != 0) return {};
+    const PathHeader* header = reinterpret_cast<const PathHeader*>(path.buf);
+    if (header->version != PATH_VERSION || header->pointSize != sizeof(PathPoint)) return {};
+    if (header->count > (path.size - sizeof(PathHeader)) / sizeof(PathPoint)) return {};
+    return {reinterpret_cast<const PathPoint*>(path.buf + sizeof(PathHeader)), header->count};
+}
+
+void lemlib::annotatePath(std::span<PathPoint> points) {
+    float distance = 0;
+    for (std::size_t i = 0; i < points.size(); i++) {
+        if (i > 0) distance += std::hypot(points[i].x - points[i - 1].x, points[i].y - points[i - 1].y);
+        points[i].distance = distance;
+        points[i].curvature = 0;
+        if (i == 0 || i + 1 >= points.size()) continue;
+        // curvature of the circle through three points is 4 * area / product of the sides
+        const PathPoint& a = points[i - 1];
+        const PathPoint& b = points[i];
+        const PathPoint& c = points[i + 1];
+        const float cross = (b.x - a.x) * (c.y - b.y) - (b.y - a.y) * (c.x - b.x);
+        const float sides = std::hypot(b.x - a.x, b.y - a.y) * std::hypot(c.x - b.x, c.y - b.y) *
+                            std::hypot(c.x - a.x, c.y - a.y);
+        // a counterclockwise bend has a positive cross product, but right turns are positive here
+        if (sides > 0) points[i].curvature = -2 * cross / sides;
+    }
+    if (points.size() >= 3) {
+        points.front().curvature = points[1].curvature;
+        points.back().curvature = points[points.size() - 2].curvature;
+    }
+}
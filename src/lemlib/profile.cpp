@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <cmath>
+#include "lemlib/profile.hpp"
+
+lemlib::MotionProfile::Ramp::Ramp(float startVelocity, float endVelocity, float maxAcceleration, float maxJerk)
+    : startVelocity(startVelocity),
+      endVelocity(endVelocity) {
+    const float change = std::fabs(endVelocity - startVelocity);
+    if (change == 0 || maxAcceleration <= 0) return;
+    const float sign = endVelocity > startVelocity ? 1 : -1;
+    if (maxJerk <= 0) { // trapezoidal
+        acceleration = sign * maxAcceleration;
+        accelTime = change / maxAcceleration;
+    } else if (change >= maxAcceleration * maxAcceleration / maxJerk) { // reaches the acceleration limit
+        jerk = sign * maxJerk;
+        acceleration = sign * maxAcceleration;
+        jerkTime = maxAcceleration / maxJerk;
+        accelTime = change / maxAcceleration - jerkTime;
+    } else { // the acceleration has to ramp back down before reaching the limit
+        jerk = sign * maxJerk;
+        acceleration = sign * std::sqrt(change * maxJerk);
+        jerkTime = std::fabs(acceleration) / maxJerk;
+    }
+    duration = 2 * jerkTime + accelTime;
+    // the acceleration is symmetric, so the average velocity is halfway between the start and end
+    distance = (startVelocity + endVelocity) / 2 * duration;
+}
+
+lemlib::ProfileState lemlib::MotionProfile::Ramp::sample(float time) const {
+    time = std::clamp(time, 0.0f, duration);
+    if (time < jerkTime) { // acceleration ramping up
+        return {startVelocity * time + jerk * time * time * time / 6, startVelocity + jerk * time * time / 2,
+                jerk * time};
+    }
+    if (time < jerkTime + accelTime) { // constant acceleration
+        const float velocity = startVelocity + jerk * jerkTime * jerkTime / 2;
+        const float position = startVelocity * jerkTime + jerk * jerkTime * jerkTime * jerkTime / 6;
+        const float t = time - jerkTime;
+        return {position + velocity * t + acceleration * t * t / 2, velocity + acceleration * t, acceleration};
+    }
+    // acceleration ramping down, which mirrors ramping up from the end
+    const float t = duration - time;
+    return {distance - (endVelocity * t - jerk * t * t * t / 6), endVelocity - jerk * t * t / 2, jerk * t};
+}
+
+lemlib::MotionProfile::MotionProfile(float distance, float maxVelocity, float maxAcceleration, float maxJerk,
+                                     float startVelocity, float endVelocity) {
+    distance = std::fmax(distance, 0);
+    startVelocity = std::fmax(startVelocity, 0);
+    endVelocity = std::clamp(endVelocity, 0.0f, maxVelocity);
+    const auto rampDistance = [&](float from, float to) { return Ramp(from, to, maxAcceleration, maxJerk).distance; };
+    // find the velocity in [low, high] where a distance that grows with it reaches the travel distance
+    const auto solve = [&](float low, float high, auto&& distanceAt) {
+        for (int i = 0; i < 30; i++) {
+            const float mid = (low + high) / 2;
+            if (distanceAt(mid) > distance) high = mid;
+            else low = mid;
+        }
+        return low;
+    };
+
+    if (rampDistance(startVelocity, endVelocity) > distance) {
+        // too short to change velocity that much, so the whole profile is one ramp towards the end velocity
+        if (endVelocity > startVelocity)
+            endVelocity = solve(startVelocity, endVelocity, [&](float v) { return rampDistance(startVelocity, v); });
+        else
+            endVelocity = startVelocity - solve(0, startVelocity - endVelocity, [&](float drop) {
+                              return rampDistance(startVelocity, startVelocity - drop);
+                          });
+        cruiseVelocity = endVelocity;
+    } else {
+        // cruise as fast as possible. If the start is faster than the maximum, slow down to it
+        const float low = startVelocity > maxVelocity ? endVelocity : std::fmax(startVelocity, endVelocity);
+        const auto rampsDistance = [&](float v) { return rampDistance(startVelocity, v) + rampDistance(v, endVelocity); };
+        cruiseVelocity = rampsDistance(maxVelocity) <= distance ? maxVelocity : solve(low, maxVelocity, rampsDistance);
+    }
+    speedUp = Ramp(startVelocity, cruiseVelocity, maxAcceleration, maxJerk);
+    slowDown = Ramp(cruiseVelocity, endVelocity, maxAcceleration, maxJerk);
+    if (cruiseVelocity > 0)
+        cruiseTime = std::fmax(distance - speedUp.distance - slowDown.distance, 0) / cruiseVelocity;
+    this->distance = speedUp.distance + cruiseVelocity * cruiseTime + slowDown.distance;
+}
+
+lemlib::ProfileState lemlib::MotionProfile::sample(float time) const {
+    if (time < speedUp.duration) return speedUp.sample(time);
+    time -= speedUp.duration;
+    if (time < cruiseTime) return {speedUp.distance + cruiseVelocity * time, cruiseVelocity, 0};
+    time -= cruiseTime;
+    ProfileState state = slowDown.sample(time);
+    state.position += speedUp.distance + cruiseVelocity * cruiseTime;
+    return state;
+}
+
+float lemlib::MotionProfile::getDuration() const { return speedUp.duration + cruiseTime + slowDown.duration; }
+
+float lemlib::MotionProfile::getEndVelocity() const { return slowDown.endVelocity; }
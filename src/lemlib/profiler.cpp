@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/profiler.hpp"
+#include "lemlib/seqlock.hpp"
+
+namespace {
+/**
+ * @brief What the profiler keeps for each task
+ */
+struct Entry {
+        std::atomic<pros::task_t> task = nullptr; // set last, once the rest is ready
+        // a copy, since the task that named it may be deleted
+        char name[TASK_NAME_MAX_LEN] {};
+        // only the task using the entry touches these
+        lemlib::profiler::TaskStats stats {};
+        std::uint64_t wokeAt = 0;
+        bool running = false;
+        bool stopped = false; // the next wake up doesn't end a period
+        // other tasks read or change these
+        std::atomic<bool> active = false;
+        std::atomic<std::uint32_t> preemptions = 0;
+        lemlib::Seqlock<lemlib::profiler::TaskStats> published {lemlib::profiler::TaskStats {}};
+};
+
+std::array<Entry, lemlib::profiler::MAX_TASKS> entries;
+std::atomic<int> taskCount = 0;
+
+/**
+ * @brief A slot in the event ring. Events are kept as atomic words, so they can be written from any task without a lock
+ *
+ * Like a seqlock, the sequence number is odd while the slot is written. When it isn't, it says which event the slot
+ * holds, so a reader can tell the event it copied is the one it wanted and that it wasn't changed part way through.
+ */
+struct EventSlot {
+        std::atomic<std::uint32_t> sequence = 0; // 2 * (event number + 1) once the event is written
+        std::array<std::atomic<std::uint32_t>, 3> words;
+};
+
+std::array<EventSlot, lemlib::profiler::EVENT_COUNT> events;
+std::atomic<std::uint32_t> eventCount = 0;
+
+/**
+ * @brief Get the entry of the calling task, adding one if it doesn't have one yet
+ *
+ * Tasks with the same name and priority share an entry, so a loop that runs in a new task each time, like an async
+ * motion, is profiled as one task
+ *
+ * @return nullptr if there are already MAX_TASKS tasks
+ */
+Entry* self() {
+    const pros::task_t current = pros::c::task_get_current();
+    const int count = std::min<int>(taskCount.load(std::memory_order_acquire), lemlib::profiler::MAX_TASKS);
+    for (int i = 0; i < count; i++) {
+        if (entries[i].task.load(std::memory_order_acquire) == current) return &entries[i];
+    }
+    const char* name = pros::c::task_get_name(current);
+    if (name == nullptr || name[0] == '\0') name = "unnamed";
+    const std::uint32_t priority = pros::c::task_get_priority(current);
+    for (int i = 0; i < count; i++) {
+        Entry& entry = entries[i];
+        if (entry.task.load(std::memory_order_acquire) == nullptr || entry.stats.priority != priority ||
+            std::strncmp(entry.name, name, TASK_NAME_MAX_LEN - 1) != 0)
+            continue;
+        // the last task to use it may have ended without saying so
+        entry.running = false;
+        entry.stopped = true;
+        entry.active.store(false, std::memory_order_relaxed);
+        entry.task.store(current, std::memory_order_release);
+        return &entry;
+    }
+    const int index = taskCount.fetch_add(1);
+    if (index >= lemlib::profiler::MAX_TASKS) return nullptr;
+    Entry& entry = entries[index];
+    std::strncpy(entry.name, name, TASK_NAME_MAX_LEN - 1);
+    entry.stats.name = entry.name;
+    entry.stats.priority = priority;
+    entry.task.store(current, std::memory_order_release);
+    return &entry;
+}
+
+/**
+ * @brief Get the entry of the calling task, without adding one
+ */
+Entry* find() {
+    const pros::task_t current = pros::c::task_get_current();
+    const int count = std::min<int>(taskCount.load(std::memory_order_acquire), lemlib::profiler::MAX_TASKS);
+    for (int i = 0; i < count; i++) {
+        if (entries[i].task.load(std::memory_order_acquire) == current) return &entries[i];
+    }
+    return nullptr;
+}
+
+void record(const Entry& entry, bool wake, std::uint32_t time, std::uint32_t value) {
+    const std::uint32_t number = eventCount.fetch_add(1, std::memory_order_relaxed);
+    EventSlot& slot = events[number % lemlib::profiler::EVENT_COUNT];
+    // claim the slot. If a task that was preempted a whole ring of events ago is still writing it, drop this event
+    std::uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    if ((sequence & 1) || !slot.sequence.compare_exchange_strong(sequence, 2 * number + 1, std::memory_order_relaxed))
+        return;
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.words[0].store(time, std::memory_order_relaxed);
+    slot.words[1].store((&entry - entries.data()) << 1 | wake, std::memory_order_relaxed);
+    slot.words[2].store(value, std::memory_order_relaxed);
+    slot.sequence.store(2 * (number + 1), std::memory_order_release);
+}
+
+void sleep(Entry* entry) {
+    if (entry == nullptr || !entry->running) return;
+    const std::uint64_t now = pros::micros();
+    const std::uint32_t runTime = now - entry->wokeAt;
+    entry->stats.runTime += runTime;
+    entry->stats.maxRunTime = std::max(entry->stats.maxRunTime, runTime);
+    entry->running = false;
+    entry->active.store(false, std::memory_order_relaxed);
+    record(*entry, false, now, runTime);
+}
+
+/**
+ * @param requested when the task asked to wake up, in microseconds
+ */
+void wake(Entry* entry, std::uint64_t requested) {
+    if (entry == nullptr) return;
+    const std::uint64_t now = pros::micros();
+    // waking up on a tick can be a little early for a delay that started part way through one
+    const std::uint32_t latency = now > requested ? now - requested : 0;
+    lemlib::profiler::TaskStats& stats = entry->stats;
+    if (stats.wakes > 0 && !entry->stopped) stats.maxPeriod = std::max<std::uint32_t>(stats.maxPeriod, now - entry->wokeAt);
+    stats.wakes++;
+    stats.latency += latency;
+    stats.maxLatency = std::max(stats.maxLatency, latency);
+    entry->wokeAt = now;
+    entry->running = true;
+    entry->stopped = false;
+    entry->active.store(true, std::memory_order_relaxed);
+
+    // every lower priority task that's running has just been preempted by this one
+    const int count = std::min<int>(taskCount.load(std::memory_order_acquire), lemlib::profiler::MAX_TASKS);
+    for (int i = 0; i < count; i++) {
+        Entry& other = entries[i];
+        if (&other == entry || other.task.load(std::memory_order_acquire) == nullptr) continue;
+        if (other.active.load(std::memory_order_relaxed) && other.stats.priority < stats.priority)
+            other.preemptions.fetch_add(1, std::memory_order_relaxed);
+    }
+    record(*entry, true, now, latency);
+    entry->published.write(stats);
+}
+} // namespace
+
+void lemlib::profiler::delay(std::uint32_t milliseconds) {
+    Entry* entry = self();
+    sleep(entry);
+    const std::uint64_t requested = pros::micros() + milliseconds * 1000ull;
+    pros::delay(milliseconds);
+    wake(entry, requested);
+}
+
+void lemlib::profiler::delayUntil(std::uint32_t* previous, std::uint32_t period) {
+    Entry* entry = self();
+    sleep(entry);
+    const std::uint64_t requested = (*previous + period) * 1000ull;
+    pros::Task::delay_until(previous, period);
+    wake(entry, requested);
+}
+
+void lemlib::profiler::stop() {
+    Entry* entry = find();
+    if (entry == nullptr) return;
+    sleep(entry);
+    entry->stopped = true;
+}
+
+int lemlib::profiler::getTaskCount() {
+    const int count = std::min<int>(taskCount.load(std::memory_order_acquire), MAX_TASKS);
+    int ready = 0;
+    while (ready < count && entries[ready].task.load(std::memory_order_acquire) != nullptr) ready++;
+    return ready;
+}
+
+lemlib::profiler::TaskStats lemlib::profiler::getStats(int index) {
+    const Entry& entry = entries[index];
+    TaskStats stats = entry.published.read();
+    // the name and priority are set before the first wake up is published
+    stats.name = entry.stats.name;
+    stats.priority = entry.stats.priority;
+    stats.preemptions = entry.preemptions.load(std::memory_order_relaxed);
+    return stats;
+}
+
+int lemlib::profiler::getEvents(Event* out, int count) {
+    const std::uint32_t total = eventCount.load(std::memory_order_relaxed);
+    const int n = std::min<std::uint32_t>({total, EVENT_COUNT, static_cast<std::uint32_t>(count)});
+    int copied = 0;
+    for (int i = 0; i < n; i++) {
+        const std::uint32_t number = total - n + i;
+        const EventSlot& slot = events[number % EVENT_COUNT];
+        // skip an event that's still being written, or was overwritten by a newer one while it was copied
+        const std::uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * (number + 1)) continue;
+        std::array<std::uint32_t, 3> words;
+        for (int j = 0; j < 3; j++) words[j] = slot.words[j].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence) continue;
+        out[copied++] = {words[0], static_cast<std::uint8_t>(words[1] >> 1), (words[1] & 1) != 0, words[2]};
+    }
+    return copied;
+}
+
+void lemlib::profiler::report(bool withEvents) {
+    // one line per task, as comma separated values, so it can be read by a tool as well as by eye
+    for (int i = 0; i < getTaskCount(); i++) {
+        const TaskStats stats = getStats(i);
+        if (stats.wakes == 0) continue;
+        telemetrySink()->info("task,{},{},{},{},{},{},{},{},{}", stats.name, stats.priority, stats.wakes,
+                              stats.runTime / stats.wakes, stats.maxRunTime, stats.latency / stats.wakes,
+                              stats.maxLatency, stats.maxPeriod, stats.preemptions);
+    }
+    if (!withEvents) return;
+    std::array<Event, EVENT_COUNT> recent;
+    const int count = getEvents(recent.data(), EVENT_COUNT);
+    for (int i = 0; i < count; i++) {
+        const Event& event = recent[i];
+        telemetrySink()->info("event,{},{},{},{}", event.time, event.task, event.wake ? "wake" : "sleep", event.value);
+    }
+}
@@ -11,6 +11,12 @@
 #include "pros/rotation.hpp"
 #include "pros/rtos.h"
 #include "pros/rtos.hpp"
+#include "intake.hpp"
+#include "poseTelemetry.hpp"
+#include "sensorPoller.hpp"
+#include "stallDetector.hpp"
+#include "subsystem.hpp"
+#include "timerWheel.hpp"
 #include <chrono>
 #include <cstdio>
 #include <iostream>
@@ -38,6 +44,22 @@ lemlib::TrackingWheel vertical(&verticalEnc, lemlib::Omniwheel::NEW_275, -1);
 pros::adi::DigitalOut matchloader('G',LOW);
 pros::Motor Intake(10 ,pros::MotorGearset::blue);
 pros::Optical ColorSort(9);
+// rings the color sort watches for, closer than 100. Red hues wrap around 0
+ColorTrigger redRing(&ColorSort, {300, 20, 100});
+ColorTrigger blueRing(&ColorSort, {150, 220, 100});
+// reads the color sensor every 10ms, as often as it measures
+SensorPoller sensorPoller(10);
+// runs the intake at set times after a ring is seen, so sorting never waits
+TimerWheel actionWheel;
+// the only thing that moves the intake motor
+IntakeController intake(&Intake);
+// jammed when turning slower than 20 rpm while drawing over 1.5 A for 250ms. Checked again 600ms later, once the
+// intake has backed out
+StallMonitor intakeStall(&Intake, {20, 1500, 0, 250, 600});
+// checks every mechanism that can jam for stalls, every 20ms
+StallDetector stallDetector(20);
+// runs the sensor poller, the stall detector, the intake and the pose telemetry, on one task
+SubsystemScheduler scheduler;
 
 // drivetrain settings
 lemlib::Drivetrain drivetrain(&leftMotors, // left motor group
@@ -75,7 +97,7 @@ lemlib::ControllerSettings angularController(1.8, // proportional gain (kP)
 // sensors for odometry
 lemlib::OdomSensors sensors(&vertical, // vertical tracking wheel
                             nullptr, // vertical tracking wheel 2, set to nullptr as we don't have a second one
-                            &horizontal, // horizontal tracking wheel
+                            nullptr, // horizontal tracking wheel 1, set to nullptr as we don't have one
                             nullptr, // horizontal tracking wheel 2, set to nullptr as we don't have a second one
                             &imu // inertial sensor
 );
@@ -92,23 +114,47 @@ lemlib::ExpoDriveCurve steerCurve(3, // joystick deadband out of 127
                                   1.019 // expo curve gain
 );
 
+// motion profiling for moveToPoint and moveToPose. Off for now: the routines below are tuned around timeouts, and
+// profiles didn't finish them any sooner in the sim. Set the maximum acceleration to turn it on
+lemlib::ProfileSettings profileSettings(0, // maximum acceleration, in inches per second squared
+                                        2000, // maximum jerk, in inches per second cubed
+                                        0, // velocity gain (kV), 0 works it out from the drivetrain rpm
+                                        0.2, // acceleration gain (kA)
+                                        0 // static gain (kS)
+);
+
 // create the chassis
 lemlib::Chassis chassis(drivetrain, linearController, angularController, sensors, &throttleCurve, &steerCurve);
+// logs the pose at 100 Hz, on the subsystem scheduler
+PoseTelemetry poseTelemetry(&chassis);
 //variables
 bool backVal = false;
 float derivative;
-bool slapVal = false;
 int state=0;
-int IntakeVel=0;
-bool auton=false;
 int error;
 
 
 //Color Sort
 bool colorsortRED=true;
 bool colorsortBLUE=false;
-bool intakeRun = true;
-int intakeStuckTime=0;
+int ringsEjecting=0; // rings between the intake reversing and running forwards again, only the timer wheel changes it
+
+/**
+ * @brief Throw out the ring at the color sensor, once it's carried up to the top of the intake
+ *
+ * Rings that arrive back to back overlap, and the intake stays reversed until the last one is out
+ *
+ * @param delay how long the ring takes to get to the top, in milliseconds
+ */
+void ejectRing(std::uint32_t delay) {
+    actionWheel.schedule(delay, [] {
+        ringsEjecting++;
+        intake.request(IntakeController::SORT, 127);
+    });
+    actionWheel.schedule(delay + 280, [] {
+        if (--ringsEjecting == 0) intake.release(IntakeController::SORT);
+    });
+}
 /**
  * Runs initialization code. This occurs as soon as the program is started.
  *
@@ -118,65 +164,47 @@ int intakeStuckTime=0;
 void initialize() {
     pros::lcd::initialize(); // initialize brain screen
     chassis.calibrate(); // calibrate sensors
-
-    pros::Task ColorSorter([&]() {
-        while(true){
-            if (colorsortRED==true){
-                if ((ColorSort.get_hue()>300 || ColorSort.get_hue()<20) && ColorSort.get_proximity()>100){
-                    pros::c::delay(192);
-                    intakeRun=false;
-                    IntakeVel=127;
-                    Intake.move(127);
-                    pros::c::delay(280);
-                    intakeRun=true;
-                    IntakeVel=-127;
-                    Intake.move(-127);
-                }
-            }
-            if (colorsortBLUE==true) {
-                if (ColorSort.get_hue()>150 && ColorSort.get_proximity()>100){
-                    if (ColorSort.get_hue()<220){
-                        pros::c::delay(185);
-                        intakeRun=false;
-                        IntakeVel=127;
-                        Intake.move(127);
-                        pros::c::delay(280);
-                        intakeRun=true;
-                        IntakeVel=-127;
-                        Intake.move(-127);
-                    }
-                }
-            }
-        }
-        pros::delay(50);
+    chassis.setProfileSettings(profileSettings);
+    chassis.setLatency(10); // motor commands take about a motor update to take effect
+    // end motions once the robot has stopped within the large error ranges, instead of waiting out the timeouts
+    chassis.setSettleSettings(lemlib::SettleSettings(2, 3, 50), // within 2 inches, slower than 3 inches per second
+                              lemlib::SettleSettings(3, 15, 50)); // within 3 degrees, slower than 15 degrees per second
+    // drive the same on a low battery and with hot motors as on a fresh battery with cool ones
+    chassis.setMotorModel(lemlib::MotorModel(600)); // blue cartridges
+    // ease off when the wheels spin, rather than wasting the launch
+    chassis.setTractionSettings(lemlib::TractionSettings(12, // slipping when the wheels are 12 inches per second off
+                                                         30)); // then let them run 30 inches per second ahead
+
+    // color sort runs when a ring reaches the sensor, from the sensor poller
+    redRing.onArrive([] {
+        if (colorsortRED) ejectRing(192);
     });
-   
-    pros::Task intakeStuckDetect([&]() {
-        while (true){
-            Intake.move(IntakeVel);
-            if (auton==true){
-                if (Intake.get_actual_velocity()==0 && abs(IntakeVel)>60){
-                    intakeStuckTime = intakeStuckTime+50;
-                } else{
-                    intakeStuckTime=0;
-                }
-                if (intakeStuckTime>400){
-                    IntakeVel=127;
-                    Intake.move(127);
-                    pros::c::delay(500);
-                    IntakeVel=-127;                
-                    Intake.move(-127);
-                }
-            }
-
-            pros::c::delay(50);
-        }
-});
+    blueRing.onArrive([] {
+        if (colorsortBLUE) ejectRing(185);
+    });
+    sensorPoller.add(&redRing);
+    sensorPoller.add(&blueRing);
+    // back the intake out of jams, if the routine has turned that on
+    intakeStall.onStall([] { intake.clearJam(); });
+    stallDetector.add(&intakeStall);
+    scheduler.add(&sensorPoller);
+    scheduler.add(&stallDetector);
+    scheduler.add(&intake);
+    scheduler.add(&poseTelemetry);
+    scheduler.start();
+    // binary frames, so logging the pose doesn't format or allocate. Decode them with sim/tools/telemetry.cpp
+    lemlib::telemetrySink()->setMode(lemlib::TelemetrySink::Mode::BINARY);
+    actionWheel.start();
 
     // the default rate is 50. however, if you need to change the rate, you
     // can do the following.
     // lemlib::bufferedStdout().setRate(...);
     // If you use bluetooth or a wired connection, you will want to have a rate of 10ms
+    // to get much more through the same link, send it in compressed batches,
+    // and read it with sim/tools/receiver.cpp:
+    // static lemlib::Transport transport(4000); // bytes per second the link carries
+    // transport.setCompression(true);
+    // lemlib::bufferedStdout().setTransport(&transport);
 
     // for more information on how the formatting for the loggers
     // works, refer to the fmtlib docs
@@ -209,14 +237,15 @@ void competition_initialize() {}
 // get a path used for pure pursuit
 // this needs to be put outside a function
 ASSET(example_txt); // '.' replaced with "_" to make c++ happy
+ASSET(example_path); // binary copy of example.txt made by make -C sim paths, follow() reads it without parsing
 
 void blueneg(){
-    IntakeVel=0;
+    intake.set(0);
     colorsortRED=true;
     colorsortBLUE=false;
     matchloader.set_value(false);
     ColorSort.set_led_pwm(100);
-    auton=true;
+    intake.setUnjam(true);
     chassis.setPose(15.6,12.1,235.2);
     state=4;
     pros::c::delay(500);
@@ -228,8 +257,7 @@ void blueneg(){
     matchloader.set_value(true);
     chassis.turnToHeading(50,1000);
     chassis.waitUntilDone();
-    IntakeVel=-127;
-    Intake.move(IntakeVel);
+    intake.set(-127);
     chassis.setBrakeMode(pros::E_MOTOR_BRAKE_BRAKE);
     //version 1: stop at 1st ring
     chassis.moveToPose(45, 63.25, 90, 1500,{.maxSpeed=62,.minSpeed=42});
@@ -257,12 +285,12 @@ void blueneg(){
 }
 
 void redneg(){
-    IntakeVel=0;
+    intake.set(0);
     colorsortRED=false;
     colorsortBLUE=true;
     matchloader.set_value(false);
     ColorSort.set_led_pwm(100);
-    auton=true;
+    intake.setUnjam(true);
     chassis.setPose(-15.6,12.1,124.8);
     state=4;
     pros::c::delay(500);
@@ -274,8 +302,7 @@ void redneg(){
     matchloader.set_value(true);
     chassis.turnToHeading(310,1000);
     chassis.waitUntilDone();
-    IntakeVel=-127;
-    Intake.move(IntakeVel);
+    intake.set(-127);
     chassis.setBrakeMode(pros::E_MOTOR_BRAKE_BRAKE);
     //version 1: stop at 1st ring
     chassis.moveToPose(-45, 63.05, 270, 1500,{.maxSpeed=62,.minSpeed=42});
@@ -306,9 +333,9 @@ void redpos(){
     matchloader.set_value(false);
     colorsortRED=false;
     colorsortBLUE=true;
-    auton=true;
+    intake.setUnjam(true);
     matchloader.set_value(false);
-    IntakeVel=0;
+    intake.set(0);
     chassis.setPose(15.6,12.1,235.2);
     //state=4;
     //pros::c::delay(500);
@@ -319,7 +346,7 @@ void redpos(){
     pros::delay(200);
     matchloader.set_value(true);
     pros::delay(500);
-    IntakeVel=-127;
+    intake.set(-127);
     pros::c::delay(500);
     chassis.turnToPoint(47.5, 47, 1000);
     chassis.waitUntilDone();
@@ -343,8 +370,8 @@ void bluepos(){
     matchloader.set_value(false);
     colorsortRED=true;
     colorsortBLUE=false;
-    auton=true;
-    IntakeVel=0;
+    intake.setUnjam(true);
+    intake.set(0);
     matchloader.set_value(false);
     chassis.setPose(-15.6,12.1,124.8);
     state=4;
@@ -356,7 +383,7 @@ void bluepos(){
     pros::delay(200);
     matchloader.set_value(true);
     pros::delay(500);
-    IntakeVel=-127;
+    intake.set(-127);
     pros::c::delay(500);
     chassis.turnToPoint(-47.5, 47, 1000);
     chassis.waitUntilDone();
@@ -380,7 +407,7 @@ void skills(){
     //alliance + clamp goal 1
     colorsortRED=false;
     colorsortBLUE=false;
-    auton=true;
+    intake.setUnjam(true);
     chassis.setPose(-15.6,11.1,124.8);
     state=4;
     pros::delay(600);
@@ -389,29 +416,28 @@ void skills(){
     state=0;
     chassis.waitUntilDone();
     pros::delay(300);
-    .set_value(true);
     // rings on goal 1 + wall stake
     pros::delay(500);
     chassis.turnToHeading(0,500);
     chassis.waitUntilDone();
-    IntakeVel=-127;
+    intake.set(-127);
     chassis.moveToPose(-24, 48, 0, 800, {.maxSpeed=82,.minSpeed=52});
     chassis.waitUntilDone();
     chassis.turnToHeading(290, 1000);
-    IntakeVel=-127;
+    intake.set(-127);
     chassis.waitUntilDone();
     chassis.moveToPose(-60,71.5,280,1500, {.maxSpeed=82,.minSpeed=54});
     chassis.waitUntilDone();
-    IntakeVel=-95;
+    intake.set(-95);
     state=1;
     pros::delay(500);
     chassis.moveToPose(-65.7, 71.8, 290, 800, {.maxSpeed=52,.minSpeed=32});
     pros::delay(700);
-    IntakeVel=0;
+    intake.set(0);
     pros::delay(300);
-    IntakeVel=-127;
+    intake.set(-127);
     pros::delay(200);
-    IntakeVel=0;
+    intake.set(0);
     pros::delay(100);
     chassis.waitUntilDone();
     chassis.turnToPoint(-77, 74.6, 400);
@@ -423,7 +449,7 @@ void skills(){
     chassis.moveToPose(-48, 70, 270, 600,{.forwards=false,.maxSpeed=82,.minSpeed=52});
     pros::c::delay(300);
     state=0;
-    IntakeVel=-127;
+    intake.set(-127);
     chassis.waitUntilDone();
     pros::delay(200);
     chassis.turnToHeading(180, 500);
@@ -443,7 +469,7 @@ void skills(){
     chassis.waitUntilDone();
     chassis.moveToPose(-66, 6, 20, 900,{.forwards=false,.minSpeed=56});
     chassis.waitUntilDone();
-    IntakeVel=127;
+    intake.set(127);
     pros::delay(200);
     matchloader.set_value(false);
     chassis.moveToPoint(-48, 24, 1000,{.maxSpeed=52});
@@ -459,24 +485,24 @@ void skills(){
     pros::delay(500);
     chassis.turnToHeading(0,800);
     chassis.waitUntilDone();
-    IntakeVel=-127;
+    intake.set(-127);
     chassis.moveToPose(24, 48, 0, 900, {.maxSpeed=82,.minSpeed=52});
     chassis.waitUntilDone();
     chassis.turnToHeading(80, 900);
     chassis.waitUntilDone();
-    IntakeVel=-127;
+    intake.set(-127);
     chassis.moveToPose(60,71.5,80,700, {.maxSpeed=82,.minSpeed=54});
     chassis.waitUntilDone();
-    IntakeVel=-95;
+    intake.set(-95);
     state=1; //stops around here, intake and lady brown keep running but does not drive
     pros::delay(500);
     chassis.moveToPose(65.7, 71.8, 70, 1500, {.maxSpeed=62,.minSpeed=32});
     pros::delay(700);
-    IntakeVel=0;
+    intake.set(0);
     pros::delay(300);
-    IntakeVel=-127;
+    intake.set(-127);
     pros::delay(200);
-    IntakeVel=0;    
+    intake.set(0);    
     pros::delay(100);
     chassis.turnToPoint(77, 74.6, 600);
     chassis.waitUntilDone();
@@ -487,7 +513,7 @@ void skills(){
     chassis.moveToPose(48, 70, 90, 800,{.forwards=false,.maxSpeed=82,.minSpeed=52});
     pros::c::delay(900);
     state=0;
-    IntakeVel=-127;
+    intake.set(-127);
     chassis.waitUntilDone();
     pros::delay(200);
     chassis.turnToHeading(180, 1000);
@@ -506,7 +532,7 @@ void skills(){
     chassis.waitUntilDone();
     chassis.moveToPose(66, 6, 340, 800,{.forwards=false,.minSpeed=56});
     chassis.waitUntilDone();
-    IntakeVel=127;
+    intake.set(127);
     pros::delay(200);
     matchloader.set_value(false);
     chassis.moveToPoint(48, 24, 800,{.maxSpeed=52});
@@ -515,21 +541,21 @@ void skills(){
     chassis.waitUntilDone();
     chassis.moveToPose(48, 72, 330, 1200,{.maxSpeed=82,.minSpeed=70});
     chassis.waitUntilDone();
-    IntakeVel=-92;
+    intake.set(-92);
     chassis.moveToPose(24, 96, 315, 1000,{.maxSpeed=82,.minSpeed=60});
     chassis.waitUntilDone();
     pros::delay(200);
-    IntakeVel=0;
+    intake.set(0);
     chassis.turnToHeading(120, 500);
     chassis.waitUntilDone();
     chassis.moveToPose(0, 120.1, 120, 1000,{.forwards=false,.maxSpeed=72,.minSpeed=42});
     chassis.waitUntilDone();
     pros::delay(300);
     matchloader.set_value(true);
-    IntakeVel=30;
+    intake.set(30);
     pros::delay(100);
     //rings on goal 3
-    IntakeVel=-127;
+    intake.set(-127);
     pros::delay(500);
     chassis.moveToPose(24, 96, 135, 1000,{.maxSpeed=92,.minSpeed=52});
     chassis.waitUntilDone();
@@ -541,7 +567,7 @@ void skills(){
     chassis.waitUntilDone();
     matchloader.set_value(true);
     pros::c::delay(200);
-    IntakeVel=-127;
+    intake.set(-127);
     chassis.moveToPose(-48, 96, 270, 1000,{.maxSpeed=92,.minSpeed=52});
     chassis.waitUntilDone();
     pros::delay(250);
@@ -551,26 +577,26 @@ void skills(){
     chassis.moveToPoint(-60, 115, 900,{.maxSpeed=52});
     chassis.waitUntilDone();
     pros::delay(800);
-    IntakeVel=0;
+    intake.set(0);
     chassis.moveToPose(-48, 132, 90, 700,{.maxSpeed=62,.minSpeed=42});
     chassis.waitUntilDone();
     chassis.turnToPoint(-24, 120, 500);
     chassis.waitUntilDone();
     chassis.moveToPoint(-60, 132, 800,{.forwards=false,.maxSpeed=52});
     chassis.waitUntilDone();
-    IntakeVel=127;
+    intake.set(127);
     pros::delay(100);
     matchloader.set_value(false);
     pros::delay(100);
     chassis.moveToPose(-48, 130, 115, 700,{.maxSpeed=84,.minSpeed=42});
     //goal 4
-    chassis.moveToPose(-24, 118, 90, 800,{.maxSpeed=127,.minSpeed=74,.earlyExitRange=4});
+    chassis.queuePose(-24, 118, 90, 800,{.maxSpeed=127,.minSpeed=74,.earlyExitRange=4});
+    chassis.queuePose(24, 133, 60, 1000,{.maxSpeed=127,.minSpeed=74});
+    chassis.queuePoint(60, 135, 1000,{.maxSpeed=120,.minSpeed=64});
+    chassis.runQueue();
     pros::delay(300);
-    IntakeVel=-127;
-    chassis.waitUntilDone();
-    chassis.moveToPose(24, 133, 60, 1000,{.maxSpeed=127,.minSpeed=74});
+    intake.set(-127);
     chassis.waitUntilDone();
-    chassis.moveToPoint(60, 135, 1000,{.maxSpeed=120,.minSpeed=64});
 }
 /**
  * Runs during auto
@@ -586,10 +612,10 @@ void autonomous() {   //alliance + clamp goal 1
  */
 
 void opcontrol() {
+    intake.setUnjam(true);
     // controller
     // loop to continuously update motors;
     while (true) {
-        auton=true;
         // get joystick positions
         colorsortRED=false;
         colorsortBLUE=false;
@@ -599,30 +625,22 @@ void opcontrol() {
         if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_L1)){
             backVal = !backVal;
         }
-        if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_L2)){
-            slapVal= !slapVal;
+        if (controller.get_digital(pros::E_CONTROLLER_DIGITAL_R1)){
+            intake.set(127);
         }
-        if (intakeRun==true){
-            if (controller.get_digital(pros::E_CONTROLLER_DIGITAL_R1)){
-                IntakeVel=127;
-            }
-            else if (controller.get_digital(pros::E_CONTROLLER_DIGITAL_R2)){
-                IntakeVel=-127;
-            } else {
-                Intake.brake();
-                IntakeVel=0;
-            }
+        else if (controller.get_digital(pros::E_CONTROLLER_DIGITAL_R2)){
+            intake.set(-127);
+        } else {
+            intake.set(0);
         }
  
 
         // move the chassis with curvature drive
         chassis.arcade(leftY, rightX);
         matchloader.set_value(backVal);
-        Intake.move(IntakeVel);
 
         
         // delay to save resources
-        matchloaderset_value(slapVal);;
-        pros::delay(10);
+        lemlib::profiler::delay(10);
     }
 }
@@ -0,0 +1,14 @@
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "poseTelemetry.hpp"
+
+PoseTelemetry::PoseTelemetry(lemlib::Chassis* chassis, std::uint32_t period)
+    : Subsystem("Pose Telemetry", period),
+      chassis(chassis) {}
+
+void PoseTelemetry::periodic() {
+    const lemlib::Pose pose = chassis->getPose();
+    const lemlib::Pose speed = lemlib::getSpeed();
+    lemlib::telemetrySink()->send(lemlib::telemetry::POSE, pose.x, pose.y, pose.theta);
+    lemlib::telemetrySink()->send(lemlib::telemetry::SPEED, speed.x, speed.y, speed.theta);
+}
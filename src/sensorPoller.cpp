@@ -0,0 +1,91 @@
+#include <cmath>
+#include "pros/error.h"
+#include "lemlib/devices.hpp"
+#include "sensorPoller.hpp"
+
+ColorTrigger::ColorTrigger(pros::Optical* sensor, ColorBand band, float hueHysteresis, int proximityHysteresis)
+    : sensor(sensor),
+      band(band),
+      hueHysteresis(hueHysteresis),
+      proximityHysteresis(proximityHysteresis) {}
+
+void ColorTrigger::subscribe(pros::Task task) {
+    if (subscriberCount == MAX_SUBSCRIBERS) return;
+    subscribers[subscriberCount++] = static_cast<pros::task_t>(task);
+}
+
+void ColorTrigger::onArrive(std::function<void()> callback) { this->callback = std::move(callback); }
+
+std::uint32_t ColorTrigger::getMask() const { return mask; }
+
+bool ColorTrigger::isActive() const { return active; }
+
+int ColorTrigger::getCount() const { return count; }
+
+bool ColorTrigger::inBand(double hue, float margin) const {
+    const float min = std::fmod(band.minHue - margin + 360, 360);
+    const float max = std::fmod(band.maxHue + margin, 360);
+    if (min <= max) return hue >= min && hue <= max;
+    // the band wraps around through 0
+    return hue >= min || hue <= max;
+}
+
+void ColorTrigger::update(double hue, std::int32_t proximity) {
+    if (!active) {
+        if (!inBand(hue, 0) || proximity <= band.proximity) return;
+        active = true;
+        count++;
+        for (int i = 0; i < subscriberCount; i++)
+            pros::c::task_notify_ext(subscribers[i], mask, pros::E_NOTIFY_ACTION_BITS, nullptr);
+        if (callback) callback();
+    } else if (!inBand(hue, hueHysteresis) || proximity < band.proximity - proximityHysteresis) {
+        active = false;
+    }
+}
+
+SensorPoller::SensorPoller(double integrationTime)
+    : Subsystem("Sensor Poller", std::ceil(integrationTime), 1),
+      integrationTime(integrationTime) {}
+
+bool SensorPoller::add(ColorTrigger* trigger) {
+    if (triggerCount == MAX_TRIGGERS) return false;
+    trigger->mask = 1u << triggerCount;
+    trigger->deviceIndex = lemlib::devices().add(trigger->sensor, getPeriod());
+    triggers[triggerCount++] = trigger;
+    return true;
+}
+
+void SensorPoller::initialize() {
+    for (int i = 0; i < triggerCount; i++) triggers[i]->sensor->set_integration_time(integrationTime);
+}
+
+void SensorPoller::periodic() {
+    const bool ticking = lemlib::devices().getVersion() != 0;
+    const lemlib::DeviceSnapshot snapshot = ticking ? lemlib::devices().get() : lemlib::DeviceSnapshot {};
+    std::array<std::uint8_t, MAX_TRIGGERS> ports {};
+    std::array<double, MAX_TRIGGERS> hues {};
+    std::array<std::int32_t, MAX_TRIGGERS> proximities {};
+    int sensorCount = 0;
+    for (int i = 0; i < triggerCount; i++) {
+        ColorTrigger* trigger = triggers[i];
+        if (ticking && trigger->deviceIndex != -1) {
+            const float hue = snapshot.hues[trigger->deviceIndex];
+            const std::int32_t proximity = snapshot.proximities[trigger->deviceIndex];
+            if (hue != PROS_ERR_F && proximity != PROS_ERR) trigger->update(hue, proximity);
+            continue;
+        }
+        const std::uint8_t port = trigger->sensor->get_port();
+        // read each sensor once, however many triggers watch it
+        int sensor = 0;
+        while (sensor < sensorCount && ports[sensor] != port) sensor++;
+        if (sensor == sensorCount) {
+            ports[sensor] = port;
+            hues[sensor] = trigger->sensor->get_hue();
+            proximities[sensor] = trigger->sensor->get_proximity();
+            sensorCount++;
+        }
+        // leave the trigger as it is if the sensor is unplugged
+        if (hues[sensor] == PROS_ERR_F || proximities[sensor] == PROS_ERR) continue;
+        trigger->update(hues[sensor], proximities[sensor]);
+    }
+}
@@ -0,0 +1,86 @@
+#include <cmath>
+#include "pros/error.h"
+#include "pros/rtos.hpp"
+#include "lemlib/devices.hpp"
+#include "stallDetector.hpp"
+
+StallMonitor::StallMonitor(pros::AbstractMotor* motors, StallSettings settings)
+    : motors(motors),
+      settings(settings) {}
+
+void StallMonitor::onStall(std::function<void()> callback) { this->callback = std::move(callback); }
+
+void StallMonitor::setEnabled(bool enabled) { this->enabled = enabled; }
+
+bool StallMonitor::isStalled() const { return stalled; }
+
+int StallMonitor::getCount() const { return count; }
+
+void StallMonitor::update(float velocity, float current, float torque, std::uint32_t now, std::uint32_t elapsed) {
+    const bool pushing = (settings.current > 0 && current > settings.current) ||
+                         (settings.torque > 0 && torque > settings.torque);
+    if (!enabled || std::fabs(velocity) >= settings.velocity || !pushing) {
+        stalled = false;
+        stalledTime = 0;
+        return;
+    }
+    stalled = true;
+    // give the last recovery time to work before detecting another stall
+    if (static_cast<std::int32_t>(now - cooldownEnd) < 0) return;
+    stalledTime += elapsed;
+    if (stalledTime < settings.window) return;
+    stalledTime = 0;
+    cooldownEnd = now + settings.cooldown;
+    count++;
+    if (callback) callback();
+}
+
+StallDetector::StallDetector(std::uint32_t period)
+    : Subsystem("Stall Detector", period) {}
+
+bool StallDetector::add(StallMonitor* monitor) {
+    if (monitorCount == MAX_MONITORS) return false;
+    monitor->motorCount = monitor->motors->size();
+    // only read what the monitor checks
+    int data = lemlib::DeviceService::VELOCITY;
+    if (monitor->settings.current > 0) data |= lemlib::DeviceService::CURRENT;
+    if (monitor->settings.torque > 0) data |= lemlib::DeviceService::TORQUE;
+    monitor->deviceIndex = lemlib::devices().add(monitor->motors, data, getPeriod());
+    monitors[monitorCount++] = monitor;
+    return true;
+}
+
+void StallDetector::periodic() {
+    const std::uint32_t now = pros::millis();
+    const bool ticking = lemlib::devices().getVersion() != 0;
+    const lemlib::DeviceSnapshot snapshot = ticking ? lemlib::devices().get() : lemlib::DeviceSnapshot {};
+    for (int i = 0; i < monitorCount; i++) {
+        StallMonitor* monitor = monitors[i];
+        // average the motors that are plugged in
+        float velocity = 0, current = 0, torque = 0;
+        int count = 0;
+        const auto add = [&](double motorVelocity, std::int32_t motorCurrent, double motorTorque) {
+            if (motorVelocity == PROS_ERR_F || motorCurrent == PROS_ERR || motorTorque == PROS_ERR_F) return;
+            velocity += motorVelocity;
+            current += motorCurrent;
+            torque += motorTorque;
+            count++;
+        };
+        if (ticking && monitor->deviceIndex != -1) {
+            for (int motor = monitor->deviceIndex; motor < monitor->deviceIndex + monitor->motorCount; motor++)
+                add(snapshot.motorVelocities[motor], snapshot.motorCurrents[motor], snapshot.motorTorques[motor]);
+        } else {
+            // odometry isn't running yet, so read the motors one at a time, which doesn't allocate like the _all
+            // getters do
+            const pros::AbstractMotor& motors = *monitor->motors;
+            for (int motor = 0; motor < monitor->motorCount; motor++) {
+                add(motors.get_actual_velocity(motor),
+                    monitor->settings.current > 0 ? motors.get_current_draw(motor) : 0,
+                    monitor->settings.torque > 0 ? motors.get_torque(motor) : 0);
+            }
+        }
+        // leave the monitor as it is if every motor is unplugged
+        if (count == 0) continue;
+        monitor->update(velocity / count, current / count, torque / count, now, getPeriod());
+    }
+}
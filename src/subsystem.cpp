@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <bit>
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/profiler.hpp"
+#include "subsystem.hpp"
+
+Subsystem::Subsystem(const char* name, std::uint32_t period, int priority)
+    : name(name),
+      period(period),
+      priority(priority) {}
+
+const char* Subsystem::getName() const { return name; }
+
+std::uint32_t Subsystem::getPeriod() const { return period; }
+
+SubsystemStats Subsystem::getStats() const { return publishedStats.read(); }
+
+void Subsystem::setPeriod(std::uint32_t period) { this->period = std::max<std::uint32_t>(period, 1); }
+
+bool SubsystemScheduler::add(Subsystem* subsystem) {
+    if (task != nullptr || count == MAX_SUBSYSTEMS) return false;
+    // keep them in order of priority, so the loop runs them in order when they're due together
+    int i = count++;
+    while (i > 0 && subsystems[i - 1]->priority < subsystem->priority) {
+        subsystems[i] = subsystems[i - 1];
+        i--;
+    }
+    subsystems[i] = subsystem;
+    return true;
+}
+
+void SubsystemScheduler::start() {
+    if (task != nullptr) return;
+    task = new pros::Task {[this] { loop(); }, TASK_PRIORITY_DEFAULT + 2, TASK_STACK_DEPTH_DEFAULT, "Subsystems"};
+}
+
+int SubsystemScheduler::getCount() const { return count; }
+
+const Subsystem* SubsystemScheduler::getSubsystem(int index) const { return subsystems[index]; }
+
+void SubsystemScheduler::logStats() const {
+    for (int i = 0; i < count; i++) {
+        const SubsystemStats stats = subsystems[i]->getStats();
+        if (stats.runs == 0) continue;
+        lemlib::infoSink()->info("{}: {} runs every {} ms, took {}/{} us, started {}/{} us late (mean/max), {} overruns",
+                                 subsystems[i]->getName(), stats.runs, subsystems[i]->getPeriod(),
+                                 stats.runTime / stats.runs, stats.maxRunTime, stats.jitter / stats.runs,
+                                 stats.maxJitter, stats.overruns);
+    }
+}
+
+void SubsystemScheduler::loop() {
+    // due times are on millisecond ticks, since that's when the task can wake up
+    const std::uint64_t start = pros::millis() * 1000ull;
+    for (int i = 0; i < count; i++) {
+        subsystems[i]->initialize();
+        subsystems[i]->due = start;
+    }
+    while (true) {
+        for (int i = 0; i < count; i++) {
+            Subsystem& subsystem = *subsystems[i];
+            const std::uint64_t begin = pros::micros();
+            if (begin < subsystem.due) continue;
+            subsystem.periodic();
+            const std::uint64_t end = pros::micros();
+
+            SubsystemStats& stats = subsystem.stats;
+            const std::uint32_t runTime = end - begin;
+            const std::uint32_t late = begin - subsystem.due;
+            stats.runs++;
+            stats.runTime += runTime;
+            stats.maxRunTime = std::max(stats.maxRunTime, runTime);
+            stats.jitter += late;
+            stats.maxJitter = std::max(stats.maxJitter, late);
+            const std::uint64_t period = subsystem.period * 1000ull;
+            subsystem.due += period;
+            // skip runs that were missed instead of running them back to back to catch up
+            if (subsystem.due <= end) {
+                stats.overruns++;
+                subsystem.due += ((end - subsystem.due) / period + 1) * period;
+            }
+            subsystem.publishedStats.write(stats);
+        }
+        // sleep until the next run is due
+        std::uint64_t next = UINT64_MAX;
+        for (int i = 0; i < count; i++) next = std::min(next, subsystems[i]->due);
+        const std::uint64_t now = pros::micros();
+        if (count == 0) lemlib::profiler::delay(100);
+        else if (next > now) lemlib::profiler::delay((next - now + 999) / 1000);
+    }
+}
+
+void CommandArbiter::request(int level, float value) {
+    values[level].store(value, std::memory_order_relaxed);
+    active.fetch_or(1u << level, std::memory_order_release);
+}
+
+void CommandArbiter::release(int level) { active.fetch_and(~(1u << level), std::memory_order_release); }
+
+bool CommandArbiter::isActive(int level) const { return active.load(std::memory_order_acquire) & (1u << level); }
+
+float CommandArbiter::resolve(float fallback) const {
+    const std::uint32_t mask = active.load(std::memory_order_acquire);
+    if (mask == 0) return fallback;
+    return values[31 - std::countl_zero(mask)].load(std::memory_order_relaxed);
+}
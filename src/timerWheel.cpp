@@ -0,0 +1,107 @@
+#include <algorithm>
+#include "timerWheel.hpp"
+
+TimerWheel::TimerWheel() {
+    slots.fill(-1);
+    for (int i = 0; i < MAX_ACTIONS; i++) entries[i].next = i + 1 < MAX_ACTIONS ? i + 1 : -1;
+}
+
+bool TimerWheel::schedule(std::uint32_t delay, std::function<void()> action) {
+    return scheduleAt(pros::millis() + delay, std::move(action));
+}
+
+bool TimerWheel::scheduleAt(std::uint32_t time, std::function<void()> action) {
+    mutex.take();
+    if (freeList == -1) {
+        mutex.give();
+        return false;
+    }
+    const int index = freeList;
+    Entry& entry = entries[index];
+    freeList = entry.next;
+    entry.due = time;
+    entry.action = std::move(action);
+    entry.next = -1;
+    // add it to the end of its slot, so actions due at the same time run in the order they were scheduled. An action
+    // that's already due goes in the next slot the task looks at
+    const std::uint32_t slot = static_cast<std::int32_t>(time - tick) < 0 ? tick : time;
+    int* link = &slots[slot % SLOTS];
+    while (*link != -1) link = &entries[*link].next;
+    *link = index;
+    pending++;
+    mutex.give();
+    // wake the task up if it's waiting for something to do
+    if (task != nullptr) task->notify();
+    return true;
+}
+
+int TimerWheel::getPending() {
+    mutex.take();
+    const int count = pending;
+    mutex.give();
+    return count;
+}
+
+void TimerWheel::start() {
+    if (task != nullptr) return;
+    // above the tasks that schedule actions, so the actions happen when they're due
+    task = new pros::Task {[this] { loop(); }, TASK_PRIORITY_DEFAULT + 1, TASK_STACK_DEPTH_DEFAULT, "Timer Wheel"};
+}
+
+void TimerWheel::loop() {
+    // look at the whole wheel on the first pass, for actions scheduled before the task started
+    mutex.take();
+    tick = pros::millis() - SLOTS + 1;
+    mutex.give();
+    while (true) {
+        const std::uint32_t now = pros::millis();
+
+        // take every action that's due out of the slots that came round since the last pass. After sleeping, that
+        // can be the whole wheel
+        std::array<int, MAX_ACTIONS> due;
+        int dueCount = 0;
+        mutex.take();
+        const std::uint32_t span = std::min<std::uint32_t>(now - tick + 1, SLOTS);
+        for (std::uint32_t i = 0; i < span; i++) {
+            int* link = &slots[(tick + i) % SLOTS];
+            while (*link != -1) {
+                Entry& entry = entries[*link];
+                if (static_cast<std::int32_t>(entry.due - now) <= 0) {
+                    due[dueCount++] = *link;
+                    *link = entry.next;
+                } else {
+                    link = &entry.next;
+                }
+            }
+        }
+        tick = now + 1;
+        mutex.give();
+
+        // run them without holding the mutex, so they can schedule more actions
+        for (int i = 0; i < dueCount; i++) {
+            Entry& entry = entries[due[i]];
+            entry.action();
+            entry.action = nullptr;
+            mutex.take();
+            entry.next = freeList;
+            freeList = due[i];
+            pending--;
+            mutex.give();
+        }
+
+        // sleep until the next action is due, or forever if there isn't one. scheduleAt wakes the task up early for an
+        // action due sooner. At least a millisecond, since only slots before the current one have been looked at
+        std::uint32_t wait = TIMEOUT_MAX;
+        mutex.take();
+        if (pending > 0) {
+            const std::uint32_t time = pros::millis();
+            std::int32_t earliest = INT32_MAX;
+            for (const Entry& entry : entries) {
+                if (entry.action != nullptr) earliest = std::min(earliest, static_cast<std::int32_t>(entry.due - time));
+            }
+            wait = std::max(earliest, 1);
+        }
+        mutex.give();
+        pros::Task::notify_take(true, wait);
+    }
+}